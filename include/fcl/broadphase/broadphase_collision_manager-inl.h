@@ -96,8 +96,7 @@ template <typename S>
 bool BroadPhaseCollisionManager<S>::inTestedSet(
     CollisionObject<S>* a, CollisionObject<S>* b) const
 {
-  if(a < b) return tested_set.find(std::make_pair(a, b)) != tested_set.end();
-  else return tested_set.find(std::make_pair(b, a)) != tested_set.end();
+  return tested_set.contains(a, b);
 }
 
 //==============================================================================
@@ -105,8 +104,7 @@ template <typename S>
 void BroadPhaseCollisionManager<S>::insertTestedSet(
     CollisionObject<S>* a, CollisionObject<S>* b) const
 {
-  if(a < b) tested_set.insert(std::make_pair(a, b));
-  else tested_set.insert(std::make_pair(b, a));
+  tested_set.insert(a, b);
 }
 
 } // namespace fcl
@@ -38,10 +38,10 @@
 #ifndef FCL_BROADPHASE_BROADPHASECOLLISIONMANAGER_H
 #define FCL_BROADPHASE_BROADPHASECOLLISIONMANAGER_H
 
-#include <set>
 #include <vector>
 
 #include "fcl/narrowphase/collision_object.h"
+#include "fcl/broadphase/detail/pair_hash_set.h"
 
 namespace fcl
 {
@@ -124,7 +124,7 @@ public:
 protected:
 
   /// @brief tools help to avoid repeating collision or distance callback for the pairs of objects tested before. It can be useful for some of the broadphase algorithms.
-  mutable std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*> > tested_set;
+  mutable detail::PairHashSet<CollisionObject<S>> tested_set;
   mutable bool enable_tested_set_;
 
   bool inTestedSet(CollisionObject<S>* a, CollisionObject<S>* b) const;
@@ -0,0 +1,462 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_INL_H
+#define FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_INL_H
+
+#include "fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace fcl {
+
+//==============================================================================
+extern template
+class DynamicAABBTreeContinuousCollisionManager<double>;
+
+namespace detail {
+
+namespace continuous_dynamic_AABB_tree {
+
+//==============================================================================
+template <typename S>
+bool collisionRecurse(
+    typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root1,
+    typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root2,
+    void* cdata,
+    ContinuousCollisionCallBack<S> callback)
+{
+  if(root1->isLeaf() && root2->isLeaf())
+  {
+    if(!root1->bv.overlap(root2->bv)) return false;
+    return callback(static_cast<ContinuousCollisionObject<S>*>(root1->data), static_cast<ContinuousCollisionObject<S>*>(root2->data), cdata);
+  }
+
+  if(!root1->bv.overlap(root2->bv)) return false;
+
+  if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
+  {
+    if(collisionRecurse(root1->children[0], root2, cdata, callback))
+      return true;
+    if(collisionRecurse(root1->children[1], root2, cdata, callback))
+      return true;
+  }
+  else
+  {
+    if(collisionRecurse(root1, root2->children[0], cdata, callback))
+      return true;
+    if(collisionRecurse(root1, root2->children[1], cdata, callback))
+      return true;
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool collisionRecurse(typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root, ContinuousCollisionObject<S>* query, void* cdata, ContinuousCollisionCallBack<S> callback)
+{
+  if(root->isLeaf())
+  {
+    if(!root->bv.overlap(query->getAABB())) return false;
+    return callback(static_cast<ContinuousCollisionObject<S>*>(root->data), query, cdata);
+  }
+
+  if(!root->bv.overlap(query->getAABB())) return false;
+
+  int select_res = select(query->getAABB(), *(root->children[0]), *(root->children[1]));
+
+  if(collisionRecurse(root->children[select_res], query, cdata, callback))
+    return true;
+
+  if(collisionRecurse(root->children[1-select_res], query, cdata, callback))
+    return true;
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool selfCollisionRecurse(typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root, void* cdata, ContinuousCollisionCallBack<S> callback)
+{
+  if(root->isLeaf()) return false;
+
+  if(selfCollisionRecurse(root->children[0], cdata, callback))
+    return true;
+
+  if(selfCollisionRecurse(root->children[1], cdata, callback))
+    return true;
+
+  if(collisionRecurse(root->children[0], root->children[1], cdata, callback))
+    return true;
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool distanceRecurse(
+    typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root1,
+    typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root2,
+    void* cdata,
+    ContinuousDistanceCallBack<S> callback,
+    S& min_dist)
+{
+  if(root1->isLeaf() && root2->isLeaf())
+  {
+    ContinuousCollisionObject<S>* root1_obj = static_cast<ContinuousCollisionObject<S>*>(root1->data);
+    ContinuousCollisionObject<S>* root2_obj = static_cast<ContinuousCollisionObject<S>*>(root2->data);
+    return callback(root1_obj, root2_obj, cdata, min_dist);
+  }
+
+  const bool descend_first = root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size()));
+  using DynamicAABBNode = typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode;
+  DynamicAABBNode* parent = descend_first ? root1 : root2;
+  DynamicAABBNode* other = descend_first ? root2 : root1;
+
+  S d[2];
+  d[0] = other->bv.distance(parent->children[0]->bv);
+  d[1] = other->bv.distance(parent->children[1]->bv);
+
+  // Visit the closer child first, as it is more likely to lower min_dist
+  const int first = (d[1] < d[0]) ? 1 : 0;
+  for(int i = 0; i < 2; ++i)
+  {
+    const int c = (i == 0) ? first : 1 - first;
+    if(d[c] < min_dist)
+    {
+      const bool stop = descend_first
+          ? distanceRecurse(parent->children[c], other, cdata, callback, min_dist)
+          : distanceRecurse(other, parent->children[c], cdata, callback, min_dist);
+      if(stop)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool distanceRecurse(typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root, ContinuousCollisionObject<S>* query, void* cdata, ContinuousDistanceCallBack<S> callback, S& min_dist)
+{
+  if(root->isLeaf())
+  {
+    ContinuousCollisionObject<S>* root_obj = static_cast<ContinuousCollisionObject<S>*>(root->data);
+    return callback(root_obj, query, cdata, min_dist);
+  }
+
+  S d[2];
+  d[0] = query->getAABB().distance(root->children[0]->bv);
+  d[1] = query->getAABB().distance(root->children[1]->bv);
+
+  const int first = (d[1] < d[0]) ? 1 : 0;
+  for(int i = 0; i < 2; ++i)
+  {
+    const int c = (i == 0) ? first : 1 - first;
+    if(d[c] < min_dist)
+    {
+      if(distanceRecurse(root->children[c], query, cdata, callback, min_dist))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool selfDistanceRecurse(typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode* root, void* cdata, ContinuousDistanceCallBack<S> callback, S& min_dist)
+{
+  if(root->isLeaf()) return false;
+
+  if(selfDistanceRecurse(root->children[0], cdata, callback, min_dist))
+    return true;
+
+  if(selfDistanceRecurse(root->children[1], cdata, callback, min_dist))
+    return true;
+
+  if(distanceRecurse(root->children[0], root->children[1], cdata, callback, min_dist))
+    return true;
+
+  return false;
+}
+
+} // namespace continuous_dynamic_AABB_tree
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBTreeContinuousCollisionManager()
+  : tree_topdown_balance_threshold(dtree.bu_threshold),
+    tree_topdown_level(dtree.topdown_level)
+{
+  max_tree_nonbalanced_level = 10;
+  tree_incremental_balance_pass = 10;
+  tree_topdown_balance_threshold = 2;
+  tree_topdown_level = 0;
+  tree_init_level = 0;
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::registerObjects(
+    const std::vector<ContinuousCollisionObject<S>*>& other_objs)
+{
+  if(other_objs.empty()) return;
+
+  if(size() > 0)
+  {
+    BroadPhaseContinuousCollisionManager<S>::registerObjects(other_objs);
+  }
+  else
+  {
+    std::vector<DynamicAABBNode*> leaves(other_objs.size());
+    table.rehash(other_objs.size());
+    for(size_t i = 0, size = other_objs.size(); i < size; ++i)
+    {
+      DynamicAABBNode* node = new DynamicAABBNode; // node will be managed by the dtree
+      node->bv = other_objs[i]->getAABB();
+      node->parent = nullptr;
+      node->children[1] = nullptr;
+      node->data = other_objs[i];
+      table[other_objs[i]] = node;
+      leaves[i] = node;
+    }
+
+    dtree.init(leaves, tree_init_level);
+
+    setup_ = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::registerObject(ContinuousCollisionObject<S>* obj)
+{
+  DynamicAABBNode* node = dtree.insert(obj->getAABB(), obj);
+  table[obj] = node;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::unregisterObject(ContinuousCollisionObject<S>* obj)
+{
+  const auto it = table.find(obj);
+  if(it == table.end())
+    return;
+
+  dtree.remove(it->second);
+  table.erase(it);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::setup()
+{
+  if(!setup_)
+  {
+    int num = dtree.size();
+    if(num == 0)
+    {
+      setup_ = true;
+      return;
+    }
+
+    int height = dtree.getMaxHeight();
+
+    if(height - std::log((S)num) / std::log(2.0) < max_tree_nonbalanced_level)
+      dtree.balanceIncremental(tree_incremental_balance_pass);
+    else
+      dtree.balanceTopdown();
+
+    setup_ = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update()
+{
+  for(auto it = table.cbegin(); it != table.cend(); ++it)
+  {
+    ContinuousCollisionObject<S>* obj = it->first;
+    DynamicAABBNode* node = it->second;
+    node->bv = obj->getAABB();
+  }
+
+  dtree.refit();
+  setup_ = false;
+
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update_(ContinuousCollisionObject<S>* updated_obj)
+{
+  const auto it = table.find(updated_obj);
+  if(it != table.end())
+  {
+    DynamicAABBNode* node = it->second;
+    if(!node->bv.equal(updated_obj->getAABB()))
+      dtree.update(node, updated_obj->getAABB());
+  }
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update(ContinuousCollisionObject<S>* updated_obj)
+{
+  update_(updated_obj);
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update(const std::vector<ContinuousCollisionObject<S>*>& updated_objs)
+{
+  for(size_t i = 0, size = updated_objs.size(); i < size; ++i)
+    update_(updated_objs[i]);
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::clear()
+{
+  dtree.clear();
+  table.clear();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::getObjects(std::vector<ContinuousCollisionObject<S>*>& objs) const
+{
+  objs.resize(this->size());
+  std::transform(table.begin(), table.end(), objs.begin(), std::bind(&DynamicAABBTable::value_type::first, std::placeholders::_1));
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(ContinuousCollisionObject<S>* obj, void* cdata, ContinuousCollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  detail::continuous_dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), obj, cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(ContinuousCollisionObject<S>* obj, void* cdata, ContinuousDistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), obj, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(void* cdata, ContinuousCollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  detail::continuous_dynamic_AABB_tree::selfCollisionRecurse(dtree.getRoot(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(void* cdata, ContinuousDistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::selfDistanceRecurse(dtree.getRoot(), cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata, ContinuousCollisionCallBack<S> callback) const
+{
+  DynamicAABBTreeContinuousCollisionManager* other_manager = static_cast<DynamicAABBTreeContinuousCollisionManager*>(other_manager_);
+  if((size() == 0) || (other_manager->size() == 0)) return;
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+  detail::continuous_dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata, ContinuousDistanceCallBack<S> callback) const
+{
+  DynamicAABBTreeContinuousCollisionManager* other_manager = static_cast<DynamicAABBTreeContinuousCollisionManager*>(other_manager_);
+  if((size() == 0) || (other_manager->size() == 0)) return;
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+bool DynamicAABBTreeContinuousCollisionManager<S>::empty() const
+{
+  return dtree.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t DynamicAABBTreeContinuousCollisionManager<S>::size() const
+{
+  return dtree.size();
+}
+
+//==============================================================================
+template <typename S>
+const detail::HierarchyTree<AABB<S>>&
+DynamicAABBTreeContinuousCollisionManager<S>::getTree() const
+{
+  return dtree;
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_H
+#define FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_H
+
+#include <unordered_map>
+#include <vector>
+#include "fcl/broadphase/broadphase_continuous_collision_manager.h"
+#include "fcl/broadphase/detail/hierarchy_tree.h"
+
+namespace fcl
+{
+
+/// @brief Continuous collision manager using a dynamic AABB tree over the
+/// swept AABBs of the objects, i.e. ContinuousCollisionObject::getAABB(), which
+/// bound the object over its whole motion. Only pairs whose swept AABBs overlap
+/// (or, for distance, are closer than the current minimum distance) are passed
+/// to the callback, which typically calls the CCD narrowphase. After changing
+/// the motion of an object, call computeAABB() on it and then update().
+template <typename S>
+class DynamicAABBTreeContinuousCollisionManager
+    : public BroadPhaseContinuousCollisionManager<S>
+{
+public:
+
+  using DynamicAABBNode = detail::NodeBase<AABB<S>>;
+  using DynamicAABBTable = std::unordered_map<ContinuousCollisionObject<S>*, DynamicAABBNode*>;
+
+  int max_tree_nonbalanced_level;
+  int tree_incremental_balance_pass;
+  int& tree_topdown_balance_threshold;
+  int& tree_topdown_level;
+  int tree_init_level;
+
+  DynamicAABBTreeContinuousCollisionManager();
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<ContinuousCollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(ContinuousCollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(ContinuousCollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(ContinuousCollisionObject<S>* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<ContinuousCollisionObject<S>*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<ContinuousCollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(ContinuousCollisionObject<S>* obj, void* cdata, ContinuousCollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging to the manager
+  void distance(ContinuousCollisionObject<S>* obj, void* cdata, ContinuousDistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
+  void collide(void* cdata, ContinuousCollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, ContinuousDistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata, ContinuousCollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata, ContinuousDistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  const detail::HierarchyTree<AABB<S>>& getTree() const;
+
+private:
+  detail::HierarchyTree<AABB<S>> dtree;
+  std::unordered_map<ContinuousCollisionObject<S>*, DynamicAABBNode*> table;
+
+  bool setup_;
+
+  void update_(ContinuousCollisionObject<S>* updated_obj);
+};
+
+using DynamicAABBTreeContinuousCollisionManagerf = DynamicAABBTreeContinuousCollisionManager<float>;
+using DynamicAABBTreeContinuousCollisionManagerd = DynamicAABBTreeContinuousCollisionManager<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_continuous_dynamic_AABB_tree-inl.h"
+
+#endif
@@ -40,11 +40,14 @@
 
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 
+#include <atomic>
 #include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "fcl/common/detail/parallel.h"
 
-#if FCL_HAVE_OCTOMAP
 #include "fcl/geometry/octree/octree.h"
-#endif
 
 namespace fcl {
 
@@ -56,7 +59,6 @@ namespace detail {
 
 namespace dynamic_AABB_tree {
 
-#if FCL_HAVE_OCTOMAP
 //==============================================================================
 template <typename S>
 bool collisionRecurse_(
@@ -480,77 +482,92 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNod
     return distanceRecurse_(root1, tree2, root2, root2_bv, tf2, cdata, callback, min_dist);
 }
 
-#endif
+//==============================================================================
+/// @brief Forward the function pointer callback of the octree traversal to the
+/// collision callable passed in cdata
+template <typename S, typename CollisionCallable>
+bool callableCollisionCallback(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata)
+{
+  return (*static_cast<CollisionCallable*>(cdata))(o1, o2);
+}
 
 //==============================================================================
-template <typename S>
+/// @brief Forward the function pointer callback of the octree traversal to the
+/// distance callable passed in cdata
+template <typename S, typename DistanceCallable>
+bool callableDistanceCallback(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata, S& dist)
+{
+  return (*static_cast<DistanceCallable*>(cdata))(o1, o2, dist);
+}
+
+//==============================================================================
+template <typename S, typename CollisionCallable>
 bool collisionRecurse(
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root1,
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root2,
-    void* cdata,
-    CollisionCallBack<S> callback)
+    CollisionCallable& callback)
 {
   if(root1->isLeaf() && root2->isLeaf())
   {
     if(!root1->bv.overlap(root2->bv)) return false;
-    return callback(static_cast<CollisionObject<S>*>(root1->data), static_cast<CollisionObject<S>*>(root2->data), cdata);
+    return callback(static_cast<CollisionObject<S>*>(root1->data), static_cast<CollisionObject<S>*>(root2->data));
   }
 
   if(!root1->bv.overlap(root2->bv)) return false;
 
   if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
   {
-    if(collisionRecurse(root1->children[0], root2, cdata, callback))
+    if(collisionRecurse<S>(root1->children[0], root2, callback))
       return true;
-    if(collisionRecurse(root1->children[1], root2, cdata, callback))
+    if(collisionRecurse<S>(root1->children[1], root2, callback))
       return true;
   }
   else
   {
-    if(collisionRecurse(root1, root2->children[0], cdata, callback))
+    if(collisionRecurse<S>(root1, root2->children[0], callback))
       return true;
-    if(collisionRecurse(root1, root2->children[1], cdata, callback))
+    if(collisionRecurse<S>(root1, root2->children[1], callback))
       return true;
   }
   return false;
 }
 
 //==============================================================================
-template <typename S>
-bool collisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, void* cdata, CollisionCallBack<S> callback)
+template <typename S, typename CollisionCallable>
+bool collisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, CollisionCallable& callback)
 {
   if(root->isLeaf())
   {
     if(!root->bv.overlap(query->getAABB())) return false;
-    return callback(static_cast<CollisionObject<S>*>(root->data), query, cdata);
+    return callback(static_cast<CollisionObject<S>*>(root->data), query);
   }
 
   if(!root->bv.overlap(query->getAABB())) return false;
 
   int select_res = select(query->getAABB(), *(root->children[0]), *(root->children[1]));
 
-  if(collisionRecurse(root->children[select_res], query, cdata, callback))
+  if(collisionRecurse<S>(root->children[select_res], query, callback))
     return true;
 
-  if(collisionRecurse(root->children[1-select_res], query, cdata, callback))
+  if(collisionRecurse<S>(root->children[1-select_res], query, callback))
     return true;
 
   return false;
 }
 
 //==============================================================================
-template <typename S>
-bool selfCollisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, void* cdata, CollisionCallBack<S> callback)
+template <typename S, typename CollisionCallable>
+bool selfCollisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionCallable& callback)
 {
   if(root->isLeaf()) return false;
 
-  if(selfCollisionRecurse(root->children[0], cdata, callback))
+  if(selfCollisionRecurse<S>(root->children[0], callback))
     return true;
 
-  if(selfCollisionRecurse(root->children[1], cdata, callback))
+  if(selfCollisionRecurse<S>(root->children[1], callback))
     return true;
 
-  if(collisionRecurse(root->children[0], root->children[1], cdata, callback))
+  if(collisionRecurse<S>(root->children[0], root->children[1], callback))
     return true;
 
   return false;
@@ -558,18 +575,111 @@ bool selfCollisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAA
 
 //==============================================================================
 template <typename S>
+using CollisionPairs = std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>>;
+
+//==============================================================================
+/// @brief Collision callable that records every pair and never stops the
+/// traversal
+template <typename S>
+struct CollectPairs
+{
+  CollisionPairs<S>& pairs;
+
+  bool operator()(CollisionObject<S>* o1, CollisionObject<S>* o2) const
+  {
+    pairs.emplace_back(o1, o2);
+    return false;
+  }
+};
+
+//==============================================================================
+/// @brief Split the self-collision traversal of root into independent tasks.
+/// A task (a, a) stands for the self collision of subtree a and a task (a, b)
+/// for the collision between subtrees a and b. The tasks are refined breadth
+/// first until there are at least min_tasks of them or none can be split any
+/// further; tasks that cannot produce a pair are dropped on the way.
+template <typename S>
+void splitSelfCollisionTasks(
+    typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root,
+    std::size_t min_tasks,
+    std::vector<std::pair<typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode*,
+                          typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode*>>& tasks)
+{
+  using Task = std::pair<typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode*,
+                         typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode*>;
+
+  tasks.clear();
+  if(!root->isLeaf())
+    tasks.emplace_back(root, root);
+
+  bool split = true;
+  while(split && tasks.size() < min_tasks)
+  {
+    split = false;
+    std::vector<Task> next;
+    next.reserve(3 * tasks.size());
+
+    for(const Task& task : tasks)
+    {
+      auto* a = task.first;
+      auto* b = task.second;
+
+      if(a == b)
+      {
+        if(a->isLeaf()) continue;
+        next.emplace_back(a->children[0], a->children[0]);
+        next.emplace_back(a->children[1], a->children[1]);
+        next.emplace_back(a->children[0], a->children[1]);
+        split = true;
+      }
+      else if(!a->bv.overlap(b->bv))
+      {
+        continue;
+      }
+      else if(a->isLeaf() && b->isLeaf())
+      {
+        next.push_back(task);
+      }
+      else if(b->isLeaf() || (!a->isLeaf() && (a->bv.size() > b->bv.size())))
+      {
+        next.emplace_back(a->children[0], b);
+        next.emplace_back(a->children[1], b);
+        split = true;
+      }
+      else
+      {
+        next.emplace_back(a, b->children[0]);
+        next.emplace_back(a, b->children[1]);
+        split = true;
+      }
+    }
+
+    tasks.swap(next);
+  }
+
+  // self tasks on leaves can survive the last round; they produce no pair
+  std::size_t num_tasks = 0;
+  for(const Task& task : tasks)
+  {
+    if(task.first == task.second && task.first->isLeaf()) continue;
+    tasks[num_tasks++] = task;
+  }
+  tasks.resize(num_tasks);
+}
+
+//==============================================================================
+template <typename S, typename DistanceCallable>
 bool distanceRecurse(
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root1,
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root2,
-    void* cdata,
-    DistanceCallBack<S> callback,
+    DistanceCallable& callback,
     S& min_dist)
 {
   if(root1->isLeaf() && root2->isLeaf())
   {
     CollisionObject<S>* root1_obj = static_cast<CollisionObject<S>*>(root1->data);
     CollisionObject<S>* root2_obj = static_cast<CollisionObject<S>*>(root2->data);
-    return callback(root1_obj, root2_obj, cdata, min_dist);
+    return callback(root1_obj, root2_obj, min_dist);
   }
 
   if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
@@ -581,13 +691,13 @@ bool distanceRecurse(
     {
       if(d2 < min_dist)
       {
-        if(distanceRecurse(root1->children[1], root2, cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1->children[1], root2, callback, min_dist))
           return true;
       }
 
       if(d1 < min_dist)
       {
-        if(distanceRecurse(root1->children[0], root2, cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1->children[0], root2, callback, min_dist))
           return true;
       }
     }
@@ -595,13 +705,13 @@ bool distanceRecurse(
     {
       if(d1 < min_dist)
       {
-        if(distanceRecurse(root1->children[0], root2, cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1->children[0], root2, callback, min_dist))
           return true;
       }
 
       if(d2 < min_dist)
       {
-        if(distanceRecurse(root1->children[1], root2, cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1->children[1], root2, callback, min_dist))
           return true;
       }
     }
@@ -615,13 +725,13 @@ bool distanceRecurse(
     {
       if(d2 < min_dist)
       {
-        if(distanceRecurse(root1, root2->children[1], cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1, root2->children[1], callback, min_dist))
           return true;
       }
 
       if(d1 < min_dist)
       {
-        if(distanceRecurse(root1, root2->children[0], cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1, root2->children[0], callback, min_dist))
           return true;
       }
     }
@@ -629,13 +739,13 @@ bool distanceRecurse(
     {
       if(d1 < min_dist)
       {
-        if(distanceRecurse(root1, root2->children[0], cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1, root2->children[0], callback, min_dist))
           return true;
       }
 
       if(d2 < min_dist)
       {
-        if(distanceRecurse(root1, root2->children[1], cdata, callback, min_dist))
+        if(distanceRecurse<S>(root1, root2->children[1], callback, min_dist))
           return true;
       }
     }
@@ -645,13 +755,13 @@ bool distanceRecurse(
 }
 
 //==============================================================================
-template <typename S>
-bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, void* cdata, DistanceCallBack<S> callback, S& min_dist)
+template <typename S, typename DistanceCallable>
+bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, DistanceCallable& callback, S& min_dist)
 {
   if(root->isLeaf())
   {
     CollisionObject<S>* root_obj = static_cast<CollisionObject<S>*>(root->data);
-    return callback(root_obj, query, cdata, min_dist);
+    return callback(root_obj, query, min_dist);
   }
 
   S d1 = query->getAABB().distance(root->children[0]->bv);
@@ -661,13 +771,13 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNod
   {
     if(d2 < min_dist)
     {
-      if(distanceRecurse(root->children[1], query, cdata, callback, min_dist))
+      if(distanceRecurse<S>(root->children[1], query, callback, min_dist))
         return true;
     }
 
     if(d1 < min_dist)
     {
-      if(distanceRecurse(root->children[0], query, cdata, callback, min_dist))
+      if(distanceRecurse<S>(root->children[0], query, callback, min_dist))
         return true;
     }
   }
@@ -675,13 +785,13 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNod
   {
     if(d1 < min_dist)
     {
-      if(distanceRecurse(root->children[0], query, cdata, callback, min_dist))
+      if(distanceRecurse<S>(root->children[0], query, callback, min_dist))
         return true;
     }
 
     if(d2 < min_dist)
     {
-      if(distanceRecurse(root->children[1], query, cdata, callback, min_dist))
+      if(distanceRecurse<S>(root->children[1], query, callback, min_dist))
         return true;
     }
   }
@@ -690,18 +800,18 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNod
 }
 
 //==============================================================================
-template <typename S>
-bool selfDistanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, void* cdata, DistanceCallBack<S> callback, S& min_dist)
+template <typename S, typename DistanceCallable>
+bool selfDistanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, DistanceCallable& callback, S& min_dist)
 {
   if(root->isLeaf()) return false;
 
-  if(selfDistanceRecurse(root->children[0], cdata, callback, min_dist))
+  if(selfDistanceRecurse<S>(root->children[0], callback, min_dist))
     return true;
 
-  if(selfDistanceRecurse(root->children[1], cdata, callback, min_dist))
+  if(selfDistanceRecurse<S>(root->children[1], callback, min_dist))
     return true;
 
-  if(distanceRecurse(root->children[0], root->children[1], cdata, callback, min_dist))
+  if(distanceRecurse<S>(root->children[0], root->children[1], callback, min_dist))
     return true;
 
   return false;
@@ -727,6 +837,12 @@ DynamicAABBTreeCollisionManager<S>::DynamicAABBTreeCollisionManager()
   // from experiment, this is the optimal setting
   octree_as_geometry_collide = true;
   octree_as_geometry_distance = false;
+
+  fat_aabb_margin = 0;
+  fat_aabb_velocity_scale = 1;
+
+  reinsertion_count = 0;
+  skipped_update_count = 0;
 }
 
 //==============================================================================
@@ -747,7 +863,7 @@ void DynamicAABBTreeCollisionManager<S>::registerObjects(
     for(size_t i = 0, size = other_objs.size(); i < size; ++i)
     {
       DynamicAABBNode* node = new DynamicAABBNode; // node will be managed by the dtree
-      node->bv = other_objs[i]->getAABB();
+      node->bv = leafAABB(other_objs[i]);
       node->parent = nullptr;
       node->children[1] = nullptr;
       node->data = other_objs[i];
@@ -765,7 +881,7 @@ void DynamicAABBTreeCollisionManager<S>::registerObjects(
 template <typename S>
 void DynamicAABBTreeCollisionManager<S>::registerObject(CollisionObject<S>* obj)
 {
-  DynamicAABBNode* node = dtree.insert(obj->getAABB(), obj);
+  DynamicAABBNode* node = dtree.insert(leafAABB(obj), obj);
   table[obj] = node;
 }
 
@@ -775,6 +891,7 @@ void DynamicAABBTreeCollisionManager<S>::unregisterObject(CollisionObject<S>* ob
 {
   DynamicAABBNode* node = table[obj];
   table.erase(obj);
+  prev_centers.erase(obj);
   dtree.remove(node);
 }
 
@@ -807,6 +924,15 @@ void DynamicAABBTreeCollisionManager<S>::setup()
 template <typename S>
 void DynamicAABBTreeCollisionManager<S>::update()
 {
+  if(fat_aabb_margin > 0)
+  {
+    for(auto it = table.cbegin(); it != table.cend(); ++it)
+      update_(it->first);
+
+    setup();
+    return;
+  }
+
   for(auto it = table.cbegin(); it != table.cend(); ++it)
   {
     CollisionObject<S>* obj = it->first;
@@ -828,8 +954,34 @@ void DynamicAABBTreeCollisionManager<S>::update_(CollisionObject<S>* updated_obj
   if(it != table.end())
   {
     DynamicAABBNode* node = it->second;
-    if(!node->bv.equal(updated_obj->getAABB()))
-      dtree.update(node, updated_obj->getAABB());
+    const AABB<S>& aabb = updated_obj->getAABB();
+    bool reinserted;
+    if(fat_aabb_margin > 0)
+    {
+      const Vector3<S> center = aabb.center();
+      auto prev = prev_centers.find(updated_obj);
+      Vector3<S> vel = Vector3<S>::Zero();
+      if(prev != prev_centers.end())
+      {
+        vel = (center - prev->second) * fat_aabb_velocity_scale;
+        prev->second = center;
+      }
+      else
+      {
+        prev_centers[updated_obj] = center;
+      }
+
+      reinserted = dtree.update(node, aabb, vel, fat_aabb_margin);
+    }
+    else
+    {
+      reinserted = !node->bv.equal(aabb) && dtree.update(node, aabb);
+    }
+
+    if(reinserted)
+      ++reinsertion_count;
+    else
+      ++skipped_update_count;
   }
   setup_ = false;
 }
@@ -857,6 +1009,7 @@ void DynamicAABBTreeCollisionManager<S>::clear()
 {
   dtree.clear();
   table.clear();
+  prev_centers.clear();
 }
 
 //==============================================================================
@@ -870,88 +1023,217 @@ void DynamicAABBTreeCollisionManager<S>::getObjects(std::vector<CollisionObject<
 //==============================================================================
 template <typename S>
 void DynamicAABBTreeCollisionManager<S>::collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  collide(obj, [=](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    return callback(o1, o2, cdata);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  distance(obj, [=](CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist)
+  {
+    return callback(o1, o2, cdata, dist);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
+{
+  collide([=](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    return callback(o1, o2, cdata);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::collideParallel(const std::vector<void*>& cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0 || cdata.empty()) return;
+
+  if(cdata.size() == 1)
+  {
+    collide(cdata[0], callback);
+    return;
+  }
+
+  const unsigned int num_threads = static_cast<unsigned int>(cdata.size());
+
+  // A few tasks per thread so that uneven subtrees still balance out
+  std::vector<std::pair<DynamicAABBNode*, DynamicAABBNode*>> tasks;
+  detail::dynamic_AABB_tree::splitSelfCollisionTasks<S>(dtree.getRoot(), 8 * num_threads, tasks);
+
+  std::vector<CollisionPairs> task_pairs(tasks.size());
+  detail::parallelFor(tasks.size(), num_threads, [&](std::size_t i, unsigned int)
+  {
+    detail::dynamic_AABB_tree::CollectPairs<S> collect{task_pairs[i]};
+    if(tasks[i].first == tasks[i].second)
+      detail::dynamic_AABB_tree::selfCollisionRecurse<S>(tasks[i].first, collect);
+    else
+      detail::dynamic_AABB_tree::collisionRecurse<S>(tasks[i].first, tasks[i].second, collect);
+  });
+
+  // Merge in task order so that the result does not depend on scheduling
+  std::size_t num_pairs = 0;
+  for(const auto& pairs : task_pairs)
+    num_pairs += pairs.size();
+
+  CollisionPairs pairs;
+  pairs.reserve(num_pairs);
+  for(const auto& task : task_pairs)
+    pairs.insert(pairs.end(), task.begin(), task.end());
+  task_pairs.clear();
+
+  std::atomic<bool> done(false);
+  detail::parallelForChunks(pairs.size(), num_threads, [&](std::size_t begin, std::size_t end, unsigned int thread_id)
+  {
+    for(std::size_t i = begin; i < end && !done; ++i)
+    {
+      if(callback(pairs[i].first, pairs[i].second, cdata[thread_id]))
+        done = true;
+    }
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback) const
+{
+  distance([=](CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist)
+  {
+    return callback(o1, o2, cdata, dist);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
+{
+  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  collide(other_manager, [=](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    return callback(o1, o2, cdata);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
+{
+  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  distance(other_manager, [=](CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist)
+  {
+    return callback(o1, o2, cdata, dist);
+  });
+}
+
+//==============================================================================
+template <typename S>
+template <typename CollisionCallable>
+void DynamicAABBTreeCollisionManager<S>::collide(CollisionObject<S>* obj, CollisionCallable&& callback) const
 {
   if(size() == 0) return;
   switch(obj->collisionGeometry()->getNodeType())
   {
-#if FCL_HAVE_OCTOMAP
   case GEOM_OCTREE:
     {
       if(!octree_as_geometry_collide)
       {
+        // the octree traversal takes a function pointer, which forwards to the
+        // callable
+        using Callable = typename std::remove_reference<CollisionCallable>::type;
+        void* cdata = const_cast<void*>(static_cast<const void*>(&callback));
         const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
-        detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback);
+        detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, detail::dynamic_AABB_tree::callableCollisionCallback<S, Callable>);
       }
       else
-        detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), obj, cdata, callback);
+        detail::dynamic_AABB_tree::collisionRecurse<S>(dtree.getRoot(), obj, callback);
     }
     break;
-#endif
   default:
-    detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), obj, cdata, callback);
+    detail::dynamic_AABB_tree::collisionRecurse<S>(dtree.getRoot(), obj, callback);
   }
 }
 
 //==============================================================================
 template <typename S>
-void DynamicAABBTreeCollisionManager<S>::distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+template <typename DistanceCallable>
+void DynamicAABBTreeCollisionManager<S>::distance(CollisionObject<S>* obj, DistanceCallable&& callback) const
 {
   if(size() == 0) return;
   S min_dist = std::numeric_limits<S>::max();
   switch(obj->collisionGeometry()->getNodeType())
   {
-#if FCL_HAVE_OCTOMAP
   case GEOM_OCTREE:
     {
       if(!octree_as_geometry_distance)
       {
+        // the octree traversal takes a function pointer, which forwards to the
+        // callable
+        using Callable = typename std::remove_reference<DistanceCallable>::type;
+        void* cdata = const_cast<void*>(static_cast<const void*>(&callback));
         const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
-        detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback, min_dist);
+        detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, detail::dynamic_AABB_tree::callableDistanceCallback<S, Callable>, min_dist);
       }
       else
-        detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), obj, cdata, callback, min_dist);
+        detail::dynamic_AABB_tree::distanceRecurse<S>(dtree.getRoot(), obj, callback, min_dist);
     }
     break;
-#endif
   default:
-    detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), obj, cdata, callback, min_dist);
+    detail::dynamic_AABB_tree::distanceRecurse<S>(dtree.getRoot(), obj, callback, min_dist);
   }
 }
 
 //==============================================================================
 template <typename S>
-void DynamicAABBTreeCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
+template <typename CollisionCallable>
+void DynamicAABBTreeCollisionManager<S>::collide(CollisionCallable&& callback) const
 {
   if(size() == 0) return;
-  detail::dynamic_AABB_tree::selfCollisionRecurse(dtree.getRoot(), cdata, callback);
+  detail::dynamic_AABB_tree::selfCollisionRecurse<S>(dtree.getRoot(), callback);
 }
 
 //==============================================================================
 template <typename S>
-void DynamicAABBTreeCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback) const
+template <typename DistanceCallable>
+void DynamicAABBTreeCollisionManager<S>::distance(DistanceCallable&& callback) const
 {
   if(size() == 0) return;
   S min_dist = std::numeric_limits<S>::max();
-  detail::dynamic_AABB_tree::selfDistanceRecurse(dtree.getRoot(), cdata, callback, min_dist);
+  detail::dynamic_AABB_tree::selfDistanceRecurse<S>(dtree.getRoot(), callback, min_dist);
 }
 
 //==============================================================================
 template <typename S>
-void DynamicAABBTreeCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
+template <typename CollisionCallable>
+void DynamicAABBTreeCollisionManager<S>::collide(const DynamicAABBTreeCollisionManager* other_manager, CollisionCallable&& callback) const
 {
-  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
   if((size() == 0) || (other_manager->size() == 0)) return;
-  detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback);
+  detail::dynamic_AABB_tree::collisionRecurse<S>(dtree.getRoot(), other_manager->dtree.getRoot(), callback);
 }
 
 //==============================================================================
 template <typename S>
-void DynamicAABBTreeCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
+template <typename DistanceCallable>
+void DynamicAABBTreeCollisionManager<S>::distance(const DynamicAABBTreeCollisionManager* other_manager, DistanceCallable&& callback) const
 {
-  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
   if((size() == 0) || (other_manager->size() == 0)) return;
   S min_dist = std::numeric_limits<S>::max();
-  detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback, min_dist);
+  detail::dynamic_AABB_tree::distanceRecurse<S>(dtree.getRoot(), other_manager->dtree.getRoot(), callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::collidePairs(CollisionPairs& pairs) const
+{
+  if(size() == 0) return;
+  detail::dynamic_AABB_tree::CollectPairs<S> collect{pairs};
+  detail::dynamic_AABB_tree::selfCollisionRecurse<S>(dtree.getRoot(), collect);
 }
 
 //==============================================================================
@@ -968,6 +1250,41 @@ size_t DynamicAABBTreeCollisionManager<S>::size() const
   return dtree.size();
 }
 
+//==============================================================================
+template <typename S>
+size_t DynamicAABBTreeCollisionManager<S>::getReinsertionCount() const
+{
+  return reinsertion_count;
+}
+
+//==============================================================================
+template <typename S>
+size_t DynamicAABBTreeCollisionManager<S>::getSkippedUpdateCount() const
+{
+  return skipped_update_count;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeCollisionManager<S>::resetUpdateCounters()
+{
+  reinsertion_count = 0;
+  skipped_update_count = 0;
+}
+
+//==============================================================================
+template <typename S>
+AABB<S> DynamicAABBTreeCollisionManager<S>::leafAABB(CollisionObject<S>* obj) const
+{
+  AABB<S> bv = obj->getAABB();
+  if(fat_aabb_margin > 0)
+  {
+    bv.min_.array() -= fat_aabb_margin;
+    bv.max_.array() += fat_aabb_margin;
+  }
+  return bv;
+}
+
 //==============================================================================
 template <typename S>
 const detail::HierarchyTree<AABB<S>>&
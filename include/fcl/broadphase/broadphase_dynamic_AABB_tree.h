@@ -40,6 +40,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <vector>
 
 #include "fcl/math/bv/utility.h"
 #include "fcl/geometry/shape/box.h"
@@ -57,6 +58,7 @@ public:
 
   using DynamicAABBNode = detail::NodeBase<AABB<S>>;
   using DynamicAABBTable = std::unordered_map<CollisionObject<S>*, DynamicAABBNode*> ;
+  using CollisionPairs = std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>>;
 
   int max_tree_nonbalanced_level;
   int tree_incremental_balance_pass;
@@ -67,6 +69,17 @@ public:
   bool octree_as_geometry_collide;
   bool octree_as_geometry_distance;
 
+  /// @brief margin by which the leaf AABBs are enlarged on every side. When
+  /// positive, the leaves are also extended along the displacement of the
+  /// object since its previous update, and an updated object is only
+  /// reinserted when its AABB leaves the enlarged one. 0 (default) keeps the
+  /// leaves tight.
+  S fat_aabb_margin;
+
+  /// @brief scale applied to the displacement of an object since its previous
+  /// update when predicting its motion; only used when fat_aabb_margin > 0
+  S fat_aabb_velocity_scale;
+
   DynamicAABBTreeCollisionManager();
 
   /// @brief add objects to the manager
@@ -108,12 +121,58 @@ public:
   /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
   void distance(void* cdata, DistanceCallBack<S> callback) const;
 
+  /// @brief perform collision test for the objects belonging to the manager
+  /// using one thread per entry of cdata. The tree is split into subtree-pair
+  /// tasks whose overlapping leaf pairs are gathered in parallel and merged in
+  /// a fixed order; the pairs are then split into contiguous chunks and thread
+  /// i calls callback with cdata[i] on its chunk, so every thread sees the same
+  /// pairs on every run. Once a callback returns true, the remaining pairs are
+  /// skipped.
+  void collideParallel(const std::vector<void*>& cdata, CollisionCallBack<S> callback) const;
+
   /// @brief perform collision test with objects belonging to another manager
   void collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const;
 
   /// @brief perform distance test with objects belonging to another manager
   void distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const;
   
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager. callback can be any callable with the signature
+  /// bool(CollisionObject<S>* o1, CollisionObject<S>* o2); it is called
+  /// directly by the traversal so that it can be inlined.
+  template <typename CollisionCallable>
+  void collide(CollisionObject<S>* obj, CollisionCallable&& callback) const;
+
+  /// @brief perform distance computation between one object and all the
+  /// objects belonging to the manager. callback can be any callable with the
+  /// signature bool(CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist).
+  template <typename DistanceCallable>
+  void distance(CollisionObject<S>* obj, DistanceCallable&& callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager
+  /// (i.e., N^2 self collision) with a callable callback
+  template <typename CollisionCallable>
+  void collide(CollisionCallable&& callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager
+  /// (i.e., N^2 self distance) with a callable callback
+  template <typename DistanceCallable>
+  void distance(DistanceCallable&& callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  /// with a callable callback
+  template <typename CollisionCallable>
+  void collide(const DynamicAABBTreeCollisionManager* other_manager, CollisionCallable&& callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  /// with a callable callback
+  template <typename DistanceCallable>
+  void distance(const DynamicAABBTreeCollisionManager* other_manager, DistanceCallable&& callback) const;
+
+  /// @brief append the pairs of objects belonging to the manager whose AABBs
+  /// overlap to pairs, without calling any narrow phase callback
+  void collidePairs(CollisionPairs& pairs) const;
+
   /// @brief whether the manager is empty
   bool empty() const;
   
@@ -122,12 +181,34 @@ public:
 
   const detail::HierarchyTree<AABB<S>>& getTree() const;
 
+  /// @brief the number of updated objects that were removed and reinserted
+  /// into the tree since the last call to resetUpdateCounters()
+  size_t getReinsertionCount() const;
+
+  /// @brief the number of updated objects whose leaf still contained their
+  /// AABB, so that no reinsertion was needed, since the last call to
+  /// resetUpdateCounters()
+  size_t getSkippedUpdateCount() const;
+
+  /// @brief reset the reinsertion and skipped update counters
+  void resetUpdateCounters();
+
 private:
   detail::HierarchyTree<AABB<S>> dtree;
   std::unordered_map<CollisionObject<S>*, DynamicAABBNode*> table;
 
+  /// @brief AABB centers of the objects at their previous update, used to
+  /// predict the motion when fat_aabb_margin > 0
+  std::unordered_map<CollisionObject<S>*, Vector3<S>> prev_centers;
+
   bool setup_;
 
+  size_t reinsertion_count;
+  size_t skipped_update_count;
+
+  /// @brief the AABB stored in the leaf of a newly registered object
+  AABB<S> leafAABB(CollisionObject<S>* obj) const;
+
   void update_(CollisionObject<S>* updated_obj);
 };
 
@@ -40,9 +40,7 @@
 
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
 
-#if FCL_HAVE_OCTOMAP
 #include "fcl/geometry/octree/octree.h"
-#endif
 
 namespace fcl
 {
@@ -57,8 +55,6 @@ namespace detail
 namespace dynamic_AABB_tree_array
 {
 
-#if FCL_HAVE_OCTOMAP
-
 //==============================================================================
 template <typename S>
 bool collisionRecurse_(
@@ -456,8 +452,6 @@ bool distanceRecurse_(
 }
 
 
-#endif
-
 //==============================================================================
 template <typename S>
 bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes1, size_t root1_id,
@@ -687,8 +681,6 @@ bool selfDistanceRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::Dyna
 }
 
 
-#if FCL_HAVE_OCTOMAP
-
 //==============================================================================
 template <typename S>
 bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes1, size_t root1_id, const OcTree<S>* tree2, const typename OcTree<S>::OcTreeNode* root2, const AABB<S>& root2_bv, const Transform3<S>& tf2, void* cdata, CollisionCallBack<S> callback)
@@ -709,8 +701,6 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicA
     return distanceRecurse_(nodes1, root1_id, tree2, root2, root2_bv, tf2, cdata, callback, min_dist);
 }
 
-#endif
-
 } // namespace dynamic_AABB_tree_array
 
 } // namespace detail
@@ -878,7 +868,6 @@ void DynamicAABBTreeCollisionManager_Array<S>::collide(CollisionObject<S>* obj,
   if(size() == 0) return;
   switch(obj->collisionGeometry()->getNodeType())
   {
-#if FCL_HAVE_OCTOMAP
   case GEOM_OCTREE:
     {
       if(!octree_as_geometry_collide)
@@ -890,7 +879,6 @@ void DynamicAABBTreeCollisionManager_Array<S>::collide(CollisionObject<S>* obj,
         detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback);
     }
     break;
-#endif
   default:
     detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback);
   }
@@ -904,7 +892,6 @@ void DynamicAABBTreeCollisionManager_Array<S>::distance(CollisionObject<S>* obj,
   S min_dist = std::numeric_limits<S>::max();
   switch(obj->collisionGeometry()->getNodeType())
   {
-#if FCL_HAVE_OCTOMAP
   case GEOM_OCTREE:
     {
       if(!octree_as_geometry_distance)
@@ -916,7 +903,6 @@ void DynamicAABBTreeCollisionManager_Array<S>::distance(CollisionObject<S>* obj,
         detail::dynamic_AABB_tree_array::distanceRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback, min_dist);
     }
     break;
-#endif
   default:
     detail::dynamic_AABB_tree_array::distanceRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback, min_dist);
   }
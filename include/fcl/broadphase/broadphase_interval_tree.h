@@ -40,6 +40,7 @@
 
 #include <deque>
 #include <map>
+#include <set>
 #include "fcl/broadphase/broadphase_collision_manager.h"
 #include "fcl/broadphase/detail/interval_tree.h"
 
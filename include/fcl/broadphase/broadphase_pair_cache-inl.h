@@ -0,0 +1,258 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASEPAIRCACHE_INL_H
+#define FCL_BROADPHASE_BROADPHASEPAIRCACHE_INL_H
+
+#include "fcl/broadphase/broadphase_pair_cache.h"
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+struct BroadPhasePair<double>;
+
+//==============================================================================
+extern template
+class BroadPhasePairCache<double>;
+
+//==============================================================================
+template <typename S>
+BroadPhasePair<S>::BroadPhasePair(CollisionObject<S>* o1, CollisionObject<S>* o2)
+  : o1(o1),
+    o2(o2),
+    cached_gjk_guess(Vector3<S>::UnitX()),
+    last_distance(-1),
+    is_collide(false),
+    num_updates(1),
+    user_data(nullptr)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+BroadPhasePairCache<S>::BroadPhasePairCache()
+  : update_id_(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhasePairCache<S>::update(const BroadPhaseCollisionManager<S>* manager)
+{
+  ++update_id_;
+  begin_pairs_.clear();
+  persist_pairs_.clear();
+  end_pairs_.clear();
+
+  manager->collide(this, collectPair);
+
+  for(auto it = pairs_.begin(); it != pairs_.end();)
+  {
+    if(it->second.update_id != update_id_)
+    {
+      end_pairs_.push_back(it->second.pair);
+      it = pairs_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+const std::vector<BroadPhasePair<S>*>& BroadPhasePairCache<S>::getBeginPairs() const
+{
+  return begin_pairs_;
+}
+
+//==============================================================================
+template <typename S>
+const std::vector<BroadPhasePair<S>*>& BroadPhasePairCache<S>::getPersistPairs() const
+{
+  return persist_pairs_;
+}
+
+//==============================================================================
+template <typename S>
+const std::vector<BroadPhasePair<S>>& BroadPhasePairCache<S>::getEndPairs() const
+{
+  return end_pairs_;
+}
+
+//==============================================================================
+template <typename S>
+BroadPhasePair<S>* BroadPhasePairCache<S>::find(CollisionObject<S>* a, CollisionObject<S>* b)
+{
+  auto it = pairs_.find(makeKey(a, b));
+  if(it == pairs_.end())
+    return nullptr;
+
+  return &it->second.pair;
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhasePairCache<S>::remove(CollisionObject<S>* obj)
+{
+  for(auto it = pairs_.begin(); it != pairs_.end();)
+  {
+    if(it->first.first == obj || it->first.second == obj)
+      it = pairs_.erase(it);
+    else
+      ++it;
+  }
+
+  // the events of the last update must not point to the dropped pairs
+  begin_pairs_.clear();
+  persist_pairs_.clear();
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhasePairCache<S>::clear()
+{
+  pairs_.clear();
+  begin_pairs_.clear();
+  persist_pairs_.clear();
+  end_pairs_.clear();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t BroadPhasePairCache<S>::size() const
+{
+  return pairs_.size();
+}
+
+//==============================================================================
+template <typename S>
+bool BroadPhasePairCache<S>::collide(
+    BroadPhasePair<S>& pair,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result)
+{
+  // Only the shape-shape queries of the independent GJK solver read and write
+  // the cached guess, the other solvers and geometry types ignore it.
+  const bool warm_start = request.gjk_solver_type == GST_INDEP
+      && pair.o1->getObjectType() == OT_GEOM
+      && pair.o2->getObjectType() == OT_GEOM;
+
+  if(warm_start)
+  {
+    CollisionRequest<S> warm_request = request;
+    warm_request.enable_cached_gjk_guess = true;
+    warm_request.cached_gjk_guess = pair.cached_gjk_guess;
+
+    ::fcl::collide(pair.o1, pair.o2, warm_request, result);
+
+    pair.cached_gjk_guess = result.cached_gjk_guess;
+  }
+  else
+  {
+    ::fcl::collide(pair.o1, pair.o2, request, result);
+  }
+
+  pair.is_collide = result.isCollision();
+
+  return pair.is_collide;
+}
+
+//==============================================================================
+template <typename S>
+S BroadPhasePairCache<S>::distance(
+    BroadPhasePair<S>& pair,
+    const DistanceRequest<S>& request,
+    DistanceResult<S>& result)
+{
+  pair.last_distance = ::fcl::distance(pair.o1, pair.o2, request, result);
+
+  return pair.last_distance;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t BroadPhasePairCache<S>::KeyHash::operator()(const Key& key) const
+{
+  const std::size_t h1 = std::hash<CollisionObject<S>*>()(key.first);
+  const std::size_t h2 = std::hash<CollisionObject<S>*>()(key.second);
+  return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+//==============================================================================
+template <typename S>
+typename BroadPhasePairCache<S>::Key BroadPhasePairCache<S>::makeKey(
+    CollisionObject<S>* a, CollisionObject<S>* b)
+{
+  if(a < b) return Key(a, b);
+  else return Key(b, a);
+}
+
+//==============================================================================
+template <typename S>
+bool BroadPhasePairCache<S>::collectPair(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata)
+{
+  BroadPhasePairCache* cache = static_cast<BroadPhasePairCache*>(cdata);
+
+  const Key key = makeKey(o1, o2);
+  auto it = cache->pairs_.find(key);
+  if(it == cache->pairs_.end())
+  {
+    Entry entry{BroadPhasePair<S>(key.first, key.second), cache->update_id_};
+    it = cache->pairs_.emplace(key, entry).first;
+    cache->begin_pairs_.push_back(&it->second.pair);
+  }
+  else if(it->second.update_id != cache->update_id_)
+  {
+    // managers may report a pair more than once in an update
+    it->second.update_id = cache->update_id_;
+    ++it->second.pair.num_updates;
+    cache->persist_pairs_.push_back(&it->second.pair);
+  }
+
+  return false;
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASEPAIRCACHE_H
+#define FCL_BROADPHASE_BROADPHASEPAIRCACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/narrowphase/collision_request.h"
+#include "fcl/narrowphase/collision_result.h"
+#include "fcl/narrowphase/distance_request.h"
+#include "fcl/narrowphase/distance_result.h"
+
+namespace fcl
+{
+
+/// @brief A pair of objects whose AABBs overlap, with the narrow phase state
+/// kept across the updates of a BroadPhasePairCache
+template <typename S>
+struct BroadPhasePair
+{
+  /// @brief the objects, o1 has the lower address
+  CollisionObject<S>* o1;
+  CollisionObject<S>* o2;
+
+  /// @brief the GJK guess found by the last narrow phase on the pair
+  Vector3<S> cached_gjk_guess;
+
+  /// @brief the separation distance found by the last distance query on the
+  /// pair, negative if there was none
+  S last_distance;
+
+  /// @brief whether the last collision query on the pair found a collision
+  bool is_collide;
+
+  /// @brief the number of consecutive updates in which the AABBs overlapped
+  std::size_t num_updates;
+
+  /// @brief user defined data attached to the pair
+  void* user_data;
+
+  BroadPhasePair(CollisionObject<S>* o1, CollisionObject<S>* o2);
+};
+
+/// @brief Cache of the overlapping pairs of a broad phase manager across its
+/// updates. Each update() reports the pairs whose AABBs began to overlap,
+/// still overlap or stopped overlapping since the previous update, and the
+/// persisting pairs keep their narrow phase state so that stable contacts can
+/// be skipped or warm started.
+template <typename S>
+class BroadPhasePairCache
+{
+public:
+  BroadPhasePairCache();
+
+  /// @brief collect the overlapping pairs of the objects of the manager and
+  /// sort them into begin, persist and end events
+  void update(const BroadPhaseCollisionManager<S>* manager);
+
+  /// @brief the pairs whose AABBs began to overlap in the last update
+  const std::vector<BroadPhasePair<S>*>& getBeginPairs() const;
+
+  /// @brief the pairs whose AABBs overlapped in the last two updates
+  const std::vector<BroadPhasePair<S>*>& getPersistPairs() const;
+
+  /// @brief the pairs whose AABBs stopped overlapping in the last update.
+  /// They are no longer in the cache.
+  const std::vector<BroadPhasePair<S>>& getEndPairs() const;
+
+  /// @brief the cached pair of two objects, nullptr if their AABBs do not
+  /// overlap
+  BroadPhasePair<S>* find(CollisionObject<S>* a, CollisionObject<S>* b);
+
+  /// @brief drop the pairs of an object, e.g. before it is unregistered from
+  /// the manager and deleted. No end event is reported for them.
+  void remove(CollisionObject<S>* obj);
+
+  /// @brief drop all the pairs
+  void clear();
+
+  /// @brief the number of overlapping pairs
+  std::size_t size() const;
+
+  /// @brief run the collision query on a pair; shape pairs solved with
+  /// GST_INDEP warm start GJK from, and update, the cached guess of the pair
+  static bool collide(BroadPhasePair<S>& pair,
+                      const CollisionRequest<S>& request,
+                      CollisionResult<S>& result);
+
+  /// @brief run the distance query on a pair and record the distance
+  static S distance(BroadPhasePair<S>& pair,
+                    const DistanceRequest<S>& request,
+                    DistanceResult<S>& result);
+
+private:
+  using Key = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    BroadPhasePair<S> pair;
+
+    /// @brief the last update in which the AABBs overlapped
+    std::uint64_t update_id;
+  };
+
+  std::unordered_map<Key, Entry, KeyHash> pairs_;
+
+  std::uint64_t update_id_;
+
+  std::vector<BroadPhasePair<S>*> begin_pairs_;
+  std::vector<BroadPhasePair<S>*> persist_pairs_;
+  std::vector<BroadPhasePair<S>> end_pairs_;
+
+  static Key makeKey(CollisionObject<S>* a, CollisionObject<S>* b);
+
+  static bool collectPair(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata);
+};
+
+using BroadPhasePairCachef = BroadPhasePairCache<float>;
+using BroadPhasePairCached = BroadPhasePairCache<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_pair_cache-inl.h"
+
+#endif
@@ -43,6 +43,13 @@
 namespace fcl
 {
 
+//==============================================================================
+extern template
+class SpatialHashingCollisionManager<
+    double,
+    detail::FlatHashTable<
+        AABB<double>, CollisionObject<double>*, detail::SpatialHash<double>>>;
+
 //==============================================================================
 extern template
 class SpatialHashingCollisionManager<
@@ -75,48 +82,35 @@ template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::registerObject(
     CollisionObject<S>* obj)
 {
+  obj_index_map[obj] = objs.size();
   objs.push_back(obj);
+  obj_infos.emplace_back();
 
-  const AABB<S>& obj_aabb = obj->getAABB();
-  AABB<S> overlap_aabb;
-
-  if(scene_limit.overlap(obj_aabb, overlap_aabb))
-  {
-    if(!scene_limit.contain(obj_aabb))
-      objs_partially_penetrating_scene_limit.push_back(obj);
-
-    hash_table->insert(overlap_aabb, obj);
-  }
-  else
-  {
-    objs_outside_scene_limit.push_back(obj);
-  }
-
-  obj_aabb_map[obj] = obj_aabb;
+  insertObject(obj, obj_infos.back());
 }
 
 //==============================================================================
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::unregisterObject(CollisionObject<S>* obj)
 {
-  objs.remove(obj);
-
-  const AABB<S>& obj_aabb = obj->getAABB();
-  AABB<S> overlap_aabb;
+  auto it = obj_index_map.find(obj);
+  if(it == obj_index_map.end())
+    return;
 
-  if(scene_limit.overlap(obj_aabb, overlap_aabb))
-  {
-    if(!scene_limit.contain(obj_aabb))
-      objs_partially_penetrating_scene_limit.remove(obj);
+  const std::size_t index = it->second;
+  removeObject(obj, obj_infos[index]);
+  obj_index_map.erase(it);
 
-    hash_table->remove(overlap_aabb, obj);
-  }
-  else
+  // Move the last object into the freed slot
+  const std::size_t last = objs.size() - 1;
+  if(index != last)
   {
-    objs_outside_scene_limit.remove(obj);
+    objs[index] = objs[last];
+    obj_infos[index] = obj_infos[last];
+    obj_index_map[objs[index]] = index;
   }
-
-  obj_aabb_map.erase(obj);
+  objs.pop_back();
+  obj_infos.pop_back();
 }
 
 //==============================================================================
@@ -134,140 +128,21 @@ void SpatialHashingCollisionManager<S, HashTable>::update()
   objs_partially_penetrating_scene_limit.clear();
   objs_outside_scene_limit.clear();
 
-  for(auto it = objs.cbegin(), end = objs.cend(); it != end; ++it)
-  {
-    CollisionObject<S>* obj = *it;
-    const AABB<S>& obj_aabb = obj->getAABB();
-    AABB<S> overlap_aabb;
-
-    if(scene_limit.overlap(obj_aabb, overlap_aabb))
-    {
-      if(!scene_limit.contain(obj_aabb))
-        objs_partially_penetrating_scene_limit.push_back(obj);
-
-      hash_table->insert(overlap_aabb, obj);
-    }
-    else
-    {
-      objs_outside_scene_limit.push_back(obj);
-    }
-
-    obj_aabb_map[obj] = obj_aabb;
-  }
+  for(std::size_t i = 0; i < objs.size(); ++i)
+    insertObject(objs[i], obj_infos[i]);
 }
 
 //==============================================================================
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::update(CollisionObject<S>* updated_obj)
 {
-  const AABB<S>& new_aabb = updated_obj->getAABB();
-  const AABB<S>& old_aabb = obj_aabb_map[updated_obj];
-
-  AABB<S> old_overlap_aabb;
-  const auto is_old_aabb_overlapping
-      = scene_limit.overlap(old_aabb, old_overlap_aabb);
-  if(is_old_aabb_overlapping)
-    hash_table->remove(old_overlap_aabb, updated_obj);
-
-  AABB<S> new_overlap_aabb;
-  const auto is_new_aabb_overlapping
-      = scene_limit.overlap(new_aabb, new_overlap_aabb);
-  if(is_new_aabb_overlapping)
-    hash_table->insert(new_overlap_aabb, updated_obj);
-
-  ObjectStatus old_status;
-  if(is_old_aabb_overlapping)
-  {
-    if(scene_limit.contain(old_aabb))
-      old_status = Inside;
-    else
-      old_status = PartiallyPenetrating;
-  }
-  else
-  {
-    old_status = Outside;
-  }
-
-  if(is_new_aabb_overlapping)
-  {
-    if(scene_limit.contain(new_aabb))
-    {
-      if (old_status == PartiallyPenetrating)
-      {
-        // Status change: PartiallyPenetrating --> Inside
-        // Required action(s):
-        // - remove object from "objs_partially_penetrating_scene_limit"
-
-        auto find_it = std::find(objs_partially_penetrating_scene_limit.begin(),
-                                 objs_partially_penetrating_scene_limit.end(),
-                                 updated_obj);
-        objs_partially_penetrating_scene_limit.erase(find_it);
-      }
-      else if (old_status == Outside)
-      {
-        // Status change: Outside --> Inside
-        // Required action(s):
-        // - remove object from "objs_outside_scene_limit"
-
-        auto find_it = std::find(objs_outside_scene_limit.begin(),
-                                 objs_outside_scene_limit.end(),
-                                 updated_obj);
-        objs_outside_scene_limit.erase(find_it);
-      }
-    }
-    else
-    {
-      if (old_status == Inside)
-      {
-        // Status change: Inside --> PartiallyPenetrating
-        // Required action(s):
-        // - add object to "objs_partially_penetrating_scene_limit"
-
-        objs_partially_penetrating_scene_limit.push_back(updated_obj);
-      }
-      else if (old_status == Outside)
-      {
-        // Status change: Outside --> PartiallyPenetrating
-        // Required action(s):
-        // - remove object from "objs_outside_scene_limit"
-        // - add object to "objs_partially_penetrating_scene_limit"
-
-        auto find_it = std::find(objs_outside_scene_limit.begin(),
-                                 objs_outside_scene_limit.end(),
-                                 updated_obj);
-        objs_outside_scene_limit.erase(find_it);
-
-        objs_partially_penetrating_scene_limit.push_back(updated_obj);
-      }
-    }
-  }
-  else
-  {
-    if (old_status == Inside)
-    {
-      // Status change: Inside --> Outside
-      // Required action(s):
-      // - add object to "objs_outside_scene_limit"
-
-      objs_outside_scene_limit.push_back(updated_obj);
-    }
-    else if (old_status == PartiallyPenetrating)
-    {
-      // Status change: PartiallyPenetrating --> Outside
-      // Required action(s):
-      // - remove object from "objs_partially_penetrating_scene_limit"
-      // - add object to "objs_outside_scene_limit"
-
-      auto find_it = std::find(objs_partially_penetrating_scene_limit.begin(),
-                               objs_partially_penetrating_scene_limit.end(),
-                               updated_obj);
-      objs_partially_penetrating_scene_limit.erase(find_it);
-
-      objs_outside_scene_limit.push_back(updated_obj);
-    }
-  }
+  auto it = obj_index_map.find(updated_obj);
+  if(it == obj_index_map.end())
+    return;
 
-  obj_aabb_map[updated_obj] = new_aabb;
+  ObjectInfo& info = obj_infos[it->second];
+  removeObject(updated_obj, info);
+  insertObject(updated_obj, info);
 }
 
 //==============================================================================
@@ -283,17 +158,18 @@ template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::clear()
 {
   objs.clear();
+  obj_infos.clear();
+  obj_index_map.clear();
   hash_table->clear();
+  objs_partially_penetrating_scene_limit.clear();
   objs_outside_scene_limit.clear();
-  obj_aabb_map.clear();
 }
 
 //==============================================================================
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::getObjects(std::vector<CollisionObject<S>*>& objs_) const
 {
-  objs_.resize(objs.size());
-  std::copy(objs.begin(), objs.end(), objs_.begin());
+  objs_ = objs;
 }
 
 //==============================================================================
@@ -317,14 +193,24 @@ void SpatialHashingCollisionManager<S, HashTable>::distance(CollisionObject<S>*
 template<typename S, typename HashTable>
 bool SpatialHashingCollisionManager<S, HashTable>::collide_(
     CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  std::vector<CollisionObject<S>*> candidates;
+  return collide_(obj, cdata, callback, candidates);
+}
+
+//==============================================================================
+template<typename S, typename HashTable>
+bool SpatialHashingCollisionManager<S, HashTable>::collide_(
+    CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback,
+    std::vector<CollisionObject<S>*>& candidates) const
 {
   const auto& obj_aabb = obj->getAABB();
   AABB<S> overlap_aabb;
 
   if(scene_limit.overlap(obj_aabb, overlap_aabb))
   {
-    const auto query_result = hash_table->query(overlap_aabb);
-    for(const auto& obj2 : query_result)
+    hash_table->query(overlap_aabb, candidates);
+    for(const auto& obj2 : candidates)
     {
       if(obj == obj2)
         continue;
@@ -373,6 +259,16 @@ bool SpatialHashingCollisionManager<S, HashTable>::collide_(
 template<typename S, typename HashTable>
 bool SpatialHashingCollisionManager<S, HashTable>::distance_(
     CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const
+{
+  std::vector<CollisionObject<S>*> candidates;
+  return distance_(obj, cdata, callback, min_dist, candidates);
+}
+
+//==============================================================================
+template<typename S, typename HashTable>
+bool SpatialHashingCollisionManager<S, HashTable>::distance_(
+    CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist,
+    std::vector<CollisionObject<S>*>& candidates) const
 {
   auto delta = (obj->getAABB().max_ - obj->getAABB().min_) * 0.5;
   auto aabb = obj->getAABB();
@@ -393,8 +289,9 @@ bool SpatialHashingCollisionManager<S, HashTable>::distance_(
 
     if(scene_limit.overlap(aabb, overlap_aabb))
     {
+      hash_table->query(overlap_aabb, candidates);
       if (distanceObjectToObjects(
-            obj, hash_table->query(overlap_aabb), cdata, callback, min_dist))
+            obj, candidates, cdata, callback, min_dist))
       {
         return true;
       }
@@ -463,6 +360,8 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
   if(size() == 0)
     return;
 
+  std::vector<CollisionObject<S>*> candidates;
+
   for(const auto& obj1 : objs)
   {
     const auto& obj_aabb = obj1->getAABB();
@@ -470,8 +369,8 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
 
     if(scene_limit.overlap(obj_aabb, overlap_aabb))
     {
-      auto query_result = hash_table->query(overlap_aabb);
-      for(const auto& obj2 : query_result)
+      hash_table->query(overlap_aabb, candidates);
+      for(const auto& obj2 : candidates)
       {
         if(obj1 < obj2)
         {
@@ -527,10 +426,11 @@ void SpatialHashingCollisionManager<S, HashTable>::distance(
   this->tested_set.clear();
 
   S min_dist = std::numeric_limits<S>::max();
+  std::vector<CollisionObject<S>*> candidates;
 
   for(const auto& obj : objs)
   {
-    if(distance_(obj, cdata, callback, min_dist))
+    if(distance_(obj, cdata, callback, min_dist, candidates))
       break;
   }
 
@@ -553,11 +453,13 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(BroadPhaseCollisionMa
     return;
   }
 
+  std::vector<CollisionObject<S>*> candidates;
+
   if(this->size() < other_manager->size())
   {
     for(const auto& obj : objs)
     {
-      if(other_manager->collide_(obj, cdata, callback))
+      if(other_manager->collide_(obj, cdata, callback, candidates))
         return;
     }
   }
@@ -565,7 +467,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(BroadPhaseCollisionMa
   {
     for(const auto& obj : other_manager->objs)
     {
-      if(collide_(obj, cdata, callback))
+      if(collide_(obj, cdata, callback, candidates))
         return;
     }
   }
@@ -587,16 +489,17 @@ void SpatialHashingCollisionManager<S, HashTable>::distance(BroadPhaseCollisionM
   }
 
   S min_dist = std::numeric_limits<S>::max();
+  std::vector<CollisionObject<S>*> candidates;
 
   if(this->size() < other_manager->size())
   {
     for(const auto& obj : objs)
-      if(other_manager->distance_(obj, cdata, callback, min_dist)) return;
+      if(other_manager->distance_(obj, cdata, callback, min_dist, candidates)) return;
   }
   else
   {
     for(const auto& obj : other_manager->objs)
-      if(distance_(obj, cdata, callback, min_dist)) return;
+      if(distance_(obj, cdata, callback, min_dist, candidates)) return;
   }
 }
 
@@ -627,6 +530,78 @@ void SpatialHashingCollisionManager<S, HashTable>::computeBound(
   u = bound.max_;
 }
 
+//==============================================================================
+template<typename S, typename HashTable>
+typename SpatialHashingCollisionManager<S, HashTable>::ObjectStatus
+SpatialHashingCollisionManager<S, HashTable>::computeStatus(
+    const AABB<S>& aabb, AABB<S>& overlap_aabb) const
+{
+  if(!scene_limit.overlap(aabb, overlap_aabb))
+    return Outside;
+
+  if(scene_limit.contain(aabb))
+    return Inside;
+
+  return PartiallyPenetrating;
+}
+
+//==============================================================================
+template<typename S, typename HashTable>
+void SpatialHashingCollisionManager<S, HashTable>::insertObject(
+    CollisionObject<S>* obj, ObjectInfo& info)
+{
+  info.aabb = obj->getAABB();
+
+  AABB<S> overlap_aabb;
+  info.status = computeStatus(info.aabb, overlap_aabb);
+
+  if(info.status != Outside)
+    hash_table->insert(overlap_aabb, obj);
+
+  auto list = statusList(info.status);
+  if(list)
+  {
+    info.status_index = list->size();
+    list->push_back(obj);
+  }
+}
+
+//==============================================================================
+template<typename S, typename HashTable>
+void SpatialHashingCollisionManager<S, HashTable>::removeObject(
+    CollisionObject<S>* obj, ObjectInfo& info)
+{
+  AABB<S> overlap_aabb;
+  if(computeStatus(info.aabb, overlap_aabb) != Outside)
+    hash_table->remove(overlap_aabb, obj);
+
+  auto list = statusList(info.status);
+  if(list)
+  {
+    // Move the last object of the list into the freed slot
+    CollisionObject<S>* last = list->back();
+    (*list)[info.status_index] = last;
+    obj_infos[obj_index_map[last]].status_index = info.status_index;
+    list->pop_back();
+  }
+}
+
+//==============================================================================
+template<typename S, typename HashTable>
+std::vector<CollisionObject<S>*>*
+SpatialHashingCollisionManager<S, HashTable>::statusList(ObjectStatus status)
+{
+  switch(status)
+  {
+  case PartiallyPenetrating:
+    return &objs_partially_penetrating_scene_limit;
+  case Outside:
+    return &objs_outside_scene_limit;
+  default:
+    return nullptr;
+  }
+}
+
 //==============================================================================
 template<typename S, typename HashTable>
 template<typename Container>
@@ -38,10 +38,11 @@
 #ifndef FCL_BROADPHASE_BROADPAHSESPATIALHASH_H
 #define FCL_BROADPHASE_BROADPAHSESPATIALHASH_H
 
-#include <list>
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include "fcl/math/bv/AABB.h"
 #include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/flat_hash_table.h"
 #include "fcl/broadphase/detail/simple_hash_table.h"
 #include "fcl/broadphase/detail/sparse_hash_table.h"
 #include "fcl/broadphase/detail/spatial_hash.h"
@@ -52,7 +53,7 @@ namespace fcl
 /// @brief spatial hashing collision mananger
 template<typename S,
          typename HashTable
-             = detail::SimpleHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >
+             = detail::FlatHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >
 class SpatialHashingCollisionManager : public BroadPhaseCollisionManager<S>
 {
 public:
@@ -117,39 +118,80 @@ public:
 
 protected:
 
+  enum ObjectStatus
+  {
+    Inside,
+    PartiallyPenetrating,
+    Outside
+  };
+
+  /// @brief per-object data, stored at the same index as the object in objs
+  struct ObjectInfo
+  {
+    /// @brief the AABB of the object when it was last hashed
+    AABB<S> aabb;
+
+    /// @brief where the object is with respect to the scene limit
+    ObjectStatus status;
+
+    /// @brief index of the object in the list given by status (unused for
+    /// Inside)
+    std::size_t status_index;
+  };
+
   /// @brief perform collision test between one object and all the objects belonging to the manager
   bool collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
 
+  /// @brief collide_() using candidates as scratch storage for the hash table
+  /// query
+  bool collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback,
+                std::vector<CollisionObject<S>*>& candidates) const;
+
   /// @brief perform distance computation between one object and all the objects belonging ot the manager
   bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
 
+  /// @brief distance_() using candidates as scratch storage for the hash table
+  /// query
+  bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist,
+                 std::vector<CollisionObject<S>*>& candidates) const;
+
   /// @brief all objects in the scene
-  std::list<CollisionObject<S>*> objs;
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief data of the objects in the scene, in the same order as objs
+  std::vector<ObjectInfo> obj_infos;
+
+  /// @brief index of each object in objs, making removal O(1)
+  std::unordered_map<CollisionObject<S>*, std::size_t> obj_index_map;
 
   /// @brief objects partially penetrating (not totally inside nor outside) the
   /// scene limit are in another list
-  std::list<CollisionObject<S>*> objs_partially_penetrating_scene_limit;
+  std::vector<CollisionObject<S>*> objs_partially_penetrating_scene_limit;
 
   /// @brief objects outside the scene limit are in another list
-  std::list<CollisionObject<S>*> objs_outside_scene_limit;
+  std::vector<CollisionObject<S>*> objs_outside_scene_limit;
 
   /// @brief the size of the scene
   AABB<S> scene_limit;
 
-  /// @brief store the map between objects and their aabbs. will make update more convenient
-  std::map<CollisionObject<S>*, AABB<S>> obj_aabb_map;
-
   /// @brief objects in the scene limit (given by scene_min and scene_max) are in the spatial hash table
   HashTable* hash_table;
 
 private:
 
-  enum ObjectStatus
-  {
-    Inside,
-    PartiallyPenetrating,
-    Outside
-  };
+  /// @brief compute the status of an AABB and its overlap with the scene limit
+  ObjectStatus computeStatus(const AABB<S>& aabb, AABB<S>& overlap_aabb) const;
+
+  /// @brief hash the object with its current AABB and add it to the list of
+  /// its status
+  void insertObject(CollisionObject<S>* obj, ObjectInfo& info);
+
+  /// @brief remove the object with the AABB it was hashed with from the hash
+  /// table and the list of its status
+  void removeObject(CollisionObject<S>* obj, ObjectInfo& info);
+
+  /// @brief the list holding the objects of the given status
+  std::vector<CollisionObject<S>*>* statusList(ObjectStatus status);
 
   template <typename Container>
   bool distanceObjectToObjects(
@@ -161,10 +203,10 @@ private:
 
 };
 
-template<typename HashTable = detail::SimpleHashTable<AABB<float>, CollisionObject<float>*, detail::SpatialHash<float>>>
+template<typename HashTable = detail::FlatHashTable<AABB<float>, CollisionObject<float>*, detail::SpatialHash<float>>>
 using SpatialHashingCollisionManagerf = SpatialHashingCollisionManager<float, HashTable>;
 
-template<typename HashTable = detail::SimpleHashTable<AABB<double>, CollisionObject<double>*, detail::SpatialHash<double>>>
+template<typename HashTable = detail::FlatHashTable<AABB<double>, CollisionObject<double>*, detail::SpatialHash<double>>>
 using SpatialHashingCollisionManagerd = SpatialHashingCollisionManager<double, HashTable>;
 
 } // namespace fcl
@@ -0,0 +1,316 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_FLATHASHTABLE_INL_H
+#define FCL_BROADPHASE_FLATHASHTABLE_INL_H
+
+#include "fcl/broadphase/detail/flat_hash_table.h"
+
+#include <algorithm>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell::Cell()
+  : index(0), occupied(false), size(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+const Data& FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell::at(
+    std::size_t i) const
+{
+  return (i < InlineCapacity) ? data[i] : overflow[i - InlineCapacity];
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+Data& FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell::at(std::size_t i)
+{
+  return (i < InlineCapacity) ? data[i] : overflow[i - InlineCapacity];
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell::push(
+    const Data& value)
+{
+  if(size < InlineCapacity)
+    data[size] = value;
+  else
+    overflow.push_back(value);
+  ++size;
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell::remove(
+    const Data& value)
+{
+  std::size_t i = 0;
+  while(i < size)
+  {
+    if(at(i) == value)
+    {
+      at(i) = at(size - 1);
+      --size;
+      if(size >= InlineCapacity)
+        overflow.pop_back();
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+FlatHashTable<Key, Data, HashFnc, InlineCapacity>::FlatHashTable(const HashFnc& h)
+  : h_(h), num_occupied_(0), shift_(64)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::init(size_t size)
+{
+  size_t num_slots = 16;
+  while(num_slots < 2 * size)
+    num_slots *= 2;
+
+  cells_.clear();
+  rehash(num_slots);
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::insert(Key key, Data value)
+{
+  h_.visit(key, [&](unsigned int index)
+  {
+    findOrCreateCell(index).push(value);
+  });
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+std::vector<Data> FlatHashTable<Key, Data, HashFnc, InlineCapacity>::query(
+    Key key) const
+{
+  std::vector<Data> result;
+  query(key, result);
+  return result;
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::query(
+    Key key, std::vector<Data>& result) const
+{
+  result.clear();
+  visit(key, [&result](const Data& value) { result.push_back(value); });
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+template <typename Visitor>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::visit(
+    Key key, Visitor visitor) const
+{
+  h_.visit(key, [&](unsigned int index)
+  {
+    const Cell* cell = findCell(index);
+    if(!cell)
+      return;
+
+    for(std::size_t i = 0; i < cell->size; ++i)
+      visitor(cell->at(i));
+  });
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::remove(Key key, Data value)
+{
+  h_.visit(key, [&](unsigned int index)
+  {
+    Cell* cell = const_cast<Cell*>(findCell(index));
+    if(cell)
+      cell->remove(value);
+  });
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::clear()
+{
+  for(auto& cell : cells_)
+  {
+    if(cell.occupied)
+    {
+      cell.occupied = false;
+      cell.size = 0;
+      cell.overflow.clear();
+    }
+  }
+
+  num_occupied_ = 0;
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+size_t FlatHashTable<Key, Data, HashFnc, InlineCapacity>::numCells() const
+{
+  size_t num_cells = 0;
+  for(const auto& cell : cells_)
+  {
+    if(cell.occupied && cell.size > 0)
+      ++num_cells;
+  }
+
+  return num_cells;
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+std::size_t FlatHashTable<Key, Data, HashFnc, InlineCapacity>::slot(
+    unsigned int index) const
+{
+  // Fibonacci hashing: cell indices of neighboring cells are consecutive
+  // integers, which this spreads over the whole table.
+  return static_cast<std::size_t>(
+        (static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ull) >> shift_);
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+const typename FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell*
+FlatHashTable<Key, Data, HashFnc, InlineCapacity>::findCell(
+    unsigned int index) const
+{
+  if(cells_.empty())
+    return nullptr;
+
+  const std::size_t mask = cells_.size() - 1;
+  for(std::size_t i = slot(index); ; i = (i + 1) & mask)
+  {
+    const Cell& cell = cells_[i];
+    if(!cell.occupied)
+      return nullptr;
+    if(cell.index == index)
+      return &cell;
+  }
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+typename FlatHashTable<Key, Data, HashFnc, InlineCapacity>::Cell&
+FlatHashTable<Key, Data, HashFnc, InlineCapacity>::findOrCreateCell(
+    unsigned int index)
+{
+  if(cells_.empty())
+    rehash(16);
+
+  const std::size_t mask = cells_.size() - 1;
+  std::size_t i = slot(index);
+  for(; cells_[i].occupied; i = (i + 1) & mask)
+  {
+    if(cells_[i].index == index)
+      return cells_[i];
+  }
+
+  // Keep the load factor at most 1/2. Slots whose cell has become empty are
+  // only reclaimed here, so grow only if the live cells need the room.
+  if(2 * (num_occupied_ + 1) > cells_.size())
+  {
+    const size_t num_cells = numCells();
+    size_t num_slots = cells_.size();
+    while(4 * (num_cells + 1) > num_slots)
+      num_slots *= 2;
+
+    rehash(num_slots);
+    return findOrCreateCell(index);
+  }
+
+  Cell& cell = cells_[i];
+  cell.index = index;
+  cell.occupied = true;
+  ++num_occupied_;
+
+  return cell;
+}
+
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc, std::size_t InlineCapacity>
+void FlatHashTable<Key, Data, HashFnc, InlineCapacity>::rehash(size_t num_slots)
+{
+  std::vector<Cell> old_cells(num_slots);
+  old_cells.swap(cells_);
+
+  shift_ = 64;
+  for(size_t n = num_slots; n > 1; n >>= 1)
+    --shift_;
+  num_occupied_ = 0;
+
+  const std::size_t mask = cells_.size() - 1;
+  for(auto& old_cell : old_cells)
+  {
+    if(!old_cell.occupied || old_cell.size == 0)
+      continue;
+
+    std::size_t i = slot(old_cell.index);
+    while(cells_[i].occupied)
+      i = (i + 1) & mask;
+
+    cells_[i] = std::move(old_cell);
+    ++num_occupied_;
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
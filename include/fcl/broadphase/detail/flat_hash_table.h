@@ -0,0 +1,144 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_FLATHASHTABLE_H
+#define FCL_BROADPHASE_FLATHASHTABLE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief A hash table storing its cells contiguously with open addressing
+/// (linear probing). Each cell keeps its first InlineCapacity elements inline
+/// and only spills to the heap beyond that, and clear() keeps the storage, so
+/// a table that is cleared and refilled every frame stops allocating after
+/// the first frames. HashFnc must provide visit(key, visitor), calling
+/// visitor(index) for each cell index of the key (see SpatialHash).
+template <typename Key, typename Data, typename HashFnc,
+          std::size_t InlineCapacity = 4>
+class FlatHashTable
+{
+public:
+  FlatHashTable(const HashFnc& h);
+
+  /// @brief Init the table with room for size cells before it rehashes
+  void init(size_t size);
+
+  /// @brief insert one key-value pair into the hash table
+  void insert(Key key, Data value);
+
+  /// @brief find the elements whose key is the same as the query
+  std::vector<Data> query(Key key) const;
+
+  /// @brief find the elements whose key is the same as the query, sorted and
+  /// without duplicates. result is overwritten; reusing it across queries
+  /// avoids allocation.
+  void query(Key key, std::vector<Data>& result) const;
+
+  /// @brief Call visitor(value) for each value stored in the cells of the
+  /// key. A value stored in several of these cells is visited once per cell.
+  template <typename Visitor>
+  void visit(Key key, Visitor visitor) const;
+
+  /// @brief remove one key-value pair from the hash table
+  void remove(Key key, Data value);
+
+  /// @brief clear the hash table, keeping its storage
+  void clear();
+
+  /// @brief the number of non-empty cells
+  size_t numCells() const;
+
+protected:
+  struct Cell
+  {
+    /// @brief the cell index given by the hash function
+    unsigned int index;
+
+    /// @brief whether the slot holds a cell
+    bool occupied;
+
+    /// @brief number of elements in the cell
+    std::uint32_t size;
+
+    /// @brief the first InlineCapacity elements
+    Data data[InlineCapacity];
+
+    /// @brief the elements beyond InlineCapacity
+    std::vector<Data> overflow;
+
+    Cell();
+
+    const Data& at(std::size_t i) const;
+
+    Data& at(std::size_t i);
+
+    void push(const Data& value);
+
+    void remove(const Data& value);
+  };
+
+  HashFnc h_;
+
+  /// @brief the slots, the number of which is a power of two
+  std::vector<Cell> cells_;
+
+  /// @brief number of occupied slots, including those whose cell is empty
+  size_t num_occupied_;
+
+  /// @brief right shift applied to the multiplicative hash of a cell index
+  unsigned int shift_;
+
+  std::size_t slot(unsigned int index) const;
+
+  const Cell* findCell(unsigned int index) const;
+
+  Cell& findOrCreateCell(unsigned int index);
+
+  /// @brief Rebuild the table with the given number of slots, dropping the
+  /// empty cells
+  void rehash(size_t num_slots);
+};
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/flat_hash_table-inl.h"
+
+#endif
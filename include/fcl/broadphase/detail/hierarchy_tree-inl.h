@@ -84,6 +84,9 @@ void HierarchyTree<BV>::init(std::vector<NodeType*>& leaves, int level)
   case 3:
     init_3(leaves);
     break;
+  case 4:
+    init_4(leaves);
+    break;
   default:
     init_0(leaves);
   }
@@ -160,7 +163,7 @@ template <typename S, typename BV>
 struct UpdateImpl
 {
   static bool run(
-      const HierarchyTree<BV>& tree,
+      HierarchyTree<BV>& tree,
       typename HierarchyTree<BV>::NodeType* leaf,
       const BV& bv,
       const Vector3<S>& /*vel*/,
@@ -172,7 +175,7 @@ struct UpdateImpl
   }
 
   static bool run(
-      const HierarchyTree<BV>& tree,
+      HierarchyTree<BV>& tree,
       typename HierarchyTree<BV>::NodeType* leaf,
       const BV& bv,
       const Vector3<S>& /*vel*/)
@@ -183,6 +186,47 @@ struct UpdateImpl
   }
 };
 
+//==============================================================================
+template <typename S>
+struct UpdateImpl<S, AABB<S>>
+{
+  static bool run(
+      HierarchyTree<AABB<S>>& tree,
+      typename HierarchyTree<AABB<S>>::NodeType* leaf,
+      const AABB<S>& bv,
+      const Vector3<S>& vel,
+      S margin)
+  {
+    if(leaf->bv.contain(bv)) return false;
+
+    AABB<S> fat_bv(bv);
+    fat_bv.min_.array() -= margin;
+    fat_bv.max_.array() += margin;
+    return run(tree, leaf, fat_bv, vel);
+  }
+
+  static bool run(
+      HierarchyTree<AABB<S>>& tree,
+      typename HierarchyTree<AABB<S>>::NodeType* leaf,
+      const AABB<S>& bv,
+      const Vector3<S>& vel)
+  {
+    if(leaf->bv.contain(bv)) return false;
+
+    // extend the bounding volume in the direction of the motion
+    AABB<S> fat_bv(bv);
+    for(int i = 0; i < 3; ++i)
+    {
+      if(vel[i] > 0)
+        fat_bv.max_[i] += vel[i];
+      else
+        fat_bv.min_[i] += vel[i];
+    }
+    tree.update_(leaf, fat_bv);
+    return true;
+  }
+};
+
 //==============================================================================
 template<typename BV>
 bool HierarchyTree<BV>::update(NodeType* leaf, const BV& bv, const Vector3<S>& vel, S margin)
@@ -605,6 +649,99 @@ void HierarchyTree<BV>::init_3(std::vector<NodeType*>& leaves)
   opath = 0;
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::init_4(std::vector<NodeType*>& leaves)
+{
+  clear();
+
+  const size_t n = leaves.size();
+  n_leaves = n;
+  max_lookahead_level = -1;
+  opath = 0;
+
+  if(n == 0)
+    return;
+
+  if(n == 1)
+  {
+    root_node = leaves[0];
+    root_node->parent = nullptr;
+    return;
+  }
+
+  const unsigned int num_threads = lbvhNumThreads(n, 0);
+
+  std::vector<BV> bounds(num_threads);
+  parallelForChunks(n, num_threads, [&](size_t begin, size_t end, unsigned int thread_id)
+  {
+    BV bv = leaves[begin]->bv;
+    for(size_t i = begin + 1; i < end; ++i)
+      bv += leaves[i]->bv;
+    bounds[thread_id] = bv;
+  });
+
+  BV bound_bv = bounds[0];
+  for(size_t i = 1; i < bounds.size(); ++i)
+    bound_bv += bounds[i];
+
+  morton_functor<typename BV::S, uint32> coder(bound_bv);
+  std::vector<uint32> codes(n);
+  std::vector<size_t> ids(n);
+  parallelForChunks(n, num_threads, [&](size_t begin, size_t end, unsigned int)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      leaves[i]->code = coder(leaves[i]->bv.center());
+      codes[i] = leaves[i]->code;
+      ids[i] = i;
+    }
+  });
+
+  radixSortMorton(codes, ids, num_threads);
+
+  std::vector<size_t> children;
+  std::vector<size_t> parents;
+  emitLBVHHierarchy(codes, children, parents, num_threads);
+
+  std::vector<NodeType*> internal_nodes(n - 1);
+  parallelForChunks(n - 1, num_threads, [&](size_t begin, size_t end, unsigned int)
+  {
+    for(size_t i = begin; i < end; ++i)
+      internal_nodes[i] = new NodeType();
+  });
+
+  parallelForChunks(n - 1, num_threads, [&](size_t begin, size_t end, unsigned int)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      NodeType* node = internal_nodes[i];
+      node->parent = (i == 0) ? nullptr : internal_nodes[parents[i]];
+      for(int k = 0; k < 2; ++k)
+      {
+        const size_t child = children[2 * i + k];
+        if(child < n - 1)
+        {
+          node->children[k] = internal_nodes[child];
+        }
+        else
+        {
+          node->children[k] = leaves[ids[child - (n - 1)]];
+          node->children[k]->parent = node;
+        }
+      }
+    }
+  });
+
+  fitLBVHBottomup(parents, n, num_threads, [&](size_t i)
+  {
+    NodeType* node = internal_nodes[i];
+    node->bv = node->children[0]->bv + node->children[1]->bv;
+  });
+
+  root_node = internal_nodes[0];
+}
+
 //==============================================================================
 template<typename BV>
 typename HierarchyTree<BV>::NodeType* HierarchyTree<BV>::mortonRecurse_0(const NodeVecIterator lbeg, const NodeVecIterator lend, const uint32& split, int bits)
@@ -45,6 +45,7 @@
 #include "fcl/common/warning.h"
 #include "fcl/math/bv/AABB.h"
 #include "fcl/broadphase/detail/morton.h"
+#include "fcl/broadphase/detail/lbvh.h"
 #include "fcl/broadphase/detail/node_base.h"
 
 namespace fcl
@@ -72,6 +73,8 @@ public:
   ~HierarchyTree();
   
   /// @brief Initialize the tree by a set of leaves using algorithm with a given level.
+  /// Levels 0 to 3 are serial; level 4 builds a linear BVH using all the
+  /// hardware threads.
   void init(std::vector<NodeType*>& leaves, int level = 0);
 
   /// @brief Insest a node
@@ -132,6 +135,9 @@ public:
 
 private:
 
+  template <typename, typename>
+  friend struct UpdateImpl;
+
   typedef typename std::vector<NodeBase<BV>* >::iterator NodeVecIterator;
   typedef typename std::vector<NodeBase<BV>* >::const_iterator NodeVecConstIterator;
 
@@ -179,6 +185,10 @@ private:
 
   /// @brief init tree from leaves using morton code. It uses morton_2, i.e., for all nodes, we simply divide the leaves into parts with the same size simply using the node index.
   void init_3(std::vector<NodeType*>& leaves);
+
+  /// @brief init tree from leaves as a linear BVH: the morton codes are computed and radix sorted in parallel,
+  /// then every internal node is emitted independently from the sorted codes and the bounding volumes are fitted bottom-up in parallel.
+  void init_4(std::vector<NodeType*>& leaves);
   
   NodeType* mortonRecurse_0(const NodeVecIterator lbeg, const NodeVecIterator lend, const uint32& split, int bits);
 
@@ -95,6 +95,9 @@ void HierarchyTree<BV>::init(NodeType* leaves, int n_leaves_, int level)
   case 3:
     init_3(leaves, n_leaves_);
     break;
+  case 4:
+    init_4(leaves, n_leaves_);
+    break;
   default:
     init_0(leaves, n_leaves_);
   }
@@ -713,6 +716,101 @@ size_t HierarchyTree<BV>::topdown_1(size_t* lbeg, size_t* lend)
   return *lbeg;
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::init_4(NodeType* leaves, int n_leaves_)
+{
+  clear();
+
+  if(n_leaves_ <= 0)
+    return;
+
+  const size_t n = n_leaves_;
+  n_leaves = n;
+  root_node = NULL_NODE;
+  delete [] nodes;
+  nodes = new NodeType[n_leaves * 2];
+  std::copy(leaves, leaves + n_leaves, nodes);
+  n_nodes = 2 * n_leaves - 1;
+  n_nodes_alloc = 2 * n_leaves;
+  freelist = n_nodes;
+  nodes[n_nodes_alloc - 1].next = NULL_NODE;
+  opath = 0;
+  max_lookahead_level = -1;
+
+  if(n == 1)
+  {
+    nodes[0].parent = NULL_NODE;
+    root_node = 0;
+    return;
+  }
+
+  const unsigned int num_threads = lbvhNumThreads(n, 0);
+
+  std::vector<BV> bounds(num_threads);
+  parallelForChunks(n, num_threads, [&](size_t begin, size_t end, unsigned int thread_id)
+  {
+    BV bv = nodes[begin].bv;
+    for(size_t i = begin + 1; i < end; ++i)
+      bv += nodes[i].bv;
+    bounds[thread_id] = bv;
+  });
+
+  BV bound_bv = bounds[0];
+  for(size_t i = 1; i < bounds.size(); ++i)
+    bound_bv += bounds[i];
+
+  morton_functor<typename BV::S, uint32> coder(bound_bv);
+  std::vector<uint32> codes(n);
+  std::vector<size_t> ids(n);
+  parallelForChunks(n, num_threads, [&](size_t begin, size_t end, unsigned int)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      nodes[i].code = coder(nodes[i].bv.center());
+      codes[i] = nodes[i].code;
+      ids[i] = i;
+    }
+  });
+
+  radixSortMorton(codes, ids, num_threads);
+
+  std::vector<size_t> children;
+  std::vector<size_t> parents;
+  emitLBVHHierarchy(codes, children, parents, num_threads);
+
+  // The internal node i is stored after the leaves, at n + i
+  parallelForChunks(n - 1, num_threads, [&](size_t begin, size_t end, unsigned int)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      NodeType* node = nodes + n + i;
+      node->parent = (i == 0) ? NULL_NODE : n + parents[i];
+      for(int k = 0; k < 2; ++k)
+      {
+        const size_t child = children[2 * i + k];
+        if(child < n - 1)
+        {
+          node->children[k] = n + child;
+        }
+        else
+        {
+          node->children[k] = ids[child - (n - 1)];
+          nodes[node->children[k]].parent = n + i;
+        }
+      }
+    }
+  });
+
+  fitLBVHBottomup(parents, n, num_threads, [&](size_t i)
+  {
+    NodeType* node = nodes + n + i;
+    node->bv = nodes[node->children[0]].bv + nodes[node->children[1]].bv;
+  });
+
+  root_node = n;
+}
+
 //==============================================================================
 template<typename BV>
 size_t HierarchyTree<BV>::mortonRecurse_0(size_t* lbeg, size_t* lend, const uint32& split, int bits)
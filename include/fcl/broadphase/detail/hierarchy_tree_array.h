@@ -38,6 +38,7 @@
 #ifndef FCL_HIERARCHY_TREE_ARRAY_H
 #define FCL_HIERARCHY_TREE_ARRAY_H
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <functional>
@@ -45,6 +46,7 @@
 #include "fcl/common/warning.h"
 #include "fcl/math/bv/AABB.h"
 #include "fcl/broadphase/detail/morton.h"
+#include "fcl/broadphase/detail/lbvh.h"
 #include "fcl/broadphase/detail/node_base_array.h"
 
 namespace fcl
@@ -91,6 +93,8 @@ public:
   ~HierarchyTree();
 
   /// @brief Initialize the tree by a set of leaves using algorithm with a given level.
+  /// Levels 0 to 3 are serial; level 4 builds a linear BVH using all the
+  /// hardware threads.
   void init(NodeType* leaves, int n_leaves_, int level = 0);
 
   /// @brief Initialize the tree by a set of leaves using algorithm with a given level.
@@ -189,6 +193,10 @@ private:
   /// @brief init tree from leaves using morton code. It uses morton_2, i.e., for all nodes, we simply divide the leaves into parts with the same size simply using the node index.
   void init_3(NodeType* leaves, int n_leaves_);
 
+  /// @brief init tree from leaves as a linear BVH: the morton codes are computed and radix sorted in parallel,
+  /// then every internal node is emitted independently from the sorted codes and the bounding volumes are fitted bottom-up in parallel.
+  void init_4(NodeType* leaves, int n_leaves_);
+
   size_t mortonRecurse_0(size_t* lbeg, size_t* lend, const uint32& split, int bits);
 
   size_t mortonRecurse_1(size_t* lbeg, size_t* lend, const uint32& split, int bits);
@@ -0,0 +1,90 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_LBVH_INL_H
+#define FCL_BROADPHASE_DETAIL_LBVH_INL_H
+
+#include "fcl/broadphase/detail/lbvh.h"
+
+#include <atomic>
+
+#include "fcl/common/detail/parallel.h"
+
+namespace fcl
+{
+
+/// @cond IGNORE
+namespace detail
+{
+
+//==============================================================================
+template <typename Fit>
+void fitLBVHBottomup(
+    const std::vector<std::size_t>& parents,
+    std::size_t n,
+    unsigned int num_threads,
+    Fit fit)
+{
+  if(n < 2) return;
+
+  const std::size_t root_parent = -1;
+  std::vector<std::atomic<unsigned char>> visits(n - 1);
+  for(auto& visit : visits)
+    visit.store(0, std::memory_order_relaxed);
+
+  parallelForChunks(n, lbvhNumThreads(n, num_threads),
+                    [&](std::size_t begin, std::size_t end, unsigned int)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      std::size_t node = parents[n - 1 + i];
+      while(node != root_parent)
+      {
+        // The first child to arrive stops; the second one sees the fitted
+        // sibling through the acquire-release ordering
+        if(visits[node].fetch_add(1, std::memory_order_acq_rel) == 0)
+          break;
+
+        fit(node);
+        node = parents[node];
+      }
+    }
+  });
+}
+
+} // namespace detail
+/// @endcond
+} // namespace fcl
+
+#endif
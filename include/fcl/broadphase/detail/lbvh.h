@@ -0,0 +1,95 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_LBVH_H
+#define FCL_BROADPHASE_DETAIL_LBVH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "fcl/common/types.h"
+
+namespace fcl
+{
+
+/// @cond IGNORE
+namespace detail
+{
+
+/// @brief Return the number of threads used by the linear BVH construction for
+/// n primitives; num_threads follows resolveNumThreads(), and small inputs use
+/// fewer threads so that each one has enough work.
+unsigned int lbvhNumThreads(std::size_t n, unsigned int num_threads);
+
+/// @brief Sort 30 bit morton codes with a stable least significant digit radix
+/// sort, each pass counting and scattering contiguous chunks in parallel.
+/// indices is permuted along with codes.
+void radixSortMorton(
+    std::vector<uint32>& codes,
+    std::vector<std::size_t>& indices,
+    unsigned int num_threads);
+
+/// @brief Emit the hierarchy of a linear BVH over n >= 2 sorted morton codes
+/// (Karras, "Maximizing Parallelism in the Construction of BVHs, Octrees, and
+/// k-d Trees", 2012), each internal node being computed independently in
+/// parallel. Equal codes are ordered by their position.
+///
+/// Nodes are numbered with the n - 1 internal nodes first, the root being 0,
+/// followed by the n leaves in sorted order. children[2 * i] and
+/// children[2 * i + 1] are the children of the internal node i, and parents[k]
+/// is the parent of node k (-1 for the root).
+void emitLBVHHierarchy(
+    const std::vector<uint32>& codes,
+    std::vector<std::size_t>& children,
+    std::vector<std::size_t>& parents,
+    unsigned int num_threads);
+
+/// @brief Call fit(i) for every internal node i of a hierarchy emitted by
+/// emitLBVHHierarchy(), after fit has been called on its internal children.
+/// Every leaf walks up in parallel and the second thread to reach a node fits
+/// it, so each node is fitted exactly once.
+template <typename Fit>
+void fitLBVHBottomup(
+    const std::vector<std::size_t>& parents,
+    std::size_t n,
+    unsigned int num_threads,
+    Fit fit);
+
+} // namespace detail
+/// @endcond
+} // namespace fcl
+
+#include "fcl/broadphase/detail/lbvh-inl.h"
+
+#endif
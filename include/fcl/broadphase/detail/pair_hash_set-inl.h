@@ -0,0 +1,173 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_PAIRHASHSET_INL_H
+#define FCL_BROADPHASE_PAIRHASHSET_INL_H
+
+#include "fcl/broadphase/detail/pair_hash_set.h"
+
+#include <utility>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename T>
+PairHashSet<T>::PairHashSet()
+  : generation_(1), size_(0), shift_(64)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+bool PairHashSet<T>::insert(T* a, T* b)
+{
+  if(b < a)
+    std::swap(a, b);
+
+  // Keep the load factor at most 1/2
+  if(2 * (size_ + 1) > slots_.size())
+    rehash(slots_.empty() ? 64 : 2 * slots_.size());
+
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t i = slot(a, b);
+  for(; slots_[i].generation == generation_; i = (i + 1) & mask)
+  {
+    if(slots_[i].first == a && slots_[i].second == b)
+      return false;
+  }
+
+  slots_[i].first = a;
+  slots_[i].second = b;
+  slots_[i].generation = generation_;
+  ++size_;
+
+  return true;
+}
+
+//==============================================================================
+template <typename T>
+bool PairHashSet<T>::contains(T* a, T* b) const
+{
+  if(size_ == 0)
+    return false;
+
+  if(b < a)
+    std::swap(a, b);
+
+  const std::size_t mask = slots_.size() - 1;
+  for(std::size_t i = slot(a, b); slots_[i].generation == generation_; i = (i + 1) & mask)
+  {
+    if(slots_[i].first == a && slots_[i].second == b)
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename T>
+void PairHashSet<T>::clear()
+{
+  size_ = 0;
+
+  // Slots stamped with an older generation are empty. When the counter wraps
+  // around, the old stamps have to be reset once.
+  if(++generation_ == 0)
+  {
+    for(auto& s : slots_)
+      s.generation = 0;
+    generation_ = 1;
+  }
+}
+
+//==============================================================================
+template <typename T>
+std::size_t PairHashSet<T>::size() const
+{
+  return size_;
+}
+
+//==============================================================================
+template <typename T>
+bool PairHashSet<T>::empty() const
+{
+  return size_ == 0;
+}
+
+//==============================================================================
+template <typename T>
+std::size_t PairHashSet<T>::slot(T* a, T* b) const
+{
+  // Fibonacci hashing of the combined addresses; the low bits of addresses
+  // are mostly zero, which the multiplication moves out of the way.
+  const std::uint64_t h =
+      static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(a)) * 0x9E3779B97F4A7C15ull
+      ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(b)) * 0xC2B2AE3D27D4EB4Full;
+  return static_cast<std::size_t>((h ^ (h >> 29)) * 0x9E3779B97F4A7C15ull >> shift_);
+}
+
+//==============================================================================
+template <typename T>
+void PairHashSet<T>::rehash(std::size_t num_slots)
+{
+  std::vector<Slot> old_slots(num_slots, Slot{nullptr, nullptr, 0});
+  old_slots.swap(slots_);
+
+  shift_ = 64;
+  for(std::size_t n = num_slots; n > 1; n >>= 1)
+    --shift_;
+
+  const std::size_t mask = slots_.size() - 1;
+  for(const auto& old_slot : old_slots)
+  {
+    if(old_slot.generation != generation_)
+      continue;
+
+    std::size_t i = slot(old_slot.first, old_slot.second);
+    while(slots_[i].generation == generation_)
+      i = (i + 1) & mask;
+
+    slots_[i] = old_slot;
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
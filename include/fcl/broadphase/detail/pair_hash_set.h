@@ -0,0 +1,108 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_PAIRHASHSET_H
+#define FCL_BROADPHASE_PAIRHASHSET_H
+
+#include <cstdint>
+#include <vector>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief A set of unordered pairs of pointers with open addressing (linear
+/// probing). Each slot is stamped with the generation in which it was filled,
+/// so clear() only starts a new generation instead of touching the slots, and
+/// a set that is cleared and refilled every query stops allocating once it
+/// has grown to the number of pairs of a query.
+template <typename T>
+class PairHashSet
+{
+public:
+  PairHashSet();
+
+  /// @brief insert the pair (a, b), the same as (b, a). Return whether the pair
+  /// was not in the set yet.
+  bool insert(T* a, T* b);
+
+  /// @brief whether the pair (a, b), the same as (b, a), is in the set
+  bool contains(T* a, T* b) const;
+
+  /// @brief remove all the pairs, keeping the storage
+  void clear();
+
+  /// @brief the number of pairs in the set
+  std::size_t size() const;
+
+  /// @brief whether the set is empty
+  bool empty() const;
+
+protected:
+  struct Slot
+  {
+    T* first;
+
+    T* second;
+
+    /// @brief the generation in which the slot was filled, 0 for never
+    std::uint32_t generation;
+  };
+
+  /// @brief the slots, the number of which is a power of two
+  std::vector<Slot> slots_;
+
+  /// @brief the current generation, the slots of older ones are empty
+  std::uint32_t generation_;
+
+  /// @brief number of pairs in the current generation
+  std::size_t size_;
+
+  /// @brief right shift applied to the multiplicative hash of a pair
+  unsigned int shift_;
+
+  std::size_t slot(T* a, T* b) const;
+
+  /// @brief Rebuild the table with the given number of slots
+  void rehash(std::size_t num_slots);
+};
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/pair_hash_set-inl.h"
+
+#endif
@@ -96,6 +96,15 @@ std::vector<Data> SimpleHashTable<Key, Data, HashFnc>::query(Key key) const
   return std::vector<Data>(result.begin(), result.end());
 }
 
+//==============================================================================
+template<typename Key, typename Data, typename HashFnc>
+void SimpleHashTable<Key, Data, HashFnc>::query(
+    Key key, std::vector<Data>& result) const
+{
+  std::vector<Data> values = query(key);
+  result.swap(values);
+}
+
 //==============================================================================
 template<typename Key, typename Data, typename HashFnc>
 void SimpleHashTable<Key, Data, HashFnc>::remove(Key key, Data value)
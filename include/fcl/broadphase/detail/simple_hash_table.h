@@ -76,6 +76,10 @@ public:
   /// key.
   std::vector<Data> query(Key key) const;
 
+  /// @brief find the elements whose key is the same as the query and store
+  /// them in result
+  void query(Key key, std::vector<Data>& result) const;
+
   /// @brief remove the key-value pair from the table
   void remove(Key key, Data value);
 
@@ -94,6 +94,16 @@ std::vector<Data> SparseHashTable<Key, Data, HashFnc, TableT>::query(Key key) co
   return std::vector<Data>(result.begin(), result.end());
 }
 
+//==============================================================================
+template <typename Key, typename Data, typename HashFnc,
+          template<typename, typename> class TableT>
+void SparseHashTable<Key, Data, HashFnc, TableT>::query(
+    Key key, std::vector<Data>& result) const
+{
+  std::vector<Data> values = query(key);
+  result.swap(values);
+}
+
 //==============================================================================
 template <typename Key, typename Data, typename HashFnc,
           template<typename, typename> class TableT>
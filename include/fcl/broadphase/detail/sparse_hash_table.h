@@ -76,6 +76,10 @@ public:
   /// @brief find the elements whose key is the same as the query
   std::vector<Data> query(Key key) const;
 
+  /// @brief find the elements whose key is the same as the query and store
+  /// them in result
+  void query(Key key, std::vector<Data>& result) const;
+
   /// @brief remove one key-value pair from the hash table
   void remove(Key key, Data value);
 
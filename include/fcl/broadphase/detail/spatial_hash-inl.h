@@ -60,6 +60,16 @@ SpatialHash<S>::SpatialHash(const AABB<S>& scene_limit_, S cell_size_)
 //==============================================================================
 template <typename S>
 std::vector<unsigned int> SpatialHash<S>::operator()(const AABB<S>& aabb) const
+{
+  std::vector<unsigned int> keys;
+  visit(aabb, [&keys](unsigned int key) { keys.push_back(key); });
+  return keys;
+}
+
+//==============================================================================
+template <typename S>
+template <typename Visitor>
+void SpatialHash<S>::visit(const AABB<S>& aabb, Visitor visitor) const
 {
   int min_x = std::floor((aabb.min_[0] - scene_limit.min_[0]) / cell_size);
   int max_x = std::ceil((aabb.max_[0] - scene_limit.min_[0]) / cell_size);
@@ -68,19 +78,16 @@ std::vector<unsigned int> SpatialHash<S>::operator()(const AABB<S>& aabb) const
   int min_z = std::floor((aabb.min_[2] - scene_limit.min_[2]) / cell_size);
   int max_z = std::ceil((aabb.max_[2] - scene_limit.min_[2]) / cell_size);
 
-  std::vector<unsigned int> keys((max_x - min_x) * (max_y - min_y) * (max_z - min_z));
-  int id = 0;
   for(int x = min_x; x < max_x; ++x)
   {
     for(int y = min_y; y < max_y; ++y)
     {
       for(int z = min_z; z < max_z; ++z)
       {
-        keys[id++] = x + y * width[0] + z * width[0] * width[1];
+        visitor(static_cast<unsigned int>(x + y * width[0] + z * width[0] * width[1]));
       }
     }
   }
-  return keys;
 }
 
 } // namespace detail
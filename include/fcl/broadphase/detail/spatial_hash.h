@@ -38,6 +38,7 @@
 #ifndef FCL_BROADPHASE_SPATIALHASH_H
 #define FCL_BROADPHASE_SPATIALHASH_H
 
+#include <vector>
 #include "fcl/math/bv/AABB.h"
 
 namespace fcl
@@ -56,6 +57,11 @@ struct SpatialHash
     
   std::vector<unsigned int> operator() (const AABB<S>& aabb) const;
 
+  /// @brief Call visitor(key) for the key of every cell overlapped by the
+  /// AABB, in the same order as operator(), without allocating.
+  template <typename Visitor>
+  void visit(const AABB<S>& aabb, Visitor visitor) const;
+
 private:
 
   S cell_size;
@@ -0,0 +1,116 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_OBJECTPOOL_INL_H
+#define FCL_COMMON_DETAIL_OBJECTPOOL_INL_H
+
+#include "fcl/common/detail/object_pool.h"
+
+#include <new>
+#include <utility>
+
+namespace fcl {
+namespace detail {
+
+//==============================================================================
+template <typename T>
+ObjectPool<T>::ObjectPool() : num_allocated(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+ObjectPool<T>::~ObjectPool()
+{
+  for(void* block : free_blocks)
+    ::operator delete(block);
+}
+
+//==============================================================================
+template <typename T>
+ObjectPool<T>& ObjectPool<T>::threadLocal()
+{
+  static thread_local ObjectPool<T> pool;
+  return pool;
+}
+
+//==============================================================================
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::create(Args&&... args)
+{
+  void* block;
+  if(free_blocks.empty())
+  {
+    block = ::operator new(sizeof(T));
+    ++num_allocated;
+  }
+  else
+  {
+    block = free_blocks.back();
+    free_blocks.pop_back();
+  }
+
+  return new (block) T(std::forward<Args>(args)...);
+}
+
+//==============================================================================
+template <typename T>
+void ObjectPool<T>::destroy(T* obj)
+{
+  if(!obj) return;
+
+  obj->~T();
+  free_blocks.push_back(obj);
+}
+
+//==============================================================================
+template <typename T>
+std::size_t ObjectPool<T>::numFree() const
+{
+  return free_blocks.size();
+}
+
+//==============================================================================
+template <typename T>
+std::size_t ObjectPool<T>::numAllocated() const
+{
+  return num_allocated;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
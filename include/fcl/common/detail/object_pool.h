@@ -0,0 +1,90 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_OBJECTPOOL_H
+#define FCL_COMMON_DETAIL_OBJECTPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace fcl {
+namespace detail {
+
+/// @brief A free list of blocks for objects of type T. Blocks released by
+/// destroy() are handed out again by the next create(), so once the pool has
+/// grown to the peak number of live objects, creating and destroying objects
+/// no longer touches the heap. The pool is not thread-safe; use
+/// threadLocal() to get the pool of the calling thread.
+template <typename T>
+class ObjectPool
+{
+public:
+  ObjectPool();
+
+  // non-copyable
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  /// @brief Return the blocks to the heap. Objects still alive are not
+  /// destroyed, their memory simply stays with whoever releases it later.
+  ~ObjectPool();
+
+  /// @brief Return the pool owned by the calling thread
+  static ObjectPool& threadLocal();
+
+  /// @brief Construct an object in a free block, allocating one if necessary
+  template <typename... Args>
+  T* create(Args&&... args);
+
+  /// @brief Destroy an object obtained from create() and keep its block for
+  /// reuse. The object may come from the pool of another thread.
+  void destroy(T* obj);
+
+  /// @brief Number of blocks currently waiting for reuse
+  std::size_t numFree() const;
+
+  /// @brief Number of blocks this pool has requested from the heap
+  std::size_t numAllocated() const;
+
+private:
+  std::vector<void*> free_blocks;
+  std::size_t num_allocated;
+};
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/common/detail/object_pool-inl.h"
+
+#endif
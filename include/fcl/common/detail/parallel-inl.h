@@ -0,0 +1,122 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_PARALLEL_INL_H
+#define FCL_COMMON_DETAIL_PARALLEL_INL_H
+
+#include "fcl/common/detail/parallel.h"
+
+namespace fcl {
+namespace detail {
+
+//==============================================================================
+template <typename Worker>
+void runWorkers(unsigned int num_threads, Worker worker)
+{
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto guarded = [&](unsigned int thread_id)
+  {
+    try
+    {
+      worker(thread_id);
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if(!error) error = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for(unsigned int i = 1; i < num_threads; ++i)
+    threads.emplace_back(guarded, i);
+
+  guarded(0);
+
+  for(auto& thread : threads)
+    thread.join();
+
+  if(error) std::rethrow_exception(error);
+}
+
+//==============================================================================
+template <typename Function>
+void parallelFor(std::size_t n, unsigned int num_threads, Function f)
+{
+  if(n == 0) return;
+
+  num_threads = std::min<std::size_t>(resolveNumThreads(num_threads), n);
+  if(num_threads <= 1)
+  {
+    for(std::size_t i = 0; i < n; ++i)
+      f(i, 0u);
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  runWorkers(num_threads, [&](unsigned int thread_id)
+  {
+    for(std::size_t i = next++; i < n; i = next++)
+      f(i, thread_id);
+  });
+}
+
+//==============================================================================
+template <typename Function>
+void parallelForChunks(std::size_t n, unsigned int num_threads, Function f)
+{
+  num_threads = resolveNumThreads(num_threads);
+  if(num_threads <= 1)
+  {
+    f(std::size_t(0), n, 0u);
+    return;
+  }
+
+  const std::size_t chunk = n / num_threads;
+  const std::size_t remainder = n % num_threads;
+  runWorkers(num_threads, [&](unsigned int thread_id)
+  {
+    const std::size_t begin = thread_id * chunk + std::min<std::size_t>(thread_id, remainder);
+    const std::size_t end = begin + chunk + (thread_id < remainder ? 1 : 0);
+    f(begin, end, thread_id);
+  });
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_PARALLEL_H
+#define FCL_COMMON_DETAIL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fcl {
+namespace detail {
+
+/// @brief Return the number of worker threads to use for a request of
+/// num_threads; 0 means one thread per hardware thread.
+unsigned int resolveNumThreads(unsigned int num_threads);
+
+/// @brief Call f(i, thread_id) for every i in [0, n) using num_threads threads
+/// (the calling thread is thread 0). Indices are handed out one at a time from
+/// a shared counter, so tasks of uneven cost balance across the threads.
+/// The first exception thrown by f is rethrown on the calling thread.
+template <typename Function>
+void parallelFor(std::size_t n, unsigned int num_threads, Function f);
+
+/// @brief Call f(begin, end, thread_id) on num_threads contiguous chunks that
+/// cover [0, n). The partition only depends on n and num_threads, so the work
+/// seen by each thread is reproducible from run to run.
+template <typename Function>
+void parallelForChunks(std::size_t n, unsigned int num_threads, Function f);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/common/detail/parallel-inl.h"
+
+#endif
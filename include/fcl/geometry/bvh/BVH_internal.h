@@ -71,6 +71,15 @@ enum BVHReturnCode
     BVH_ERR_UNKNOWN = -8                        /// Unknown failure
   };
 
+/// @brief Order of the nodes in the BV array of a BVH. Whatever the order, the
+/// root is node 0 and the two children of a node are stored side by side.
+enum BVHNodeLayout
+  {
+    BVH_LAYOUT_DEPTH_FIRST,         /// @brief order of construction, children pairs in depth-first order of their parents
+    BVH_LAYOUT_BREADTH_FIRST,       /// @brief children pairs level by level
+    BVH_LAYOUT_VAN_EMDE_BOAS        /// @brief children pairs in recursive blocks of half the tree height (cache oblivious)
+  };
+
 /// @brief BVH model type
 enum BVHModelType
   {
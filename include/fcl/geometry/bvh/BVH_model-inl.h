@@ -40,6 +40,8 @@
 
 #include "fcl/geometry/bvh/BVH_model.h"
 
+#include "fcl/common/detail/parallel.h"
+
 namespace fcl
 {
 
@@ -65,6 +67,7 @@ BVHModel<BV>::BVHModel() : vertices(nullptr),
   build_state(BVH_BUILD_STATE_EMPTY),
   bv_splitter(new detail::BVSplitter<BV>(detail::SPLIT_METHOD_MEAN)),
   bv_fitter(new detail::BVFitter<BV>()),
+  num_build_threads(1),
   num_tris_allocated(0),
   num_vertices_allocated(0),
   num_bvs_allocated(0),
@@ -85,6 +88,7 @@ BVHModel<BV>::BVHModel(const BVHModel<BV>& other)
     build_state(other.build_state),
     bv_splitter(other.bv_splitter),
     bv_fitter(other.bv_fitter),
+    num_build_threads(other.num_build_threads),
     num_tris_allocated(other.num_tris),
     num_vertices_allocated(other.num_vertices)
 {
@@ -724,15 +728,16 @@ int BVHModel<BV>::endUpdateModel(bool refit, bool bottomup)
 template <typename BV>
 int BVHModel<BV>::memUsage(int msg) const
 {
-  int mem_bv_list = sizeof(BV) * num_bvs;
+  int mem_bv_list = sizeof(BVNode<BV>) * num_bvs;
   int mem_tri_list = sizeof(Triangle) * num_tris;
   int mem_vertex_list = sizeof(Vector3<S>) * num_vertices;
+  int mem_primitive_list = primitive_indices ? sizeof(unsigned int) * (num_tris > 0 ? num_tris : num_vertices) : 0;
 
-  int total_mem = mem_bv_list + mem_tri_list + mem_vertex_list + sizeof(BVHModel<BV>);
+  int total_mem = mem_bv_list + mem_tri_list + mem_vertex_list + mem_primitive_list + sizeof(BVHModel<BV>);
   if(msg)
   {
     std::cerr << "Total for model " << total_mem << " bytes." << std::endl;
-    std::cerr << "BVs: " << num_bvs << " allocated." << std::endl;
+    std::cerr << "BVs: " << num_bvs << " allocated, " << sizeof(BVNode<BV>) << " bytes each (" << sizeof(BV) << " bytes of bounding volume)." << std::endl;
     std::cerr << "Tris: " << num_tris << " allocated." << std::endl;
     std::cerr << "Vertices: " << num_vertices << " allocated." << std::endl;
   }
@@ -740,6 +745,312 @@ int BVHModel<BV>::memUsage(int msg) const
   return BVH_OK;
 }
 
+namespace detail
+{
+
+//==============================================================================
+/// @brief Header of the binary format written by BVHModel::save()
+struct BVHModelFileHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t scalar_size;
+  std::uint32_t node_size;
+  std::int32_t node_type;
+  std::int32_t num_vertices;
+  std::int32_t num_tris;
+  std::int32_t num_bvs;
+  std::int32_t num_primitives;
+};
+
+//==============================================================================
+constexpr char kBVHModelFileMagic[8] = {'F', 'C', 'L', 'B', 'V', 'H', '\0', '\0'};
+
+//==============================================================================
+constexpr std::uint32_t kBVHModelFileVersion = 1;
+
+//==============================================================================
+/// @brief Whether the indices read by BVHModel::load() stay within the model:
+/// triangle vertices, primitive indices, and the children and primitive ranges
+/// of the BV nodes. Children must come after their parent, which every layout
+/// produced by the builder satisfies, so a corrupted hierarchy cannot loop.
+template <typename BV>
+bool checkBVHModelIndices(
+    const Triangle* tri_indices, int num_tris, int num_vertices,
+    const unsigned int* primitive_indices, int num_primitives,
+    const BVNode<BV>* bvs, int num_bvs)
+{
+  for(int i = 0; i < num_tris; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+    {
+      if(tri_indices[i][j] >= static_cast<std::size_t>(num_vertices))
+        return false;
+    }
+  }
+
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    if(primitive_indices[i] >= static_cast<unsigned int>(num_primitives))
+      return false;
+  }
+
+  for(int i = 0; i < num_bvs; ++i)
+  {
+    const BVNode<BV>& node = bvs[i];
+    if(node.first_primitive < 0 || node.num_primitives <= 0
+       || node.num_primitives > num_primitives - node.first_primitive)
+      return false;
+
+    if(node.isLeaf())
+    {
+      if(node.primitiveId() >= num_primitives)
+        return false;
+    }
+    else if(node.first_child <= i || node.first_child >= num_bvs - 1)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::save(std::ostream& out) const
+{
+  if(build_state != BVH_BUILD_STATE_PROCESSED && build_state != BVH_BUILD_STATE_UPDATED)
+  {
+    std::cerr << "BVH Warning! Call save() on a BVHModel that is not built!" << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  detail::BVHModelFileHeader header;
+  std::copy(detail::kBVHModelFileMagic, detail::kBVHModelFileMagic + 8, header.magic);
+  header.version = detail::kBVHModelFileVersion;
+  header.scalar_size = sizeof(S);
+  header.node_size = sizeof(BVNode<BV>);
+  header.node_type = getNodeType();
+  header.num_vertices = num_vertices;
+  header.num_tris = num_tris;
+  header.num_bvs = num_bvs;
+  header.num_primitives = (num_tris > 0) ? num_tris : num_vertices;
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(vertices), sizeof(Vector3<S>) * num_vertices);
+  out.write(reinterpret_cast<const char*>(tri_indices), sizeof(Triangle) * num_tris);
+  out.write(reinterpret_cast<const char*>(primitive_indices), sizeof(unsigned int) * header.num_primitives);
+  out.write(reinterpret_cast<const char*>(bvs), sizeof(BVNode<BV>) * num_bvs);
+
+  if(!out)
+  {
+    std::cerr << "BVH Error! Failed to write the model in save()!" << std::endl;
+    return BVH_ERR_UNKNOWN;
+  }
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::load(std::istream& in)
+{
+  delete [] vertices; vertices = nullptr;
+  delete [] tri_indices; tri_indices = nullptr;
+  delete [] bvs; bvs = nullptr;
+  delete [] prev_vertices; prev_vertices = nullptr;
+  delete [] primitive_indices; primitive_indices = nullptr;
+  num_vertices_allocated = num_vertices = num_tris_allocated = num_tris = num_bvs_allocated = num_bvs = 0;
+  build_state = BVH_BUILD_STATE_EMPTY;
+
+  detail::BVHModelFileHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+  if(!in
+     || !std::equal(detail::kBVHModelFileMagic, detail::kBVHModelFileMagic + 8, header.magic)
+     || header.version != detail::kBVHModelFileVersion
+     || header.scalar_size != sizeof(S)
+     || header.node_size != sizeof(BVNode<BV>)
+     || header.node_type != getNodeType()
+     || header.num_vertices <= 0 || header.num_tris < 0
+     || header.num_primitives != ((header.num_tris > 0) ? header.num_tris : header.num_vertices)
+     || header.num_bvs != 2 * header.num_primitives - 1)
+  {
+    std::cerr << "BVH Error! The stream passed to load() does not hold a model of this type!" << std::endl;
+    return BVH_ERR_INCORRECT_DATA;
+  }
+
+  vertices = new Vector3<S>[header.num_vertices];
+  tri_indices = header.num_tris > 0 ? new Triangle[header.num_tris] : nullptr;
+  primitive_indices = new unsigned int[header.num_primitives];
+  bvs = new BVNode<BV>[header.num_bvs];
+
+  in.read(reinterpret_cast<char*>(vertices), sizeof(Vector3<S>) * header.num_vertices);
+  in.read(reinterpret_cast<char*>(tri_indices), sizeof(Triangle) * header.num_tris);
+  in.read(reinterpret_cast<char*>(primitive_indices), sizeof(unsigned int) * header.num_primitives);
+  in.read(reinterpret_cast<char*>(bvs), sizeof(BVNode<BV>) * header.num_bvs);
+
+  bool valid = true;
+  if(!in)
+  {
+    std::cerr << "BVH Error! The stream passed to load() is truncated!" << std::endl;
+    valid = false;
+  }
+  else if(!detail::checkBVHModelIndices(
+      tri_indices, header.num_tris, header.num_vertices,
+      primitive_indices, header.num_primitives, bvs, header.num_bvs))
+  {
+    std::cerr << "BVH Error! The stream passed to load() holds out of range indices!" << std::endl;
+    valid = false;
+  }
+
+  if(!valid)
+  {
+    delete [] vertices; vertices = nullptr;
+    delete [] tri_indices; tri_indices = nullptr;
+    delete [] bvs; bvs = nullptr;
+    delete [] primitive_indices; primitive_indices = nullptr;
+    return BVH_ERR_INCORRECT_DATA;
+  }
+
+  num_vertices_allocated = num_vertices = header.num_vertices;
+  num_tris_allocated = num_tris = header.num_tris;
+  num_bvs_allocated = num_bvs = header.num_bvs;
+  num_vertex_updated = 0;
+  build_state = BVH_BUILD_STATE_PROCESSED;
+
+  computeLocalAABB();
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::setNodeLayout(BVHNodeLayout layout)
+{
+  if(build_state != BVH_BUILD_STATE_PROCESSED && build_state != BVH_BUILD_STATE_UPDATED)
+  {
+    std::cerr << "BVH Warning! Call setNodeLayout() on a BVHModel that is not built!" << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  if(num_bvs <= 1)
+    return BVH_OK;
+
+  // Order of the internal nodes; the children of the k-th one are stored at
+  // 2k + 1 and 2k + 2, right after the root.
+  std::vector<int> order;
+  order.reserve(num_bvs / 2);
+
+  switch(layout)
+  {
+  case BVH_LAYOUT_DEPTH_FIRST:
+    {
+      std::vector<int> stack(1, 0);
+      while(!stack.empty())
+      {
+        int id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+        const BVNode<BV>& node = bvs[id];
+        if(!bvs[node.rightChild()].isLeaf()) stack.push_back(node.rightChild());
+        if(!bvs[node.leftChild()].isLeaf()) stack.push_back(node.leftChild());
+      }
+    }
+    break;
+  case BVH_LAYOUT_BREADTH_FIRST:
+    {
+      order.push_back(0);
+      for(std::size_t i = 0; i < order.size(); ++i)
+      {
+        const BVNode<BV>& node = bvs[order[i]];
+        if(!bvs[node.leftChild()].isLeaf()) order.push_back(node.leftChild());
+        if(!bvs[node.rightChild()].isLeaf()) order.push_back(node.rightChild());
+      }
+    }
+    break;
+  case BVH_LAYOUT_VAN_EMDE_BOAS:
+    vanEmdeBoasOrder(0, computeInternalHeight(0), order);
+    break;
+  default:
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+
+  std::vector<int> new_ids(num_bvs, 0);
+  for(std::size_t k = 0; k < order.size(); ++k)
+  {
+    const BVNode<BV>& node = bvs[order[k]];
+    new_ids[node.leftChild()] = 2 * k + 1;
+    new_ids[node.rightChild()] = 2 * k + 2;
+  }
+
+  BVNode<BV>* new_bvs = new BVNode<BV>[num_bvs_allocated];
+  for(int i = 0; i < num_bvs; ++i)
+  {
+    BVNode<BV>& node = new_bvs[new_ids[i]];
+    node = bvs[i];
+    if(!node.isLeaf())
+      node.first_child = new_ids[node.first_child];
+  }
+
+  delete [] bvs;
+  bvs = new_bvs;
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::computeInternalHeight(int bv_id) const
+{
+  const BVNode<BV>& node = bvs[bv_id];
+  if(node.isLeaf())
+    return 0;
+
+  return 1 + std::max(computeInternalHeight(node.leftChild()),
+                      computeInternalHeight(node.rightChild()));
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::vanEmdeBoasOrder(int bv_id, int levels, std::vector<int>& order) const
+{
+  if(levels == 1)
+  {
+    order.push_back(bv_id);
+    return;
+  }
+
+  int top_levels = levels / 2;
+  vanEmdeBoasOrder(bv_id, top_levels, order);
+
+  std::vector<int> roots;
+  collectInternalNodes(bv_id, top_levels, roots);
+  for(int root : roots)
+    vanEmdeBoasOrder(root, levels - top_levels, order);
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::collectInternalNodes(int bv_id, int depth, std::vector<int>& roots) const
+{
+  const BVNode<BV>& node = bvs[bv_id];
+  if(node.isLeaf())
+    return;
+
+  if(depth == 0)
+  {
+    roots.push_back(bv_id);
+    return;
+  }
+
+  collectInternalNodes(node.leftChild(), depth - 1, roots);
+  collectInternalNodes(node.rightChild(), depth - 1, roots);
+}
+
 //==============================================================================
 template <typename BV>
 void BVHModel<BV>::makeParentRelative()
@@ -842,7 +1153,37 @@ int BVHModel<BV>::buildTree()
 
   for(int i = 0; i < num_primitives; ++i)
     primitive_indices[i] = i;
-  recursiveBuildTree(0, 0, num_primitives);
+
+  const unsigned int num_threads = detail::resolveNumThreads(num_build_threads);
+  detail::BVSplitter<BV>* splitter
+      = dynamic_cast<detail::BVSplitter<BV>*>(bv_splitter.get());
+  const bool parallel = num_threads > 1 && splitter
+      && dynamic_cast<detail::BVFitter<BV>*>(bv_fitter.get());
+
+  if(parallel)
+  {
+    // Build the top of the tree on this thread, down to enough subtrees to
+    // keep every thread busy, then build the subtrees concurrently. Each
+    // subtree has its own range of nodes and of primitive indices.
+    std::vector<BuildTask> tasks;
+    const int task_size = std::max(num_primitives / static_cast<int>(8 * num_threads), 256);
+    recursiveBuildTree(0, 0, num_primitives, 1, *bv_splitter, &tasks, task_size);
+
+    std::vector<detail::BVSplitter<BV>> splitters(num_threads, *splitter);
+    detail::parallelFor(tasks.size(), num_threads,
+                        [&](std::size_t i, unsigned int thread_id)
+    {
+      const BuildTask& task = tasks[i];
+      recursiveBuildTree(task.bv_id, task.first_primitive, task.num_primitives,
+                         task.first_free_bv, splitters[thread_id]);
+    });
+  }
+  else
+  {
+    recursiveBuildTree(0, 0, num_primitives, 1, *bv_splitter);
+  }
+
+  num_bvs = 2 * num_primitives - 1;
 
   bv_fitter->clear();
   bv_splitter->clear();
@@ -852,15 +1193,28 @@ int BVHModel<BV>::buildTree()
 
 //==============================================================================
 template <typename BV>
-int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_primitives)
+int BVHModel<BV>::recursiveBuildTree(
+    int bv_id,
+    int first_primitive,
+    int num_primitives,
+    int first_free_bv,
+    detail::BVSplitterBase<BV>& splitter,
+    std::vector<BuildTask>* tasks,
+    int task_size)
 {
+  if(tasks && num_primitives <= task_size)
+  {
+    tasks->push_back({bv_id, first_primitive, num_primitives, first_free_bv});
+    return BVH_OK;
+  }
+
   BVHModelType type = getModelType();
   BVNode<BV>* bvnode = bvs + bv_id;
   unsigned int* cur_primitive_indices = primitive_indices + first_primitive;
 
   // constructing BV
   BV bv = bv_fitter->fit(cur_primitive_indices, num_primitives);
-  bv_splitter->computeRule(bv, cur_primitive_indices, num_primitives);
+  splitter.computeRule(bv, cur_primitive_indices, num_primitives);
 
   bvnode->bv = bv;
   bvnode->first_primitive = first_primitive;
@@ -872,8 +1226,7 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_pri
   }
   else
   {
-    bvnode->first_child = num_bvs;
-    num_bvs += 2;
+    bvnode->first_child = first_free_bv;
 
     int c1 = 0;
     for(int i = 0; i < num_primitives; ++i)
@@ -901,7 +1254,7 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_pri
       //  [1] [1] [1] [1] [2] [2] [2] [x] [x] ... [x]
       //                   c1          i
       //
-      if(bv_splitter->apply(p)) // in the right side
+      if(splitter.apply(p)) // in the right side
       {
         // do nothing
       }
@@ -917,8 +1270,10 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_pri
 
     int num_first_half = c1;
 
-    recursiveBuildTree(bvnode->leftChild(), first_primitive, num_first_half);
-    recursiveBuildTree(bvnode->rightChild(), first_primitive + num_first_half, num_primitives - num_first_half);
+    recursiveBuildTree(bvnode->leftChild(), first_primitive, num_first_half,
+                       first_free_bv + 2, splitter, tasks, task_size);
+    recursiveBuildTree(bvnode->rightChild(), first_primitive + num_first_half, num_primitives - num_first_half,
+                       first_free_bv + 2 * num_first_half, splitter, tasks, task_size);
   }
 
   return BVH_OK;
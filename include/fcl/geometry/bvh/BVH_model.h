@@ -40,6 +40,8 @@
 
 #include <vector>
 #include <memory>
+#include <istream>
+#include <ostream>
 
 #include "fcl/math/bv/OBB.h"
 #include "fcl/math/bv/kDOP.h"
@@ -147,6 +149,23 @@ public:
   /// @brief Check the number of memory used
   int memUsage(int msg) const;
 
+  /// @brief Write the vertices, triangles and bounding volume hierarchy of a
+  /// built model to a binary stream. The format stores scalars, indices and
+  /// BV nodes in the native representation of the machine; load() checks
+  /// that it matches before reading anything.
+  int save(std::ostream& out) const;
+
+  /// @brief Replace the model by one written by save() for the same BV type,
+  /// without rebuilding the hierarchy. Returns BVH_ERR_INCORRECT_DATA if the
+  /// stream is not such a model, in which case the model is left empty.
+  int load(std::istream& in);
+
+  /// @brief Reorder the BV nodes of a built hierarchy so that the nodes a
+  /// traversal visits together are close in memory. The tree itself, and hence
+  /// the result of any query, is unchanged, but node indices are: front lists
+  /// recorded before must be cleared.
+  int setNodeLayout(BVHNodeLayout layout);
+
   /// @brief This is a special acceleration: BVH_model default stores the BV's transform in world coordinate. However, we can also store each BV's transform related to its parent 
   /// BV node. When traversing the BVH, this can save one matrix transformation.
   void makeParentRelative();
@@ -182,6 +201,12 @@ public:
   /// @brief Fitting rule to fit a BV node to a set of geometry primitives
   std::shared_ptr<detail::BVFitterBase<BV>> bv_fitter;
 
+  /// @brief Number of threads used to build the hierarchy in endModel(); 0
+  /// means one per hardware thread. The tree is the same for any value.
+  /// Subtrees are built in parallel only with the default BVSplitter and
+  /// BVFitter, whose copies can be used from several threads.
+  unsigned int num_build_threads;
+
 private:
 
   int num_tris_allocated;
@@ -208,8 +233,40 @@ private:
   /// @brief Refit the bounding volume hierarchy in a bottom-up way (fast but less compact)
   int refitTree_bottomup();
 
-  /// @brief Recursive kernel for hierarchy construction
-  int recursiveBuildTree(int bv_id, int first_primitive, int num_primitives);
+  /// @brief Subtree whose construction is left to buildTree()
+  struct BuildTask
+  {
+    int bv_id;
+    int first_primitive;
+    int num_primitives;
+    int first_free_bv;
+  };
+
+  /// @brief Recursive kernel for hierarchy construction. The children of
+  /// bv_id, and then the nodes below them, are stored from first_free_bv on;
+  /// as a subtree over n primitives has 2n - 1 nodes, the ids of every
+  /// subtree are known before it is built. If tasks is not nullptr, subtrees
+  /// with at most task_size primitives are appended to tasks instead of being
+  /// built.
+  int recursiveBuildTree(
+      int bv_id,
+      int first_primitive,
+      int num_primitives,
+      int first_free_bv,
+      detail::BVSplitterBase<BV>& splitter,
+      std::vector<BuildTask>* tasks = nullptr,
+      int task_size = 0);
+
+  /// @brief Compute the number of levels of internal nodes in the subtree
+  /// rooted at bv_id
+  int computeInternalHeight(int bv_id) const;
+
+  /// @brief Append the internal nodes in the first levels of the subtree rooted
+  /// at bv_id to order, in van Emde Boas order
+  void vanEmdeBoasOrder(int bv_id, int levels, std::vector<int>& order) const;
+
+  /// @brief Append the internal nodes depth levels below bv_id to roots
+  void collectInternalNodes(int bv_id, int depth, std::vector<int>& roots) const;
 
   /// @brief Recursive kernel for bottomup refitting 
   int recursiveRefitTree_bottomup(int bv_id);
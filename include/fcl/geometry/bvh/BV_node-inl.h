@@ -69,7 +69,7 @@ Vector3<typename BVNode<BV>::S> BVNode<BV>::getCenter() const
 template <typename S, typename BV>
 struct GetOrientationImpl
 {
-  static Matrix3<S> run(const BVNode<BV>& /*node*/)
+  static Matrix3<S> run(const BV& /*bv*/)
   {
     return Matrix3<S>::Identity();
   }
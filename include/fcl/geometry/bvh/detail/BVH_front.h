@@ -38,7 +38,7 @@
 #ifndef FCL_BVH_FRONT_H
 #define FCL_BVH_FRONT_H
 
-#include <list>
+#include <vector>
 
 namespace fcl
 {
@@ -64,8 +64,9 @@ struct BVHFrontNode
   BVHFrontNode(int left_, int right_);
 };
 
-/// @brief BVH front list is a list of front nodes.
-using BVHFrontList = std::list<BVHFrontNode>;
+/// @brief BVH front list is a list of front nodes, stored contiguously so that
+/// propagating a front from one query to the next walks an array.
+using BVHFrontList = std::vector<BVHFrontNode>;
 
 /// @brief Add new front node into the front list
 void updateFrontList(BVHFrontList* front_list, int b1, int b2);
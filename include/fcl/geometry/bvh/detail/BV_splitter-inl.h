@@ -89,6 +89,9 @@ void BVSplitter<BV>::computeRule(
   case SPLIT_METHOD_BV_CENTER:
     computeRule_bvcenter(bv, primitive_indices, num_primitives);
     break;
+  case SPLIT_METHOD_SAH:
+    computeRule_sah(bv, primitive_indices, num_primitives);
+    break;
   default:
     std::cerr << "Split method not supported" << std::endl;
   }
@@ -255,6 +258,40 @@ void BVSplitter<BV>::computeRule_median(
         *this, bv, primitive_indices, num_primitives);
 }
 
+//==============================================================================
+template <typename S, typename BV>
+struct ComputeRuleSAHImpl
+{
+  static void run(
+      BVSplitter<BV>& splitter,
+      const BV& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    int axis = 2;
+
+    if(bv.width() >= bv.height() && bv.width() >= bv.depth())
+      axis = 0;
+    else if(bv.height() >= bv.width() && bv.height() >= bv.depth())
+      axis = 1;
+
+    splitter.split_axis = axis;
+    computeSplitValue_sah<S>(
+          splitter.vertices, splitter.tri_indices, primitive_indices,
+          num_primitives, splitter.type, Vector3<S>::Unit(axis),
+          splitter.split_value);
+  }
+};
+
+//==============================================================================
+template <typename BV>
+void BVSplitter<BV>::computeRule_sah(
+    const BV& bv, unsigned int* primitive_indices, int num_primitives)
+{
+  ComputeRuleSAHImpl<S, BV>::run(
+        *this, bv, primitive_indices, num_primitives);
+}
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, OBB<S>>
@@ -304,6 +341,23 @@ struct ComputeRuleMedianImpl<S, OBB<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, OBB<S>>
+{
+  static void run(
+      BVSplitter<OBB<S>>& splitter,
+      const OBB<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    computeSplitVector<S, OBB<S>>(bv, splitter.split_vector);
+    computeSplitValue_sah<S>(
+          splitter.vertices, splitter.tri_indices, primitive_indices,
+          num_primitives, splitter.type, splitter.split_vector, splitter.split_value);
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, RSS<S>>
@@ -353,6 +407,23 @@ struct ComputeRuleMedianImpl<S, RSS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, RSS<S>>
+{
+  static void run(
+      BVSplitter<RSS<S>>& splitter,
+      const RSS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    computeSplitVector<S, RSS<S>>(bv, splitter.split_vector);
+    computeSplitValue_sah<S>(
+          splitter.vertices, splitter.tri_indices, primitive_indices,
+          num_primitives, splitter.type, splitter.split_vector, splitter.split_value);
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, kIOS<S>>
@@ -402,6 +473,23 @@ struct ComputeRuleMedianImpl<S, kIOS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, kIOS<S>>
+{
+  static void run(
+      BVSplitter<kIOS<S>>& splitter,
+      const kIOS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    computeSplitVector<S, kIOS<S>>(bv, splitter.split_vector);
+    computeSplitValue_sah<S>(
+          splitter.vertices, splitter.tri_indices, primitive_indices,
+          num_primitives, splitter.type, splitter.split_vector, splitter.split_value);
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, OBBRSS<S>>
@@ -451,6 +539,23 @@ struct ComputeRuleMedianImpl<S, OBBRSS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, OBBRSS<S>>
+{
+  static void run(
+      BVSplitter<OBBRSS<S>>& splitter,
+      const OBBRSS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    computeSplitVector<S, OBBRSS<S>>(bv, splitter.split_vector);
+    computeSplitValue_sah<S>(
+          splitter.vertices, splitter.tri_indices, primitive_indices,
+          num_primitives, splitter.type, splitter.split_vector, splitter.split_value);
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ApplyImpl<S, OBB<S>>
@@ -679,6 +784,112 @@ void computeSplitValue_median(
   }
 }
 
+//==============================================================================
+template <typename S>
+void computeSplitValue_sah(
+    Vector3<S>* vertices,
+    Triangle* triangles,
+    unsigned int* primitive_indices,
+    int num_primitives,
+    BVHModelType type,
+    const Vector3<S>& split_vector,
+    S& split_value)
+{
+  const int num_bins = 16;
+
+  std::vector<S> proj(num_primitives);
+  std::vector<AABB<S>> bounds(num_primitives);
+
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    if(type == BVH_MODEL_TRIANGLES)
+    {
+      const Triangle& t = triangles[primitive_indices[i]];
+      const Vector3<S>& p1 = vertices[t[0]];
+      const Vector3<S>& p2 = vertices[t[1]];
+      const Vector3<S>& p3 = vertices[t[2]];
+      proj[i] = split_vector.dot((p1 + p2 + p3) / 3.0);
+      bounds[i] = AABB<S>(p1, p2, p3);
+    }
+    else
+    {
+      const Vector3<S>& p = vertices[primitive_indices[i]];
+      proj[i] = split_vector.dot(p);
+      bounds[i] = AABB<S>(p);
+    }
+  }
+
+  const S proj_min = *std::min_element(proj.begin(), proj.end());
+  const S proj_max = *std::max_element(proj.begin(), proj.end());
+  const S bin_width = (proj_max - proj_min) / num_bins;
+
+  if(!(bin_width > 0))
+  {
+    split_value = proj_min;
+    return;
+  }
+
+  int bin_counts[num_bins] = {0};
+  std::vector<AABB<S>> bin_bounds(num_bins);
+
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    int bin = std::min(num_bins - 1, static_cast<int>((proj[i] - proj_min) / bin_width));
+    if(bin_counts[bin]++ == 0)
+      bin_bounds[bin] = bounds[i];
+    else
+      bin_bounds[bin] += bounds[i];
+  }
+
+  auto area = [](const AABB<S>& box) -> S
+  {
+    const S w = box.width(), h = box.height(), d = box.depth();
+    return 2 * (w * h + h * d + d * w);
+  };
+
+  // Cost of the primitives on the right of each boundary
+  std::vector<S> right_costs(num_bins, 0);
+  AABB<S> right_box;
+  int right_count = 0;
+  for(int bin = num_bins - 1; bin > 0; --bin)
+  {
+    if(bin_counts[bin] > 0)
+    {
+      right_box = (right_count == 0) ? bin_bounds[bin] : right_box + bin_bounds[bin];
+      right_count += bin_counts[bin];
+    }
+    right_costs[bin] = (right_count > 0) ? right_count * area(right_box) : 0;
+  }
+
+  int best_bin = -1;
+  S best_cost = std::numeric_limits<S>::max();
+  AABB<S> left_box;
+  int left_count = 0;
+  for(int bin = 0; bin < num_bins - 1; ++bin)
+  {
+    if(bin_counts[bin] > 0)
+    {
+      left_box = (left_count == 0) ? bin_bounds[bin] : left_box + bin_bounds[bin];
+      left_count += bin_counts[bin];
+    }
+
+    if(left_count == 0 || left_count == num_primitives)
+      continue;
+
+    const S cost = left_count * area(left_box) + right_costs[bin + 1];
+    if(cost < best_cost)
+    {
+      best_cost = cost;
+      best_bin = bin;
+    }
+  }
+
+  if(best_bin < 0)
+    split_value = (proj_min + proj_max) / 2;
+  else
+    split_value = proj_min + (best_bin + 1) * bin_width;
+}
+
 } // namespace detail
 } // namespace fcl
 
@@ -38,9 +38,12 @@
 #ifndef FCL_BV_SPLITTER_H
 #define FCL_BV_SPLITTER_H
 
-#include <vector>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <vector>
 #include "fcl/math/triangle.h"
+#include "fcl/math/bv/AABB.h"
 #include "fcl/math/bv/kIOS.h"
 #include "fcl/math/bv/OBBRSS.h"
 #include "fcl/geometry/bvh/BVH_internal.h"
@@ -52,12 +55,13 @@ namespace fcl
 namespace detail
 {
 
-/// @brief Three types of split algorithms are provided in FCL as default
+/// @brief Four types of split algorithms are provided in FCL as default
 enum SplitMethodType
 {
   SPLIT_METHOD_MEAN,
   SPLIT_METHOD_MEDIAN,
-  SPLIT_METHOD_BV_CENTER
+  SPLIT_METHOD_BV_CENTER,
+  SPLIT_METHOD_SAH
 };
 
 /// @brief A class describing the split rule that splits each BV node
@@ -128,6 +132,11 @@ private:
   void computeRule_median(
       const BV& bv, unsigned int* primitive_indices, int num_primitives);
 
+  /// @brief Split algorithm 4: Split the node at the bin boundary of lowest
+  /// surface area heuristic cost
+  void computeRule_sah(
+      const BV& bv, unsigned int* primitive_indices, int num_primitives);
+
   template <typename, typename>
   friend struct ApplyImpl;
 
@@ -139,6 +148,9 @@ private:
 
   template <typename, typename>
   friend struct ComputeRuleMedianImpl;
+
+  template <typename, typename>
+  friend struct ComputeRuleSAHImpl;
 };
 
 template <typename S, typename BV>
@@ -169,6 +181,21 @@ void computeSplitValue_median(
     const Vector3<S>& split_vector,
     S& split_value);
 
+/// @brief Compute the split value along split_vector with the binned surface
+/// area heuristic: the primitive centers are put in bins along split_vector
+/// and the boundary between two bins that minimizes the sum over both sides
+/// of (number of primitives) x (surface area of their bounding box) is
+/// returned
+template <typename S>
+void computeSplitValue_sah(
+    Vector3<S>* vertices,
+    Triangle* triangles,
+    unsigned int* primitive_indices,
+    int num_primitives,
+    BVHModelType type,
+    const Vector3<S>& split_vector,
+    S& split_value);
+
 } // namespace detail
 } // namespace fcl
 
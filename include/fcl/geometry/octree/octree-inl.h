@@ -42,7 +42,9 @@
 
 #include "fcl/config.h"
 
-#if FCL_HAVE_OCTOMAP
+#include <algorithm>
+
+#include "fcl/broadphase/detail/morton.h"
 
 namespace fcl
 {
@@ -57,27 +59,166 @@ void computeChildBV(const AABB<double>& root_bv, unsigned int i, AABB<double>& c
 
 //==============================================================================
 template <typename S>
-OcTree<S>::OcTree(S resolution)
-  : tree(std::shared_ptr<const octomap::OcTree>(new octomap::OcTree(resolution)))
+S OcTree<S>::OcTreeNode::getOccupancy() const
 {
-  default_occupancy = tree->getOccupancyThres();
+  return occupancy;
+}
 
+//==============================================================================
+template <typename S>
+OcTree<S>::OcTree(S resolution)
+  : resolution(resolution), tree_depth(16)
+{
   // default occupancy/free threshold is consistent with default setting from octomap
-  occupancy_threshold = tree->getOccupancyThres();
+  tree_occupancy_threshold = 0.5;
+  default_occupancy = tree_occupancy_threshold;
+  occupancy_threshold = tree_occupancy_threshold;
   free_threshold = 0;
 }
 
 //==============================================================================
 template <typename S>
-OcTree<S>::OcTree(const std::shared_ptr<const octomap::OcTree>& tree_)
-  : tree(tree_)
+OcTree<S>::OcTree(S resolution, const std::vector<Vector3<S>>& points)
+  : OcTree(resolution)
 {
-  default_occupancy = tree->getOccupancyThres();
+  struct Voxel
+  {
+    uint64 code;
+    float occupancy;
+    std::uint8_t child_mask;
+  };
+
+  // Leaves at the maximum depth, keyed as in octomap
+  const S half_range = S(1 << (tree_depth - 1));
+  std::vector<std::vector<Voxel>> levels(tree_depth + 1);
+  std::vector<uint64> codes;
+  codes.reserve(points.size());
+  for(const auto& point : points)
+  {
+    uint32 key[3];
+    bool inside = true;
+    for(int i = 0; i < 3; ++i)
+    {
+      const S k = std::floor(point[i] / resolution) + half_range;
+      inside = inside && (k >= 0) && (k < 2 * half_range);
+      key[i] = inside ? static_cast<uint32>(k) : 0;
+    }
+    if(inside)
+      codes.push_back(detail::morton_code60(key[0], key[1], key[2]));
+  }
+
+  std::sort(codes.begin(), codes.end());
+  codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+  if(codes.empty()) return;
+
+  levels[tree_depth].reserve(codes.size());
+  for(auto code : codes)
+    levels[tree_depth].push_back({code, 1.0f, 0});
+
+  // Parents group the consecutive children sharing their code prefix
+  for(unsigned int depth = tree_depth; depth > 0; --depth)
+  {
+    std::vector<Voxel>& children = levels[depth];
+    std::vector<Voxel>& parents = levels[depth - 1];
+    std::vector<Voxel> kept;
+    kept.reserve(children.size());
+
+    for(size_t i = 0; i < children.size();)
+    {
+      Voxel parent = {children[i].code >> 3, children[i].occupancy, 0};
+      bool prunable = true;
+      size_t j = i;
+      for(; j < children.size() && (children[j].code >> 3) == parent.code; ++j)
+      {
+        parent.child_mask |= std::uint8_t(1 << (children[j].code & 7));
+        parent.occupancy = std::max(parent.occupancy, children[j].occupancy);
+        prunable = prunable && (children[j].child_mask == 0)
+            && (children[j].occupancy == children[i].occupancy);
+      }
+
+      if(prunable && parent.child_mask == 0xFF)
+        parent.child_mask = 0;
+      else
+        kept.insert(kept.end(), children.begin() + i, children.begin() + j);
+
+      parents.push_back(parent);
+      i = j;
+    }
+
+    children.swap(kept);
+  }
 
+  size_t num_nodes = 0;
+  for(const auto& level : levels)
+    num_nodes += level.size();
+  nodes.reserve(num_nodes);
+
+  size_t next_child = levels[0].size();
+  for(const auto& level : levels)
+  {
+    for(const auto& voxel : level)
+    {
+      OcTreeNode node;
+      node.occupancy = voxel.occupancy;
+      node.child_mask = voxel.child_mask;
+      node.first_child = voxel.child_mask ? next_child : 0;
+      next_child += countChildren(voxel.child_mask);
+      nodes.push_back(node);
+    }
+  }
+}
+
+#if FCL_HAVE_OCTOMAP
+//==============================================================================
+template <typename S>
+OcTree<S>::OcTree(const std::shared_ptr<const octomap::OcTree>& tree_)
+  : resolution(tree_->getResolution()), tree_depth(tree_->getTreeDepth())
+{
   // default occupancy/free threshold is consistent with default setting from octomap
-  occupancy_threshold = tree->getOccupancyThres();
+  tree_occupancy_threshold = tree_->getOccupancyThres();
+  default_occupancy = tree_occupancy_threshold;
+  occupancy_threshold = tree_occupancy_threshold;
   free_threshold = 0;
+
+  // Breadth first, so that each level comes out in Morton order with the
+  // children of a node next to each other
+  std::vector<const octomap::OcTreeNode*> queue;
+  queue.reserve(tree_->size());
+  if(tree_->getRoot())
+    queue.push_back(tree_->getRoot());
+
+  nodes.reserve(tree_->size());
+  for(size_t i = 0; i < queue.size(); ++i)
+  {
+    const octomap::OcTreeNode* source = queue[i];
+
+    OcTreeNode node;
+    node.occupancy = source->getOccupancy();
+    node.child_mask = 0;
+    node.first_child = queue.size();
+    for(unsigned int j = 0; j < 8; ++j)
+    {
+#if OCTOMAP_VERSION_AT_LEAST(1,8,0)
+      if(tree_->nodeChildExists(source, j))
+      {
+        node.child_mask |= std::uint8_t(1 << j);
+        queue.push_back(tree_->getNodeChild(source, j));
+      }
+#else
+      if(source->childExists(j))
+      {
+        node.child_mask |= std::uint8_t(1 << j);
+        queue.push_back(source->getChild(j));
+      }
+#endif
+    }
+    if(!node.child_mask)
+      node.first_child = 0;
+
+    nodes.push_back(node);
+  }
 }
+#endif
 
 //==============================================================================
 template <typename S>
@@ -92,7 +233,7 @@ void OcTree<S>::computeLocalAABB()
 template <typename S>
 AABB<S> OcTree<S>::getRootBV() const
 {
-  S delta = (1 << tree->getTreeDepth()) * tree->getResolution() / 2;
+  S delta = (1 << tree_depth) * resolution / 2;
 
   // std::cout << "octree size " << delta << std::endl;
   return AABB<S>(Vector3<S>(-delta, -delta, -delta), Vector3<S>(delta, delta, delta));
@@ -102,7 +243,30 @@ AABB<S> OcTree<S>::getRootBV() const
 template <typename S>
 typename OcTree<S>::OcTreeNode* OcTree<S>::getRoot() const
 {
-  return tree->getRoot();
+  if(nodes.empty())
+    return nullptr;
+  return const_cast<OcTreeNode*>(nodes.data());
+}
+
+//==============================================================================
+template <typename S>
+size_t OcTree<S>::size() const
+{
+  return nodes.size();
+}
+
+//==============================================================================
+template <typename S>
+S OcTree<S>::getResolution() const
+{
+  return resolution;
+}
+
+//==============================================================================
+template <typename S>
+unsigned int OcTree<S>::getTreeDepth() const
+{
+  return tree_depth;
 }
 
 //==============================================================================
@@ -175,11 +339,7 @@ template <typename S>
 typename OcTree<S>::OcTreeNode* OcTree<S>::getNodeChild(
     typename OcTree<S>::OcTreeNode* node, unsigned int childIdx)
 {
-#if OCTOMAP_VERSION_AT_LEAST(1,8,0)
-  return tree->getNodeChild(node, childIdx);
-#else
-  return node->getChild(childIdx);
-#endif
+  return &nodes[childIndex(node, childIdx)];
 }
 
 //==============================================================================
@@ -187,11 +347,7 @@ template <typename S>
 const typename OcTree<S>::OcTreeNode* OcTree<S>::getNodeChild(
     const typename OcTree<S>::OcTreeNode* node, unsigned int childIdx) const
 {
-#if OCTOMAP_VERSION_AT_LEAST(1,8,0)
-  return tree->getNodeChild(node, childIdx);
-#else
-  return node->getChild(childIdx);
-#endif
+  return &nodes[childIndex(node, childIdx)];
 }
 
 //==============================================================================
@@ -199,22 +355,14 @@ template <typename S>
 bool OcTree<S>::nodeChildExists(
     const OcTree<S>::OcTreeNode* node, unsigned int childIdx) const
 {
-#if OCTOMAP_VERSION_AT_LEAST(1,8,0)
-  return tree->nodeChildExists(node, childIdx);
-#else
-  return node->childExists(childIdx);
-#endif
+  return (node->child_mask >> childIdx) & 1;
 }
 
 //==============================================================================
 template <typename S>
 bool OcTree<S>::nodeHasChildren(const OcTree<S>::OcTreeNode* node) const
 {
-#if OCTOMAP_VERSION_AT_LEAST(1,8,0)
-  return tree->nodeHasChildren(node);
-#else
-  return node->hasChildren();
-#endif
+  return node->child_mask != 0;
 }
 
 //==============================================================================
@@ -236,28 +384,61 @@ template <typename S>
 std::vector<std::array<S, 6>> OcTree<S>::toBoxes() const
 {
   std::vector<std::array<S, 6>> boxes;
-  boxes.reserve(tree->size() / 2);
-  for(auto it = tree->begin(tree->getTreeDepth()), end = tree->end();
-      it != end;
-      ++it)
+  if(nodes.empty()) return boxes;
+
+  boxes.reserve(nodes.size() / 2);
+
+  std::vector<std::pair<const OcTreeNode*, AABB<S>>> stack;
+  stack.emplace_back(getRoot(), getRootBV());
+  while(!stack.empty())
   {
-    // if(tree->isNodeOccupied(*it))
-    if(isNodeOccupied(&*it))
+    const OcTreeNode* node = stack.back().first;
+    const AABB<S> bv = stack.back().second;
+    stack.pop_back();
+
+    if(nodeHasChildren(node))
+    {
+      for(unsigned int i = 0; i < 8; ++i)
+      {
+        if(nodeChildExists(node, i))
+        {
+          AABB<S> child_bv;
+          computeChildBV(bv, i, child_bv);
+          stack.emplace_back(getNodeChild(node, i), child_bv);
+        }
+      }
+    }
+    else if(isNodeOccupied(node))
     {
-      S size = it.getSize();
-      S x = it.getX();
-      S y = it.getY();
-      S z = it.getZ();
-      S c = (*it).getOccupancy();
-      S t = tree->getOccupancyThres();
-
-      std::array<S, 6> box = {{x, y, z, size, c, t}};
+      const Vector3<S> center = bv.center();
+      S size = bv.width();
+      S c = node->getOccupancy();
+      S t = tree_occupancy_threshold;
+
+      std::array<S, 6> box = {{center[0], center[1], center[2], size, c, t}};
       boxes.push_back(box);
     }
   }
   return boxes;
 }
 
+//==============================================================================
+template <typename S>
+unsigned int OcTree<S>::countChildren(std::uint8_t child_mask)
+{
+  unsigned int count = child_mask - ((child_mask >> 1) & 0x55u);
+  count = (count & 0x33u) + ((count >> 2) & 0x33u);
+  return (count + (count >> 4)) & 0x0Fu;
+}
+
+//==============================================================================
+template <typename S>
+size_t OcTree<S>::childIndex(const OcTreeNode* node, unsigned int childIdx)
+{
+  return node->first_child
+      + countChildren(node->child_mask & ((1u << childIdx) - 1));
+}
+
 //==============================================================================
 template <typename S>
 void computeChildBV(const AABB<S>& root_bv, unsigned int i, AABB<S>& child_bv)
@@ -299,5 +480,3 @@ void computeChildBV(const AABB<S>& root_bv, unsigned int i, AABB<S>& child_bv)
 } // namespace fcl
 
 #endif
-
-#endif
@@ -40,12 +40,15 @@
 
 #include "fcl/config.h"
 
-#if FCL_HAVE_OCTOMAP
-
+#include <cstdint>
 #include <memory>
 #include <array>
+#include <vector>
 
+#if FCL_HAVE_OCTOMAP
 #include <octomap/octomap.h>
+#endif
+
 #include "fcl/math/bv/AABB.h"
 #include "fcl/narrowphase/collision_object.h"
 
@@ -54,26 +57,48 @@ namespace fcl
 
 /// @brief Octree is one type of collision geometry which can encode uncertainty
 /// information in the sensor data.
+///
+/// The tree is stored as a pointerless array of nodes built once, either from
+/// an octomap tree or from raw points: the nodes are laid out level by level,
+/// in Morton order within each level, so that the children of a node are
+/// contiguous and are found from the index of the first one and a bit mask.
 template <typename S>
 class OcTree : public CollisionGeometry<S>
 {
-private:
-  std::shared_ptr<const octomap::OcTree> tree;
+public:
 
-  S default_occupancy;
+  /// @brief node of the octree
+  class OcTreeNode
+  {
+  public:
+    /// @brief occupancy probability of the node; for an inner node, the
+    /// maximum occupancy of its children as in octomap
+    S getOccupancy() const;
 
-  S occupancy_threshold;
-  S free_threshold;
+  private:
+    friend class OcTree;
 
-public:
+    float occupancy;
+
+    /// @brief bit i is set if the i-th child exists
+    std::uint8_t child_mask;
 
-  typedef octomap::OcTreeNode OcTreeNode;
+    /// @brief index of the first existing child in the node array
+    uint32 first_child;
+  };
 
-  /// @brief construct octree with a given resolution
+  /// @brief construct an empty octree with a given resolution
   OcTree(S resolution);
 
+  /// @brief construct octree with a given resolution whose occupied leaves are
+  /// the voxels containing the points; eight occupied sibling leaves are
+  /// merged into their parent. Points outside of the tree range are ignored.
+  OcTree(S resolution, const std::vector<Vector3<S>>& points);
+
+#if FCL_HAVE_OCTOMAP
   /// @brief construct octree from octomap
   OcTree(const std::shared_ptr<const octomap::OcTree>& tree_);
+#endif
 
   /// @brief compute the AABB<S> for the octree in its local coordinate system
   void computeLocalAABB();
@@ -81,9 +106,18 @@ public:
   /// @brief get the bounding volume for the root
   AABB<S> getRootBV() const;
 
-  /// @brief get the root node of the octree
+  /// @brief get the root node of the octree, nullptr if the tree is empty
   OcTreeNode* getRoot() const;
 
+  /// @brief the number of nodes of the octree
+  size_t size() const;
+
+  /// @brief the resolution of the leaves of the octree
+  S getResolution() const;
+
+  /// @brief the depth of the leaves of the octree
+  unsigned int getTreeDepth() const;
+
   /// @brief whether one node is completely occupied
   bool isNodeOccupied(const OcTreeNode* node) const;
 
@@ -131,6 +165,28 @@ public:
 
   /// @brief return node type, it is an octree
   NODE_TYPE getNodeType() const;
+
+private:
+  std::vector<OcTreeNode> nodes;
+
+  S resolution;
+
+  unsigned int tree_depth;
+
+  /// @brief the occupancy threshold of the source tree, kept in the boxes
+  /// returned by toBoxes()
+  S tree_occupancy_threshold;
+
+  S default_occupancy;
+
+  S occupancy_threshold;
+  S free_threshold;
+
+  /// @brief the number of children in a child mask
+  static unsigned int countChildren(std::uint8_t child_mask);
+
+  /// @brief the index of the child number childIdx of node in the node array
+  static size_t childIndex(const OcTreeNode* node, unsigned int childIdx);
 };
 
 using OcTreef = OcTree<float>;
@@ -144,6 +200,4 @@ void computeChildBV(const AABB<S>& root_bv, unsigned int i, AABB<S>& child_bv);
 
 #include "fcl/geometry/octree/octree-inl.h"
 
-#endif // #if FCL_HAVE_OCTOMAP
-
 #endif
@@ -40,6 +40,8 @@
 
 #include "fcl/math/bv/AABB.h"
 
+#include "fcl/math/bv/OBB.h"
+
 namespace fcl
 {
 
@@ -351,6 +353,20 @@ AABB<S> translate(
   return res;
 }
 
+//==============================================================================
+template <typename S, typename DerivedA, typename DerivedB>
+bool overlap(const Eigen::MatrixBase<DerivedA>& R0,
+             const Eigen::MatrixBase<DerivedB>& T0,
+             const AABB<S>& b1, const AABB<S>& b2)
+{
+  const Matrix3<S> R = R0;
+  const Vector3<S> T = R0 * b2.center() + T0 - b1.center();
+
+  return !obbDisjoint<S>(R, T,
+                         (b1.max_ - b1.min_) * 0.5,
+                         (b2.max_ - b2.min_) * 0.5);
+}
+
 } // namespace fcl
 
 #endif
@@ -144,6 +144,14 @@ template <typename S, typename Derived>
 AABB<S> translate(
     const AABB<S>& aabb, const Eigen::MatrixBase<Derived>& t);
 
+/// @brief Check collision between two AABBs, b2 is in configuration (R0, T0)
+/// relative to the frame of b1. The test is exact: b2 is treated as an oriented
+/// box in the frame of b1, so neither box has to be refitted.
+template <typename S, typename DerivedA, typename DerivedB>
+bool overlap(const Eigen::MatrixBase<DerivedA>& R0,
+             const Eigen::MatrixBase<DerivedB>& T0,
+             const AABB<S>& b1, const AABB<S>& b2);
+
 } // namespace fcl
 
 #include "fcl/math/bv/AABB-inl.h"
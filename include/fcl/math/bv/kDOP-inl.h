@@ -41,6 +41,7 @@
 #include "fcl/math/bv/kDOP.h"
 
 #include "fcl/common/unused.h"
+#include "fcl/math/bv/OBB.h"
 
 namespace fcl
 {
@@ -314,6 +315,70 @@ void minmax(S p, S& minv, S& maxv)
   if(p < minv) minv = p;
 }
 
+namespace detail
+{
+
+//==============================================================================
+/// @brief Whether the box with the given center, half extents and axes (the
+/// columns of R) lies outside one of the non-AABB slabs of bv
+template <typename S, std::size_t N>
+bool kdopSlabsDisjoint(
+    const KDOP<S, N>& bv,
+    const Matrix3<S>& R,
+    const Vector3<S>& center,
+    const Vector3<S>& extent)
+{
+  const std::size_t M = (N - 6) / 2;
+
+  S center_d[M];
+  S axis_d[3][M];
+  getDistances<S, M>(center, center_d);
+  for(std::size_t j = 0; j < 3; ++j)
+    getDistances<S, M>(Vector3<S>(R.col(j) * extent[j]), axis_d[j]);
+
+  for(std::size_t i = 0; i < M; ++i)
+  {
+    const S r = std::abs(axis_d[0][i]) + std::abs(axis_d[1][i]) + std::abs(axis_d[2][i]);
+    if(center_d[i] - r > bv.dist(3 + i + N / 2)) return true;
+    if(center_d[i] + r < bv.dist(3 + i)) return true;
+  }
+
+  return false;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S, std::size_t N, typename DerivedA, typename DerivedB>
+bool overlap(const Eigen::MatrixBase<DerivedA>& R0,
+             const Eigen::MatrixBase<DerivedB>& T0,
+             const KDOP<S, N>& b1, const KDOP<S, N>& b2)
+{
+  const Matrix3<S> R = R0;
+  const Vector3<S> T = T0;
+
+  const Vector3<S> a(b1.width() * 0.5, b1.height() * 0.5, b1.depth() * 0.5);
+  const Vector3<S> b(b2.width() * 0.5, b2.height() * 0.5, b2.depth() * 0.5);
+
+  // b2's center expressed in b1's frame
+  const Vector3<S> c1 = b1.center();
+  const Vector3<S> c2 = R * b2.center() + T;
+
+  if(obbDisjoint<S>(R, c2 - c1, a, b))
+    return false;
+
+  // slabs of b1 against the box of b2
+  if(detail::kdopSlabsDisjoint(b1, R, c2, b))
+    return false;
+
+  // slabs of b2 against the box of b1, expressed in b2's frame
+  const Matrix3<S> Rt = R.transpose();
+  if(detail::kdopSlabsDisjoint(b2, Rt, Vector3<S>(Rt * (c1 - T)), a))
+    return false;
+
+  return true;
+}
+
 //==============================================================================
 template <typename S, std::size_t N>
 struct GetDistancesImpl
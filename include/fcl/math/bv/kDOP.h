@@ -168,6 +168,15 @@ template <typename S, std::size_t N, typename Derived>
 KDOP<S, N> translate(
     const KDOP<S, N>& bv, const Eigen::MatrixBase<Derived>& t);
 
+/// @brief Check collision between two KDOPs, b2 is in configuration (R0, T0)
+/// relative to the frame of b1. The AABB parts of the KDOPs are compared
+/// exactly as oriented boxes and the remaining slabs of each KDOP are tested
+/// against the box of the other one, so the test is conservative.
+template <typename S, std::size_t N, typename DerivedA, typename DerivedB>
+bool overlap(const Eigen::MatrixBase<DerivedA>& R0,
+             const Eigen::MatrixBase<DerivedB>& T0,
+             const KDOP<S, N>& b1, const KDOP<S, N>& b2);
+
 } // namespace fcl
 
 #include "fcl/math/bv/kDOP-inl.h"
@@ -946,6 +946,18 @@ void convertBV(
   detail::ConvertBVImpl<typename BV1::S, BV1, BV2>::run(bv1, tf1, bv2);
 }
 
+//==============================================================================
+template <typename BV>
+typename BV::S maxPenetrationDepth(const BV& bv1, const BV& bv2)
+{
+  using S = typename BV::S;
+
+  const S diameter1 = Vector3<S>(bv1.width(), bv1.height(), bv1.depth()).norm();
+  const S diameter2 = Vector3<S>(bv2.width(), bv2.height(), bv2.depth()).norm();
+
+  return std::min(diameter1, diameter2);
+}
+
 } // namespace fcl
 
 #endif
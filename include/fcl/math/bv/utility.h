@@ -54,6 +54,12 @@ template <typename BV1, typename BV2>
 void convertBV(
     const BV1& bv1, const Transform3<typename BV1::S>& tf1, BV2& bv2);
 
+/// @brief Upper bound on the penetration depth between two triangles enclosed
+/// by bv1 and bv2, i.e., the diameter of the smaller bounding volume. It does
+/// not bound the penetration between solids.
+template <typename BV>
+typename BV::S maxPenetrationDepth(const BV& bv1, const BV& bv2);
+
 } // namespace fcl
 
 #include "fcl/math/bv/utility-inl.h"
@@ -40,7 +40,7 @@
 
 #include "fcl/math/motion/spline_motion.h"
 
-#include "fcl/common/unused.h"
+#include <algorithm>
 
 namespace fcl
 {
@@ -66,26 +66,7 @@ SplineMotion<S>::SplineMotion(
   Rd[2] = Rd2;
   Rd[3] = Rd3;
 
-  Rd0Rd0 = Rd[0].dot(Rd[0]);
-  Rd0Rd1 = Rd[0].dot(Rd[1]);
-  Rd0Rd2 = Rd[0].dot(Rd[2]);
-  Rd0Rd3 = Rd[0].dot(Rd[3]);
-  Rd1Rd1 = Rd[1].dot(Rd[1]);
-  Rd1Rd2 = Rd[1].dot(Rd[2]);
-  Rd1Rd3 = Rd[1].dot(Rd[3]);
-  Rd2Rd2 = Rd[2].dot(Rd[2]);
-  Rd2Rd3 = Rd[2].dot(Rd[3]);
-  Rd3Rd3 = Rd[3].dot(Rd[3]);
-
-  TA = Td[1] * 3 - Td[2] * 3 + Td[3] - Td[0];
-  TB = (Td[0] - Td[1] * 2 + Td[2]) * 3;
-  TC = (Td[2] - Td[0]) * 3;
-
-  RA = Rd[1] * 3 - Rd[2] * 3 + Rd[3] - Rd[0];
-  RB = (Rd[0] - Rd[1] * 2 + Rd[2]) * 3;
-  RC = (Rd[2] - Rd[0]) * 3;
-
-  integrate(0.0);
+  computeSplineParameter();
 }
 
 //==============================================================================
@@ -95,24 +76,30 @@ SplineMotion<S>::SplineMotion(
     const Matrix3<S>& R2, const Vector3<S>& T2)
   : MotionBase<S>()
 {
-  FCL_UNUSED(R1);
-  FCL_UNUSED(T1);
-  FCL_UNUSED(R2);
-  FCL_UNUSED(T2);
+  // Evenly spaced collinear deBoor points make the uniform cubic B-spline
+  // interpolate linearly between (R1, T1) at t = 0 and (R2, T2) at t = 1, with
+  // the rotation interpolated in its rotation vector (axis * angle) form.
+  const AngleAxis<S> aa1(R1);
+  const AngleAxis<S> aa2(R2);
+  const Vector3<S> r1 = aa1.axis() * aa1.angle();
+  const Vector3<S> r2 = aa2.axis() * aa2.angle();
+
+  for(int i = 0; i < 4; ++i)
+  {
+    Td[i] = T1 + (T2 - T1) * (S)(i - 1);
+    Rd[i] = r1 + (r2 - r1) * (S)(i - 1);
+  }
 
-  // TODO
+  computeSplineParameter();
 }
 
 //==============================================================================
 template <typename S>
 SplineMotion<S>::SplineMotion(
     const Transform3<S>& tf1, const Transform3<S>& tf2)
-  : MotionBase<S>()
+  : SplineMotion(tf1.linear(), tf1.translation(), tf2.linear(), tf2.translation())
 {
-  FCL_UNUSED(tf1);
-  FCL_UNUSED(tf2);
-
-  // TODO
+  // Do nothing
 }
 
 //==============================================================================
@@ -161,7 +148,7 @@ void SplineMotion<S>::getTaylorModel(TMatrix3<S>& tm, TVector3<S>& tv) const
 {
   // set tv
   Vector3<S> c[4];
-  c[0] = (Td[0] + Td[1] * 4 + Td[2] + Td[3]) * (1/6.0);
+  c[0] = (Td[0] + Td[1] * 4 + Td[2]) * (1/6.0);
   c[1] = (-Td[0] + Td[2]) * (1/2.0);
   c[2] = (Td[0] - Td[1] * 2 + Td[2]) * (1/2.0);
   c[3] = (-Td[0] + Td[1] * 3 - Td[2] * 3 + Td[3]) * (1/6.0);
@@ -175,62 +162,35 @@ void SplineMotion<S>::getTaylorModel(TMatrix3<S>& tm, TVector3<S>& tv) const
   }
 
   // set tm
-  Matrix3<S> I = Matrix3<S>::Identity();
-  // R(t) = R(t0) + R'(t0) (t-t0) + 1/2 R''(t0)(t-t0)^2 + 1 / 6 R'''(t0) (t-t0)^3 + 1 / 24 R''''(l)(t-t0)^4; t0 = 0.5
-  /// 1. compute M(1/2)
-  Vector3<S> Rt0 = (Rd[0] + Rd[1] * 23 + Rd[2] * 23 + Rd[3]) * (1 / 48.0);
-  S Rt0_len = Rt0.norm();
-  S inv_Rt0_len = 1.0 / Rt0_len;
-  S inv_Rt0_len_3 = inv_Rt0_len * inv_Rt0_len * inv_Rt0_len;
-  S inv_Rt0_len_5 = inv_Rt0_len_3 * inv_Rt0_len * inv_Rt0_len;
-  S theta0 = Rt0_len;
-  S costheta0 = cos(theta0);
-  S sintheta0 = sin(theta0);
-
-  Vector3<S> Wt0 = Rt0 * inv_Rt0_len;
-  Matrix3<S> hatWt0;
-  hat(hatWt0, Wt0);
-  Matrix3<S> hatWt0_sqr = hatWt0 * hatWt0;
-  Matrix3<S> Mt0 = I + hatWt0 * sintheta0 + hatWt0_sqr * (1 - costheta0);
-  // TODO(JS): this could be improved by using exp(Wt0)
-
-  /// 2. compute M'(1/2)
-  Vector3<S> dRt0 = (-Rd[0] - Rd[1] * 5 + Rd[2] * 5 + Rd[3]) * (1 / 8.0);
-  S Rt0_dot_dRt0 = Rt0.dot(dRt0);
-  S dtheta0 = Rt0_dot_dRt0 * inv_Rt0_len;
-  Vector3<S> dWt0 = dRt0 * inv_Rt0_len - Rt0 * (Rt0_dot_dRt0 * inv_Rt0_len_3);
-  Matrix3<S> hatdWt0;
-  hat(hatdWt0, dWt0);
-  Matrix3<S> dMt0 = hatdWt0 * sintheta0 + hatWt0 * (costheta0 * dtheta0) + hatWt0_sqr * (sintheta0 * dtheta0) + (hatWt0 * hatdWt0 + hatdWt0 * hatWt0) * (1 - costheta0);
-
-  /// 3.1. compute M''(1/2)
-  Vector3<S> ddRt0 = (Rd[0] - Rd[1] - Rd[2] + Rd[3]) * 0.5;
-  S Rt0_dot_ddRt0 = Rt0.dot(ddRt0);
-  S dRt0_dot_dRt0 = dRt0.squaredNorm();
-  S ddtheta0 = (Rt0_dot_ddRt0 + dRt0_dot_dRt0) * inv_Rt0_len - Rt0_dot_dRt0 * Rt0_dot_dRt0 * inv_Rt0_len_3;
-  Vector3<S> ddWt0 = ddRt0 * inv_Rt0_len - (dRt0 * (2 * Rt0_dot_dRt0) + Rt0 * (Rt0_dot_ddRt0 + dRt0_dot_dRt0)) * inv_Rt0_len_3 + (Rt0 * (3 * Rt0_dot_dRt0 * Rt0_dot_dRt0)) * inv_Rt0_len_5;
-  Matrix3<S> hatddWt0;
-  hat(hatddWt0, ddWt0);
-  Matrix3<S> ddMt0 =
-      hatddWt0 * sintheta0 +
-      hatWt0 * (costheta0 * dtheta0 - sintheta0 * dtheta0 * dtheta0 + costheta0 * ddtheta0) +
-      hatdWt0 * (costheta0 * dtheta0) +
-      (hatWt0 * hatdWt0 + hatdWt0 * hatWt0) * (sintheta0 * dtheta0 * 2) +
-      hatdWt0 * hatdWt0 * (2 * (1 - costheta0)) +
-      hatWt0 * hatWt0 * (costheta0 * dtheta0 * dtheta0 + sintheta0 * ddtheta0) +
-      (hatWt0 * hatddWt0 + hatddWt0 + hatWt0) * (1 - costheta0);
+  // R(t) = exp(hat(r(t))) with the rotation vector r(t) a cubic polynomial.
+  // Since the derivative of the exponential map has norm at most 1, the angle
+  // between R(t) and R(1/2) is bounded by |t - 1/2| max |r'|, and so is the
+  // difference of every matrix entry. Use R(1/2) plus that remainder.
+  Vector3<S> dr[3];
+  dr[0] = (-Rd[0] + Rd[2]) * (1/2.0);
+  dr[1] = (Rd[0] - Rd[1] * 2 + Rd[2]);
+  dr[2] = (-Rd[0] + Rd[1] * 3 - Rd[2] * 3 + Rd[3]) * (1/2.0);
+  const S max_dr = dr[0].norm() + dr[1].norm() + dr[2].norm();
+
+  const Vector3<S> Rt0 = (Rd[0] + Rd[1] * 23 + Rd[2] * 23 + Rd[3]) * (1 / 48.0);
+  const S theta0 = Rt0.norm();
+  Matrix3<S> Mt0 = Matrix3<S>::Identity();
+  if(theta0 > 0)
+    Mt0 = AngleAxis<S>(theta0, Rt0 / theta0).toRotationMatrix();
+
+  const S delta = std::min((S)2, max_dr * 0.5);
 
   tm.setTimeInterval(this->getTimeInterval());
   for(std::size_t i = 0; i < 3; ++i)
   {
     for(std::size_t j = 0; j < 3; ++j)
     {
-      tm(i, j).coeff(0) = Mt0(i, j) - dMt0(i, j) * 0.5 + ddMt0(i, j) * 0.25 * 0.5;
-      tm(i, j).coeff(1) = dMt0(i, j) - ddMt0(i, j) * 0.5;
-      tm(i, j).coeff(2) = ddMt0(i, j) * 0.5;
+      tm(i, j).coeff(0) = Mt0(i, j);
+      tm(i, j).coeff(1) = 0;
+      tm(i, j).coeff(2) = 0;
       tm(i, j).coeff(3) = 0;
 
-      tm(i, j).remainder() = Interval<S>(-1/48.0, 1/48.0); /// not correct, should fix
+      tm(i, j).remainder() = Interval<S>(-delta, delta);
     }
   }
 }
@@ -239,7 +199,26 @@ void SplineMotion<S>::getTaylorModel(TMatrix3<S>& tm, TVector3<S>& tv) const
 template <typename S>
 void SplineMotion<S>::computeSplineParameter()
 {
-  // TODO(JS): Not implemented?
+  Rd0Rd0 = Rd[0].dot(Rd[0]);
+  Rd0Rd1 = Rd[0].dot(Rd[1]);
+  Rd0Rd2 = Rd[0].dot(Rd[2]);
+  Rd0Rd3 = Rd[0].dot(Rd[3]);
+  Rd1Rd1 = Rd[1].dot(Rd[1]);
+  Rd1Rd2 = Rd[1].dot(Rd[2]);
+  Rd1Rd3 = Rd[1].dot(Rd[3]);
+  Rd2Rd2 = Rd[2].dot(Rd[2]);
+  Rd2Rd3 = Rd[2].dot(Rd[3]);
+  Rd3Rd3 = Rd[3].dot(Rd[3]);
+
+  TA = Td[1] * 3 - Td[2] * 3 + Td[3] - Td[0];
+  TB = (Td[0] - Td[1] * 2 + Td[2]) * 3;
+  TC = (Td[2] - Td[0]) * 3;
+
+  RA = Rd[1] * 3 - Rd[2] * 3 + Rd[3] - Rd[0];
+  RB = (Rd[0] - Rd[1] * 2 + Rd[2]) * 3;
+  RC = (Rd[2] - Rd[0]) * 3;
+
+  integrate(0.0);
 }
 
 //==============================================================================
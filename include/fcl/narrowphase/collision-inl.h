@@ -40,6 +40,7 @@
 
 #include "fcl/narrowphase/collision.h"
 
+#include "fcl/common/detail/parallel.h"
 #include "fcl/narrowphase/detail/collision_func_matrix.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
@@ -65,6 +66,17 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+extern template
+std::size_t collideBatch(
+    const CollisionGeometry<double>* o1,
+    const Eigen::aligned_vector<Transform3<double>>& tf1,
+    const CollisionGeometry<double>* o2,
+    const Eigen::aligned_vector<Transform3<double>>& tf2,
+    const CollisionRequest<double>& request,
+    std::vector<CollisionResult<double>>& results,
+    unsigned int num_threads);
+
 //==============================================================================
 template<typename GJKSolver>
 detail::CollisionFunctionMatrix<GJKSolver>& getCollisionFunctionLookTable()
@@ -144,6 +156,80 @@ std::size_t collide(
   return res;
 }
 
+//==============================================================================
+template <typename S, typename NarrowPhaseSolver>
+std::size_t collideBatch(
+    const CollisionGeometry<S>* o1,
+    const Eigen::aligned_vector<Transform3<S>>& tf1,
+    const CollisionGeometry<S>* o2,
+    const Eigen::aligned_vector<Transform3<S>>& tf2,
+    const CollisionRequest<S>& request,
+    std::vector<CollisionResult<S>>& results,
+    unsigned int num_threads)
+{
+  const std::size_t n = tf2.size();
+  results.resize(n);
+  for(auto& result : results)
+    result.clear();
+
+  if(n == 0) return 0;
+
+  if(tf1.size() != n && tf1.size() != 1)
+  {
+    std::cerr << "Warning: collideBatch expects " << n << " or 1 poses for the first geometry but got " << tf1.size() << " !" << std::endl;
+    return 0;
+  }
+
+  if(request.num_max_contacts == 0)
+  {
+    std::cerr << "Warning: should stop early as num_max_contact is " << request.num_max_contacts << " !" << std::endl;
+    return 0;
+  }
+
+  const auto& looktable = getCollisionFunctionLookTable<NarrowPhaseSolver>();
+
+  NODE_TYPE node_type1 = o1->getNodeType();
+  NODE_TYPE node_type2 = o2->getNodeType();
+  const bool swap = (o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_BVH);
+
+  const auto func = swap ? looktable.collision_matrix[node_type2][node_type1]
+                         : looktable.collision_matrix[node_type1][node_type2];
+  if(!func)
+  {
+    std::cerr << "Warning: collision function between node type " << node_type1 << " and node type " << node_type2 << " is not supported"<< std::endl;
+    return 0;
+  }
+
+  num_threads = std::min<std::size_t>(detail::resolveNumThreads(num_threads), n);
+
+  // Each thread owns one solver for its contiguous range
+  std::vector<std::size_t> num_collisions(num_threads, 0);
+  detail::parallelForChunks(n, num_threads, [&](std::size_t begin, std::size_t end, unsigned int thread_id)
+  {
+    NarrowPhaseSolver nsolver;
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const Transform3<S>& pose1 = (tf1.size() == 1) ? tf1[0] : tf1[i];
+      const Transform3<S>& pose2 = tf2[i];
+
+      std::size_t num_contacts;
+      if(swap)
+        num_contacts = func(o2, pose2, o1, pose1, &nsolver, request, results[i]);
+      else
+        num_contacts = func(o1, pose1, o2, pose2, &nsolver, request, results[i]);
+
+      if(num_contacts > 0) ++num_collisions[thread_id];
+    }
+  });
+
+  std::size_t res = 0;
+  for(std::size_t count : num_collisions)
+    res += count;
+
+  return res;
+}
+
 //==============================================================================
 template <typename S>
 std::size_t collide(const CollisionObject<S>* o1, const CollisionObject<S>* o2,
@@ -194,6 +280,32 @@ std::size_t collide(
   }
 }
 
+//==============================================================================
+template <typename S>
+std::size_t collideBatch(
+    const CollisionGeometry<S>* o1,
+    const Eigen::aligned_vector<Transform3<S>>& tf1,
+    const CollisionGeometry<S>* o2,
+    const Eigen::aligned_vector<Transform3<S>>& tf2,
+    const CollisionRequest<S>& request,
+    std::vector<CollisionResult<S>>& results,
+    unsigned int num_threads)
+{
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    return collideBatch<S, detail::GJKSolver_libccd<S>>(
+          o1, tf1, o2, tf2, request, results, num_threads);
+  case GST_INDEP:
+    return collideBatch<S, detail::GJKSolver_indep<S>>(
+          o1, tf1, o2, tf2, request, results, num_threads);
+  default:
+    std::cerr << "Warning! Invalid GJK solver" << std::endl;
+    results.assign(tf2.size(), CollisionResult<S>());
+    return 0;
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -38,6 +38,8 @@
 #ifndef FCL_COLLISION_H
 #define FCL_COLLISION_H
 
+#include <vector>
+
 #include "fcl/narrowphase/collision_object.h"
 #include "fcl/narrowphase/collision_request.h"
 #include "fcl/narrowphase/collision_result.h"
@@ -63,6 +65,24 @@ std::size_t collide(const CollisionGeometry<S>* o1, const Transform3<S>& tf1,
                     const CollisionRequest<S>& request,
                     CollisionResult<S>& result);
 
+/// @brief Batched collision interface: collide geometry o1 with geometry o2
+/// once for every pair of poses (tf1[i], tf2[i]). tf1 may also hold a single
+/// pose that is then used for every query. The collision function and the
+/// narrowphase solver are looked up once for the whole batch. results[i]
+/// receives the result of the i-th query; the results are cleared rather than
+/// reallocated, so a results vector passed again to collideBatch() reuses its
+/// contact storage. The queries are split across num_threads threads (0 means
+/// one per hardware thread). Return value is the number of queries in
+/// collision.
+template <typename S>
+std::size_t collideBatch(const CollisionGeometry<S>* o1,
+                         const Eigen::aligned_vector<Transform3<S>>& tf1,
+                         const CollisionGeometry<S>* o2,
+                         const Eigen::aligned_vector<Transform3<S>>& tf2,
+                         const CollisionRequest<S>& request,
+                         std::vector<CollisionResult<S>>& results,
+                         unsigned int num_threads = 1);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/collision-inl.h"
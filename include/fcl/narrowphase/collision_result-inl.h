@@ -50,6 +50,7 @@ struct CollisionResult<double>;
 //==============================================================================
 template <typename S>
 CollisionResult<S>::CollisionResult()
+  : cached_gjk_guess(Vector3<S>::UnitX())
 {
   // Do nothing
 }
@@ -46,9 +46,17 @@
 #include "fcl/math/motion/interp_motion.h"
 #include "fcl/math/motion/screw_motion.h"
 #include "fcl/math/motion/spline_motion.h"
+#include "fcl/math/motion/tbv_motion_bound_visitor.h"
+
+#include "fcl/geometry/shape/halfspace.h"
+#include "fcl/geometry/shape/plane.h"
+
+#include "fcl/math/detail/project.h"
 
 #include "fcl/narrowphase/collision.h"
 #include "fcl/narrowphase/collision_result.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/detail/convexity_based_algorithm/minkowski_diff.h"
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 
 namespace fcl
@@ -153,14 +161,158 @@ S continuousCollideNaive(
     CollisionRequest<S> c_request;
     CollisionResult<S> c_result;
 
+    ++result.num_queries;
+    if(collide(o1, cur_tf1, o2, cur_tf2, c_request, c_result))
+    {
+      result.is_collide = true;
+      result.time_of_contact = t;
+      result.contact_tf1 = cur_tf1;
+      result.contact_tf2 = cur_tf2;
+      return t;
+    }
+  }
+
+  result.is_collide = false;
+  result.time_of_contact = S(1);
+  return result.time_of_contact;
+}
+
+namespace detail
+{
+
+//==============================================================================
+/// @brief Bound on the motion of any point of o along any direction. It is a
+/// bound on the speed, except for spline motions, whose bound only holds for
+/// the displacement over the remaining time [t, 1].
+template <typename S>
+S computeMotionBound(
+    const CollisionGeometry<S>* o,
+    const MotionBase<S>* motion)
+{
+  // bounding sphere of the object in its local frame
+  RSS<S> bv;
+  bv.axis.setIdentity();
+  bv.To = o->aabb_center;
+  bv.l[0] = 0;
+  bv.l[1] = 0;
+  bv.r = o->aabb_radius;
+
+  // bound the speed along the coordinate axes, which bounds the speed of any
+  // point of the object in any direction
+  S bound = 0;
+  for(int i = 0; i < 3; ++i)
+  {
+    const Vector3<S> n = Vector3<S>::Unit(i);
+    const TBVMotionBoundVisitor<RSS<S>> mb_visitor1(bv, n);
+    const TBVMotionBoundVisitor<RSS<S>> mb_visitor2(bv, -n);
+    const S b = std::max(std::max(motion->computeMotionBound(mb_visitor1),
+                                  motion->computeMotionBound(mb_visitor2)),
+                         (S)0);
+    bound += b * b;
+  }
+
+  return std::sqrt(bound);
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+S continuousCollideNaiveAdaptive(
+    const CollisionGeometry<S>* o1,
+    const MotionBase<S>* motion1,
+    const CollisionGeometry<S>* o2,
+    const MotionBase<S>* motion2,
+    const ContinuousCollisionRequest<S>& request,
+    ContinuousCollisionResult<S>& result)
+{
+  // The bounds use the bounding sphere of the objects
+  if(o1->aabb_radius <= 0 || o2->aabb_radius <= 0)
+  {
+    std::cerr << "Warning: the local AABB of the objects has not been computed, "
+              << "falling back to uniform stepping." << std::endl;
+    return continuousCollideNaive(o1, motion1, o2, motion2, request, result);
+  }
+
+  const bool spline1 = dynamic_cast<const SplineMotion<S>*>(motion1) != nullptr;
+  const bool spline2 = dynamic_cast<const SplineMotion<S>*>(motion2) != nullptr;
+
+  std::size_t n_iter = std::min(request.num_max_iterations, (std::size_t)ceil(1 / request.toc_err));
+  // near the contact the motion is sampled as densely as the naive method does
+  const S min_step = (n_iter > 1) ? 1 / (S) (n_iter - 1) : (S)1;
+  Transform3<S> cur_tf1, cur_tf2;
+
+  CollisionRequest<S> c_request;
+  c_request.gjk_solver_type = request.gjk_solver_type;
+  DistanceRequest<S> d_request;
+  d_request.gjk_solver_type = request.gjk_solver_type;
+
+  S t_prev = 0;
+  S t = 0;
+  while(true)
+  {
+    motion1->integrate(t);
+    motion2->integrate(t);
+    motion1->getCurrentTransform(cur_tf1);
+    motion2->getCurrentTransform(cur_tf2);
+
+    CollisionResult<S> c_result;
+    ++result.num_queries;
     if(collide(o1, cur_tf1, o2, cur_tf2, c_request, c_result))
     {
+      // the objects are free at t_prev, bisect towards the first contact
+      S t_free = t_prev;
+      while(t - t_free > request.toc_err)
+      {
+        const S t_mid = (t_free + t) / 2;
+        motion1->integrate(t_mid);
+        motion2->integrate(t_mid);
+        motion1->getCurrentTransform(cur_tf1);
+        motion2->getCurrentTransform(cur_tf2);
+
+        CollisionResult<S> mid_result;
+        ++result.num_queries;
+        if(collide(o1, cur_tf1, o2, cur_tf2, c_request, mid_result))
+          t = t_mid;
+        else
+          t_free = t_mid;
+      }
+
+      motion1->integrate(t);
+      motion2->integrate(t);
+      motion1->getCurrentTransform(cur_tf1);
+      motion2->getCurrentTransform(cur_tf2);
+
       result.is_collide = true;
       result.time_of_contact = t;
       result.contact_tf1 = cur_tf1;
       result.contact_tf2 = cur_tf2;
       return t;
     }
+
+    if(t >= 1)
+      break;
+
+    // No point of the objects moves farther than the motion bounds allow, so
+    // the objects can not touch before the distance is traversed.
+    DistanceResult<S> d_result;
+    ++result.num_queries;
+    const S dist = distance(o1, cur_tf1, o2, cur_tf2, d_request, d_result);
+    const S bound1 = detail::computeMotionBound(o1, motion1);
+    const S bound2 = detail::computeMotionBound(o2, motion2);
+    const S remaining = (spline1 ? bound1 : bound1 * (1 - t))
+        + (spline2 ? bound2 : bound2 * (1 - t));
+
+    if(dist > 0 && dist >= remaining)
+      break;
+
+    // The step is only enlarged from speed bounds
+    S step = min_step;
+    if(!spline1 && !spline2 && dist > 0 && dist > (bound1 + bound2) * min_step)
+      step = dist / (bound1 + bound2);
+
+    t_prev = t;
+    t = std::min(t + step, (S)1);
   }
 
   result.is_collide = false;
@@ -375,6 +527,260 @@ S continuousCollideConservativeAdvancement(
   }
 }
 
+namespace detail
+{
+
+//==============================================================================
+template <typename S>
+bool projectSimplexOrigin(
+    Vector3<S>* simplex,
+    unsigned int& rank,
+    const Vector3<S>& x,
+    Vector3<S>& v)
+{
+  Vector3<S> y[4];
+  for(unsigned int i = 0; i < rank; ++i)
+    y[i] = x - simplex[i];
+
+  typename Project<S>::ProjectResult res;
+  switch(rank)
+  {
+  case 1:
+    v = y[0];
+    return true;
+  case 2:
+    res = Project<S>::projectLineOrigin(y[0], y[1]);
+    break;
+  case 3:
+    res = Project<S>::projectTriangleOrigin(y[0], y[1], y[2]);
+    break;
+  default:
+    res = Project<S>::projectTetrahedraOrigin(y[0], y[1], y[2], y[3]);
+  }
+
+  // degenerated simplex
+  if(res.sqr_distance < 0)
+    return false;
+
+  v.setZero();
+  unsigned int new_rank = 0;
+  for(unsigned int i = 0; i < rank; ++i)
+  {
+    if(res.encode & (1 << i))
+    {
+      v += y[i] * res.parameterization[i];
+      simplex[new_rank++] = simplex[i];
+    }
+  }
+  rank = new_rank;
+
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+bool gjkRaycast(
+    const MinkowskiDiff<S>& shape,
+    const Vector3<S>& r,
+    S tolerance,
+    unsigned int max_iterations,
+    S& toc,
+    Vector3<S>& normal)
+{
+  toc = 0;
+  normal.setZero();
+
+  // x = toc * r is only advanced over separating planes, so toc is always a
+  // lower bound of the time of contact.
+  Vector3<S> x = Vector3<S>::Zero();
+  Vector3<S> simplex[4];
+  unsigned int rank = 0;
+  // the support functions expect unit directions
+  const Vector3<S> d0 = (r.squaredNorm() > 0) ? (-r).normalized().eval() : Vector3<S>::UnitX().eval();
+  Vector3<S> v = x - shape.support(d0);
+  const S tolerance2 = tolerance * tolerance;
+
+  for(unsigned int i = 0; i < max_iterations; ++i)
+  {
+    if(v.squaredNorm() <= tolerance2)
+      return true;
+
+    const Vector3<S> p = shape.support(v.normalized());
+    const S vw = v.dot(x - p);
+    bool advanced = false;
+    if(vw > 0)
+    {
+      const S vr = v.dot(r);
+      if(vr >= 0)
+        return false;
+
+      toc -= vw / vr;
+      if(toc > 1)
+        return false;
+
+      x = r * toc;
+      normal = v;
+      advanced = true;
+    }
+
+    bool duplicated = false;
+    for(unsigned int j = 0; j < rank; ++j)
+    {
+      if((simplex[j] - p).squaredNorm() <= tolerance2)
+        duplicated = true;
+    }
+
+    if(!duplicated)
+      simplex[rank++] = p;
+    else if(!advanced)
+      return true; // no more progress, x is on the boundary of the difference
+
+    while(!projectSimplexOrigin(simplex, rank, x, v))
+      --rank;
+
+    // x is inside a tetrahedron spanned by points of the difference
+    if(rank == 4)
+      return true;
+  }
+
+  // toc is conservative, so report the contact rather than missing it
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+bool raycastPlaneShape(
+    const CollisionGeometry<S>* o1,
+    const Transform3<S>& tf1,
+    const CollisionGeometry<S>* o2,
+    const Transform3<S>& tf2,
+    const Vector3<S>& v,
+    S& toc,
+    Vector3<S>& normal)
+{
+  Vector3<S> n;
+  S d;
+  const bool is_halfspace = (o1->getNodeType() == GEOM_HALFSPACE);
+  if(is_halfspace)
+  {
+    const Halfspace<S> new_s1 = transform(*static_cast<const Halfspace<S>*>(o1), tf1);
+    n = new_s1.n;
+    d = new_s1.d;
+  }
+  else
+  {
+    const Plane<S> new_s1 = transform(*static_cast<const Plane<S>*>(o1), tf1);
+    n = new_s1.n;
+    d = new_s1.d;
+  }
+
+  const ShapeBase<S>* s2 = static_cast<const ShapeBase<S>*>(o2);
+  const Vector3<S> local_n = tf2.linear().transpose() * n;
+  const S lower = n.dot(tf2 * getSupport(s2, (-local_n).eval())) - d;
+  const S upper = n.dot(tf2 * getSupport(s2, local_n)) - d;
+  const S vn = n.dot(v);
+
+  toc = 0;
+  normal = n;
+  if(lower <= 0 && (is_halfspace || upper >= 0))
+    return true;
+
+  if(lower > 0)
+  {
+    if(vn >= 0)
+      return false;
+    toc = -lower / vn;
+  }
+  else
+  {
+    if(vn <= 0)
+      return false;
+    toc = -upper / vn;
+    normal = -n;
+  }
+
+  return toc <= 1;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+S continuousCollideRayShooting(
+    const CollisionGeometry<S>* o1,
+    const TranslationMotion<S>* motion1,
+    const CollisionGeometry<S>* o2,
+    const TranslationMotion<S>* motion2,
+    const ContinuousCollisionRequest<S>& request,
+    ContinuousCollisionResult<S>& result)
+{
+  const NODE_TYPE node_type1 = o1->getNodeType();
+  const NODE_TYPE node_type2 = o2->getNodeType();
+  const bool unbounded1 = (node_type1 == GEOM_PLANE || node_type1 == GEOM_HALFSPACE);
+  const bool unbounded2 = (node_type2 == GEOM_PLANE || node_type2 == GEOM_HALFSPACE);
+
+  // two planes (or halfspaces) have no support functions
+  if(unbounded1 && unbounded2)
+    return continuousCollideNaive<S>(o1, motion1, o2, motion2, request, result);
+
+  motion1->integrate(0);
+  motion2->integrate(0);
+  Transform3<S> tf1;
+  Transform3<S> tf2;
+  motion1->getCurrentTransform(tf1);
+  motion2->getCurrentTransform(tf2);
+
+  const Vector3<S> v1 = motion1->getVelocity();
+  const Vector3<S> v2 = motion2->getVelocity();
+
+  S toc;
+  Vector3<S> normal;
+  if(unbounded1)
+  {
+    result.is_collide = detail::raycastPlaneShape(o1, tf1, o2, tf2, (v2 - v1).eval(), toc, normal);
+  }
+  else if(unbounded2)
+  {
+    result.is_collide = detail::raycastPlaneShape(o2, tf2, o1, tf1, (v1 - v2).eval(), toc, normal);
+    normal = -normal;
+  }
+  else
+  {
+    // The objects touch at time t iff t * (v2 - v1) lies in the Minkowski
+    // difference o1 - o2 at time 0, which is cast in the frame of o1.
+    detail::MinkowskiDiff<S> shape;
+    shape.shapes[0] = static_cast<const ShapeBase<S>*>(o1);
+    shape.shapes[1] = static_cast<const ShapeBase<S>*>(o2);
+    shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
+    shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
+
+    const detail::GJKSolver_indep<S> solver;
+    const Vector3<S> r = tf1.linear().transpose() * (v2 - v1);
+    result.is_collide = detail::gjkRaycast(shape, r, solver.gjk_tolerance, (unsigned int)solver.gjk_max_iterations, toc, normal);
+    normal = tf1.linear() * normal;
+  }
+
+  if(normal.squaredNorm() > 0)
+    normal.normalize();
+
+  result.contact_normal = normal;
+  if(!result.is_collide)
+  {
+    result.time_of_contact = 1;
+    return result.time_of_contact;
+  }
+
+  result.time_of_contact = toc;
+  motion1->integrate(toc);
+  motion2->integrate(toc);
+  motion1->getCurrentTransform(tf1);
+  motion2->getCurrentTransform(tf2);
+  result.contact_tf1 = tf1;
+  result.contact_tf2 = tf2;
+
+  return result.time_of_contact;
+}
+
 //==============================================================================
 template <typename S>
 S continuousCollide(
@@ -388,6 +794,13 @@ S continuousCollide(
   switch(request.ccd_solver_type)
   {
   case CCDC_NAIVE:
+    if(request.enable_adaptive_stepping)
+    {
+      return continuousCollideNaiveAdaptive(o1, motion1,
+                                            o2, motion2,
+                                            request,
+                                            result);
+    }
     return continuousCollideNaive(o1, motion1,
                                   o2, motion2,
                                   request,
@@ -402,7 +815,9 @@ S continuousCollide(
   case CCDC_RAY_SHOOTING:
     if(o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_GEOM && request.ccd_motion_type == CCDM_TRANS)
     {
-
+      return continuousCollideRayShooting(o1, (const TranslationMotion<S>*)motion1,
+                                          o2, (const TranslationMotion<S>*)motion2,
+                                          request, result);
     }
     else
       std::cerr << "Warning! Invalid continuous collision setting" << std::endl;
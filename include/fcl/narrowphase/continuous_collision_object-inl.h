@@ -51,7 +51,7 @@ class ContinuousCollisionObject<double>;
 template <typename S>
 ContinuousCollisionObject<S>::ContinuousCollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_)
-  : cgeom(cgeom_), cgeom_const(cgeom_)
+  : cgeom(cgeom_), cgeom_const(cgeom_), user_data(nullptr)
 {
   // Do nothing
 }
@@ -61,9 +61,10 @@ template <typename S>
 ContinuousCollisionObject<S>::ContinuousCollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_,
     const std::shared_ptr<MotionBase<S>>& motion_)
-  : cgeom(cgeom_), cgeom_const(cgeom), motion(motion_)
+  : cgeom(cgeom_), cgeom_const(cgeom), motion(motion_), user_data(nullptr)
 {
-  // Do nothing
+  cgeom->computeLocalAABB();
+  computeAABB();
 }
 
 //==============================================================================
@@ -54,12 +54,14 @@ ContinuousCollisionRequest<S>::ContinuousCollisionRequest(
     S toc_err_,
     CCDMotionType ccd_motion_type_,
     GJKSolverType gjk_solver_type_,
-    CCDSolverType ccd_solver_type_)
+    CCDSolverType ccd_solver_type_,
+    bool enable_adaptive_stepping_)
   : num_max_iterations(num_max_iterations_),
     toc_err(toc_err_),
     ccd_motion_type(ccd_motion_type_),
     gjk_solver_type(gjk_solver_type_),
-    ccd_solver_type(ccd_solver_type_)
+    ccd_solver_type(ccd_solver_type_),
+    enable_adaptive_stepping(enable_adaptive_stepping_)
 {
   // Do nothing
 }
@@ -64,12 +64,19 @@ struct ContinuousCollisionRequest
 
   /// @brief ccd solver type
   CCDSolverType ccd_solver_type;
+
+  /// @brief whether CCDC_NAIVE skips the time intervals that are proven
+  /// collision free by the distance and the motion bounds, instead of sampling
+  /// the motion uniformly. Requires the local AABBs of the objects to be
+  /// computed.
+  bool enable_adaptive_stepping;
   
   ContinuousCollisionRequest(std::size_t num_max_iterations_ = 10,
                              S toc_err_ = 0.0001,
                              CCDMotionType ccd_motion_type_ = CCDM_TRANS,
                              GJKSolverType gjk_solver_type_ = GST_LIBCCD,
-                             CCDSolverType ccd_solver_type_ = CCDC_NAIVE);
+                             CCDSolverType ccd_solver_type_ = CCDC_NAIVE,
+                             bool enable_adaptive_stepping_ = false);
   
 };
 
@@ -50,7 +50,8 @@ struct ContinuousCollisionResult<double>;
 //==============================================================================
 template <typename S>
 ContinuousCollisionResult<S>::ContinuousCollisionResult()
-  : is_collide(false), time_of_contact(1.0)
+  : is_collide(false), time_of_contact(1.0), contact_normal(Vector3<S>::Zero()),
+    num_queries(0)
 {
   // Do nothing
 }
@@ -56,6 +56,14 @@ struct ContinuousCollisionResult
   Transform3<S> contact_tf1;
 
   Transform3<S> contact_tf2;
+
+  /// @brief contact normal, pointing from the first object to the second, in
+  /// the world frame. Only computed by CCDC_RAY_SHOOTING, zero otherwise.
+  Vector3<S> contact_normal;
+
+  /// @brief number of discrete collision and distance queries. Only counted
+  /// by CCDC_NAIVE, zero otherwise.
+  std::size_t num_queries;
   
   ContinuousCollisionResult();
 
@@ -42,6 +42,7 @@
 
 #include "fcl/common/unused.h"
 #include "fcl/common/warning.h"
+#include "fcl/common/detail/object_pool.h"
 
 namespace fcl
 {
@@ -449,6 +450,214 @@ static int doSimplex(ccd_simplex_t *simplex, ccd_vec3_t *dir)
   }
 }
 
+/** The polytope functions below replace ccdPtAdd*(), ccdPtDel*() and
+ *  ccdPtDestroy() from libccd. They keep the same bookkeeping but take the
+ *  polytope elements from per-thread pools, so repeated EPA runs do not touch
+ *  the heap once the pools are warm. */
+template <typename T>
+static T* ptAlloc()
+{
+    return ObjectPool<T>::threadLocal().create();
+}
+
+template <typename T>
+static void ptFree(T* el)
+{
+    ObjectPool<T>::threadLocal().destroy(el);
+}
+
+static void ptNearestUpdate(ccd_pt_t *pt, ccd_pt_el_t *el)
+{
+    if (ccdEq(pt->nearest_dist, el->dist)){
+        if (el->type < pt->nearest_type){
+            pt->nearest = el;
+            pt->nearest_dist = el->dist;
+            pt->nearest_type = el->type;
+        }
+    }else if (el->dist < pt->nearest_dist){
+        pt->nearest = el;
+        pt->nearest_dist = el->dist;
+        pt->nearest_type = el->type;
+    }
+}
+
+static ccd_pt_vertex_t *ptAddVertex(ccd_pt_t *pt, const ccd_support_t *v)
+{
+    ccd_pt_vertex_t *vert = ptAlloc<ccd_pt_vertex_t>();
+
+    vert->type = CCD_PT_VERTEX;
+    ccdSupportCopy(&vert->v, v);
+
+    vert->dist = ccdVec3Len2(&vert->v.v);
+    ccdVec3Copy(&vert->witness, &vert->v.v);
+
+    ccdListInit(&vert->edges);
+
+    // add vertex to list
+    ccdListAppend(&pt->vertices, &vert->list);
+
+    // update position in heap
+    ptNearestUpdate(pt, (ccd_pt_el_t *)vert);
+
+    return vert;
+}
+
+static ccd_pt_edge_t *ptAddEdge(ccd_pt_t *pt, ccd_pt_vertex_t *v1,
+                                ccd_pt_vertex_t *v2)
+{
+    const ccd_vec3_t *a, *b;
+    ccd_pt_edge_t *edge = ptAlloc<ccd_pt_edge_t>();
+
+    edge->type = CCD_PT_EDGE;
+    edge->vertex[0] = v1;
+    edge->vertex[1] = v2;
+    edge->faces[0] = edge->faces[1] = NULL;
+
+    a = &edge->vertex[0]->v.v;
+    b = &edge->vertex[1]->v.v;
+    edge->dist = ccdVec3PointSegmentDist2(ccd_vec3_origin, a, b, &edge->witness);
+
+    ccdListAppend(&edge->vertex[0]->edges, &edge->vertex_list[0]);
+    ccdListAppend(&edge->vertex[1]->edges, &edge->vertex_list[1]);
+
+    ccdListAppend(&pt->edges, &edge->list);
+
+    // update position in heap
+    ptNearestUpdate(pt, (ccd_pt_el_t *)edge);
+
+    return edge;
+}
+
+static ccd_pt_face_t *ptAddFace(ccd_pt_t *pt, ccd_pt_edge_t *e1,
+                                ccd_pt_edge_t *e2,
+                                ccd_pt_edge_t *e3)
+{
+    const ccd_vec3_t *a, *b, *c;
+    ccd_pt_face_t *face;
+    ccd_pt_edge_t *e;
+    size_t i;
+
+    face = ptAlloc<ccd_pt_face_t>();
+
+    face->type = CCD_PT_FACE;
+    face->edge[0] = e1;
+    face->edge[1] = e2;
+    face->edge[2] = e3;
+
+    // obtain triplet of vertices
+    a = &face->edge[0]->vertex[0]->v.v;
+    b = &face->edge[0]->vertex[1]->v.v;
+    e = face->edge[1];
+    if (e->vertex[0] != face->edge[0]->vertex[0]
+            && e->vertex[0] != face->edge[0]->vertex[1]){
+        c = &e->vertex[0]->v.v;
+    }else{
+        c = &e->vertex[1]->v.v;
+    }
+    face->dist = ccdVec3PointTriDist2(ccd_vec3_origin, a, b, c, &face->witness);
+
+    for (i = 0; i < 3; i++){
+        if (face->edge[i]->faces[0] == NULL){
+            face->edge[i]->faces[0] = face;
+        }else{
+            face->edge[i]->faces[1] = face;
+        }
+    }
+
+    ccdListAppend(&pt->faces, &face->list);
+
+    // update position in heap
+    ptNearestUpdate(pt, (ccd_pt_el_t *)face);
+
+    return face;
+}
+
+static int ptDelVertex(ccd_pt_t *pt, ccd_pt_vertex_t *v)
+{
+    // test if any edge is connected to this vertex
+    if (!ccdListEmpty(&v->edges))
+        return -1;
+
+    // delete vertex from main list
+    ccdListDel(&v->list);
+
+    if ((void *)pt->nearest == (void *)v){
+        pt->nearest = NULL;
+    }
+
+    ptFree(v);
+    return 0;
+}
+
+static int ptDelEdge(ccd_pt_t *pt, ccd_pt_edge_t *e)
+{
+    // text if any face is connected to this edge (faces[] is always
+    // aligned to lower indices)
+    if (e->faces[0] != NULL)
+        return -1;
+
+    // disconnect edge from lists of edges in vertex struct
+    ccdListDel(&e->vertex_list[0]);
+    ccdListDel(&e->vertex_list[1]);
+
+    // disconnect edge from main list
+    ccdListDel(&e->list);
+
+    if ((void *)pt->nearest == (void *)e){
+        pt->nearest = NULL;
+    }
+
+    ptFree(e);
+    return 0;
+}
+
+static int ptDelFace(ccd_pt_t *pt, ccd_pt_face_t *f)
+{
+    ccd_pt_edge_t *e;
+    size_t i;
+
+    // remove face from edges' recerence lists
+    for (i = 0; i < 3; i++){
+        e = f->edge[i];
+        if (e->faces[0] == f){
+            e->faces[0] = e->faces[1];
+        }
+        e->faces[1] = NULL;
+    }
+
+    // remove face from list of all faces
+    ccdListDel(&f->list);
+
+    if ((void *)pt->nearest == (void *)f){
+        pt->nearest = NULL;
+    }
+
+    ptFree(f);
+    return 0;
+}
+
+static void ptDestroy(ccd_pt_t *pt)
+{
+    ccd_pt_face_t *f, *f2;
+    ccd_pt_edge_t *e, *e2;
+    ccd_pt_vertex_t *v, *v2;
+
+    // first delete all faces
+    ccdListForEachEntrySafe(&pt->faces, f, ccd_pt_face_t, f2, ccd_pt_face_t, list){
+        ptDelFace(pt, f);
+    }
+
+    // delete all edges
+    ccdListForEachEntrySafe(&pt->edges, e, ccd_pt_edge_t, e2, ccd_pt_edge_t, list){
+        ptDelEdge(pt, e);
+    }
+
+    // delete all vertices
+    ccdListForEachEntrySafe(&pt->vertices, v, ccd_pt_vertex_t, v2, ccd_pt_vertex_t, list){
+        ptDelVertex(pt, v);
+    }
+}
+
 /** Transforms simplex to polytope, two vertices required */
 static int simplexToPolytope2(const void *obj1, const void *obj2,
                               const ccd_t *ccd,
@@ -508,9 +717,9 @@ static int simplexToPolytope2(const void *obj1, const void *obj2,
 
     goto simplexToPolytope2_not_touching_contact;
 simplexToPolytope2_touching_contact:
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, b);
-    *nearest = (ccd_pt_el_t *)ccdPtAddEdge(pt, v[0], v[1]);
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, b);
+    *nearest = (ccd_pt_el_t *)ptAddEdge(pt, v[0], v[1]);
     if (*nearest == NULL)
         return -2;
 
@@ -518,37 +727,37 @@ simplexToPolytope2_touching_contact:
 
 simplexToPolytope2_not_touching_contact:
     // form polyhedron
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, &supp[0]);
-    v[2] = ccdPtAddVertex(pt, b);
-    v[3] = ccdPtAddVertex(pt, &supp[1]);
-    v[4] = ccdPtAddVertex(pt, &supp[2]);
-    v[5] = ccdPtAddVertex(pt, &supp[3]);
-
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[3]);
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-
-    e[4] = ccdPtAddEdge(pt, v[4], v[0]);
-    e[5] = ccdPtAddEdge(pt, v[4], v[1]);
-    e[6] = ccdPtAddEdge(pt, v[4], v[2]);
-    e[7] = ccdPtAddEdge(pt, v[4], v[3]);
-
-    e[8]  = ccdPtAddEdge(pt, v[5], v[0]);
-    e[9]  = ccdPtAddEdge(pt, v[5], v[1]);
-    e[10] = ccdPtAddEdge(pt, v[5], v[2]);
-    e[11] = ccdPtAddEdge(pt, v[5], v[3]);
-
-    if (ccdPtAddFace(pt, e[4], e[5], e[0]) == NULL
-            || ccdPtAddFace(pt, e[5], e[6], e[1]) == NULL
-            || ccdPtAddFace(pt, e[6], e[7], e[2]) == NULL
-            || ccdPtAddFace(pt, e[7], e[4], e[3]) == NULL
-
-            || ccdPtAddFace(pt, e[8],  e[9],  e[0]) == NULL
-            || ccdPtAddFace(pt, e[9],  e[10], e[1]) == NULL
-            || ccdPtAddFace(pt, e[10], e[11], e[2]) == NULL
-            || ccdPtAddFace(pt, e[11], e[8],  e[3]) == NULL){
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, &supp[0]);
+    v[2] = ptAddVertex(pt, b);
+    v[3] = ptAddVertex(pt, &supp[1]);
+    v[4] = ptAddVertex(pt, &supp[2]);
+    v[5] = ptAddVertex(pt, &supp[3]);
+
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[3]);
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+
+    e[4] = ptAddEdge(pt, v[4], v[0]);
+    e[5] = ptAddEdge(pt, v[4], v[1]);
+    e[6] = ptAddEdge(pt, v[4], v[2]);
+    e[7] = ptAddEdge(pt, v[4], v[3]);
+
+    e[8]  = ptAddEdge(pt, v[5], v[0]);
+    e[9]  = ptAddEdge(pt, v[5], v[1]);
+    e[10] = ptAddEdge(pt, v[5], v[2]);
+    e[11] = ptAddEdge(pt, v[5], v[3]);
+
+    if (ptAddFace(pt, e[4], e[5], e[0]) == NULL
+            || ptAddFace(pt, e[5], e[6], e[1]) == NULL
+            || ptAddFace(pt, e[6], e[7], e[2]) == NULL
+            || ptAddFace(pt, e[7], e[4], e[3]) == NULL
+
+            || ptAddFace(pt, e[8],  e[9],  e[0]) == NULL
+            || ptAddFace(pt, e[9],  e[10], e[1]) == NULL
+            || ptAddFace(pt, e[10], e[11], e[2]) == NULL
+            || ptAddFace(pt, e[11], e[8],  e[3]) == NULL){
         return -2;
     }
 
@@ -594,13 +803,13 @@ static int simplexToPolytope3(const void *obj1, const void *obj2,
     // check if face isn't already on edge of minkowski sum and thus we
     // have touching contact
     if (ccdIsZero(dist) || ccdIsZero(dist2)){
-        v[0] = ccdPtAddVertex(pt, a);
-        v[1] = ccdPtAddVertex(pt, b);
-        v[2] = ccdPtAddVertex(pt, c);
-        e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-        e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-        e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-        *nearest = (ccd_pt_el_t *)ccdPtAddFace(pt, e[0], e[1], e[2]);
+        v[0] = ptAddVertex(pt, a);
+        v[1] = ptAddVertex(pt, b);
+        v[2] = ptAddVertex(pt, c);
+        e[0] = ptAddEdge(pt, v[0], v[1]);
+        e[1] = ptAddEdge(pt, v[1], v[2]);
+        e[2] = ptAddEdge(pt, v[2], v[0]);
+        *nearest = (ccd_pt_el_t *)ptAddFace(pt, e[0], e[1], e[2]);
         if (*nearest == NULL)
             return -2;
 
@@ -608,31 +817,31 @@ static int simplexToPolytope3(const void *obj1, const void *obj2,
     }
 
     // form polyhedron
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, b);
-    v[2] = ccdPtAddVertex(pt, c);
-    v[3] = ccdPtAddVertex(pt, &d);
-    v[4] = ccdPtAddVertex(pt, &d2);
-
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-    e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-    e[5] = ccdPtAddEdge(pt, v[3], v[2]);
-
-    e[6] = ccdPtAddEdge(pt, v[4], v[0]);
-    e[7] = ccdPtAddEdge(pt, v[4], v[1]);
-    e[8] = ccdPtAddEdge(pt, v[4], v[2]);
-
-    if (ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-            || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-            || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL
-
-            || ccdPtAddFace(pt, e[6], e[7], e[0]) == NULL
-            || ccdPtAddFace(pt, e[7], e[8], e[1]) == NULL
-            || ccdPtAddFace(pt, e[8], e[6], e[2]) == NULL){
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, b);
+    v[2] = ptAddVertex(pt, c);
+    v[3] = ptAddVertex(pt, &d);
+    v[4] = ptAddVertex(pt, &d2);
+
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[0]);
+
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+    e[4] = ptAddEdge(pt, v[3], v[1]);
+    e[5] = ptAddEdge(pt, v[3], v[2]);
+
+    e[6] = ptAddEdge(pt, v[4], v[0]);
+    e[7] = ptAddEdge(pt, v[4], v[1]);
+    e[8] = ptAddEdge(pt, v[4], v[2]);
+
+    if (ptAddFace(pt, e[3], e[4], e[0]) == NULL
+            || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+            || ptAddFace(pt, e[5], e[3], e[2]) == NULL
+
+            || ptAddFace(pt, e[6], e[7], e[0]) == NULL
+            || ptAddFace(pt, e[7], e[8], e[1]) == NULL
+            || ptAddFace(pt, e[8], e[6], e[2]) == NULL){
         return -2;
     }
 
@@ -692,24 +901,23 @@ static int simplexToPolytope4(const void *obj1, const void *obj2,
 
     // no touching contact - simply create tetrahedron
     for (i = 0; i < 4; i++){
-        v[i] = ccdPtAddVertex(pt, ccdSimplexPoint(simplex, i));
+        v[i] = ptAddVertex(pt, ccdSimplexPoint(simplex, i));
     }
 
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-    e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-    e[5] = ccdPtAddEdge(pt, v[3], v[2]);
-
-    // ccdPtAdd*() functions return NULL either if the memory allocation
-    // failed of if any of the input pointers are NULL, so the bad
-    // allocation can be checked by the last calls of ccdPtAddFace()
-    // because the rest of the bad allocations eventually "bubble up" here
-    if (ccdPtAddFace(pt, e[0], e[1], e[2]) == NULL
-            || ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-            || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-            || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL){
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[0]);
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+    e[4] = ptAddEdge(pt, v[3], v[1]);
+    e[5] = ptAddEdge(pt, v[3], v[2]);
+
+    // ccdPtAdd*() functions of libccd return NULL if the memory allocation
+    // failed; the pooled ptAdd*() throw instead, so these checks only keep
+    // the original error path
+    if (ptAddFace(pt, e[0], e[1], e[2]) == NULL
+            || ptAddFace(pt, e[3], e[4], e[0]) == NULL
+            || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+            || ptAddFace(pt, e[5], e[3], e[2]) == NULL){
         return -2;
     }
 
@@ -785,35 +993,35 @@ static int expandPolytope(ccd_pt_t *pt, ccd_pt_el_t *el,
             }
 
 
-            v[4] = ccdPtAddVertex(pt, newv);
+            v[4] = ptAddVertex(pt, newv);
 
-            ccdPtDelFace(pt, f[0]);
+            ptDelFace(pt, f[0]);
             if (f[1]){
-                ccdPtDelFace(pt, f[1]);
-                ccdPtDelEdge(pt, (ccd_pt_edge_t *)el);
+                ptDelFace(pt, f[1]);
+                ptDelEdge(pt, (ccd_pt_edge_t *)el);
             }
 
-            e[4] = ccdPtAddEdge(pt, v[4], v[2]);
-            e[5] = ccdPtAddEdge(pt, v[4], v[0]);
-            e[6] = ccdPtAddEdge(pt, v[4], v[1]);
+            e[4] = ptAddEdge(pt, v[4], v[2]);
+            e[5] = ptAddEdge(pt, v[4], v[0]);
+            e[6] = ptAddEdge(pt, v[4], v[1]);
             if (f[1])
-                e[7] = ccdPtAddEdge(pt, v[4], v[3]);
+                e[7] = ptAddEdge(pt, v[4], v[3]);
 
 
-            if (ccdPtAddFace(pt, e[1], e[4], e[6]) == NULL
-                    || ccdPtAddFace(pt, e[0], e[6], e[5]) == NULL){
+            if (ptAddFace(pt, e[1], e[4], e[6]) == NULL
+                    || ptAddFace(pt, e[0], e[6], e[5]) == NULL){
                 return -2;
             }
 
             if (f[1]){
                 FCL_SUPPRESS_MAYBE_UNINITIALIZED_BEGIN
-                if (ccdPtAddFace(pt, e[3], e[5], e[7]) == NULL
-                        || ccdPtAddFace(pt, e[4], e[7], e[2]) == NULL){
+                if (ptAddFace(pt, e[3], e[5], e[7]) == NULL
+                        || ptAddFace(pt, e[4], e[7], e[2]) == NULL){
                     return -2;
                 }
                 FCL_SUPPRESS_MAYBE_UNINITIALIZED_END
             }else{
-                if (ccdPtAddFace(pt, e[4], e[5], (ccd_pt_edge_t *)el) == NULL)
+                if (ptAddFace(pt, e[4], e[5], (ccd_pt_edge_t *)el) == NULL)
                     return -2;
             }
         }
@@ -838,17 +1046,17 @@ static int expandPolytope(ccd_pt_t *pt, ccd_pt_el_t *el,
             v[2] = v[3];
 
         // remove triangle face
-        ccdPtDelFace(pt, (ccd_pt_face_t *)el);
+        ptDelFace(pt, (ccd_pt_face_t *)el);
 
         // expand triangle to tetrahedron
-        v[3] = ccdPtAddVertex(pt, newv);
-        e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-        e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-        e[5] = ccdPtAddEdge(pt, v[3], v[2]);
-
-        if (ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-                || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-                || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL){
+        v[3] = ptAddVertex(pt, newv);
+        e[3] = ptAddEdge(pt, v[3], v[0]);
+        e[4] = ptAddEdge(pt, v[3], v[1]);
+        e[5] = ptAddEdge(pt, v[3], v[2]);
+
+        if (ptAddFace(pt, e[3], e[4], e[0]) == NULL
+                || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+                || ptAddFace(pt, e[5], e[3], e[2]) == NULL){
             return -2;
         }
     }
@@ -1253,29 +1461,19 @@ static int penEPAPosClosest(const ccd_pt_t *pt, const ccd_pt_el_t *nearest,
     FCL_UNUSED(nearest);
 
     ccd_pt_vertex_t *v;
-    ccd_pt_vertex_t **vs;
-    size_t i, len;
-    // compute median
-    len = 0;
+    ccd_pt_vertex_t *closest = NULL;
+    // find the vertex closest to the origin; only the minimum is needed, so a
+    // linear scan replaces sorting a heap-allocated copy of the vertex list
     ccdListForEachEntry(&pt->vertices, v, ccd_pt_vertex_t, list){
-        len++;
+        if (closest == NULL || penEPAPosCmp(&v, &closest) < 0)
+            closest = v;
     }
 
-    vs = CCD_ALLOC_ARR(ccd_pt_vertex_t*, len);
-    if (vs == NULL)
+    if (closest == NULL)
         return -1;
 
-    i = 0;
-    ccdListForEachEntry(&pt->vertices, v, ccd_pt_vertex_t, list){
-        vs[i++] = v;
-    }
-
-    qsort(vs, len, sizeof(ccd_pt_vertex_t*), penEPAPosCmp);
-
-    ccdVec3Copy(p1, &vs[0]->v.v1);
-    ccdVec3Copy(p2, &vs[0]->v.v2);
-
-    free(vs);
+    ccdVec3Copy(p1, &closest->v.v1);
+    ccdVec3Copy(p2, &closest->v.v2);
 
     return 0;
 }
@@ -1316,7 +1514,7 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, co
       depth = -CCD_ONE;
     }
 
-    ccdPtDestroy(&polytope);
+    ptDestroy(&polytope);
 
     return depth;
   }
@@ -1819,7 +2017,7 @@ GJKCenterFunction GJKInitializer<S, Cylinder<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Cylinder<S>>::createGJKObject(const Cylinder<S>& s, const Transform3<S>& tf)
 {
-  ccd_cyl_t* o = new ccd_cyl_t;
+  ccd_cyl_t* o = ObjectPool<ccd_cyl_t>::threadLocal().create();
   cylToGJK(s, tf, o);
   return o;
 }
@@ -1827,8 +2025,7 @@ void* GJKInitializer<S, Cylinder<S>>::createGJKObject(const Cylinder<S>& s, cons
 template <typename S>
 void GJKInitializer<S, Cylinder<S>>::deleteGJKObject(void* o_)
 {
-  ccd_cyl_t* o = static_cast<ccd_cyl_t*>(o_);
-  delete o;
+  ObjectPool<ccd_cyl_t>::threadLocal().destroy(static_cast<ccd_cyl_t*>(o_));
 }
 
 template <typename S>
@@ -1846,7 +2043,7 @@ GJKCenterFunction GJKInitializer<S, Sphere<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Sphere<S>>::createGJKObject(const Sphere<S>& s, const Transform3<S>& tf)
 {
-  ccd_sphere_t* o = new ccd_sphere_t;
+  ccd_sphere_t* o = ObjectPool<ccd_sphere_t>::threadLocal().create();
   sphereToGJK(s, tf, o);
   return o;
 }
@@ -1854,8 +2051,7 @@ void* GJKInitializer<S, Sphere<S>>::createGJKObject(const Sphere<S>& s, const Tr
 template <typename S>
 void GJKInitializer<S, Sphere<S>>::deleteGJKObject(void* o_)
 {
-  ccd_sphere_t* o = static_cast<ccd_sphere_t*>(o_);
-  delete o;
+  ObjectPool<ccd_sphere_t>::threadLocal().destroy(static_cast<ccd_sphere_t*>(o_));
 }
 
 template <typename S>
@@ -1873,7 +2069,7 @@ GJKCenterFunction GJKInitializer<S, Ellipsoid<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Ellipsoid<S>>::createGJKObject(const Ellipsoid<S>& s, const Transform3<S>& tf)
 {
-  ccd_ellipsoid_t* o = new ccd_ellipsoid_t;
+  ccd_ellipsoid_t* o = ObjectPool<ccd_ellipsoid_t>::threadLocal().create();
   ellipsoidToGJK(s, tf, o);
   return o;
 }
@@ -1881,8 +2077,7 @@ void* GJKInitializer<S, Ellipsoid<S>>::createGJKObject(const Ellipsoid<S>& s, co
 template <typename S>
 void GJKInitializer<S, Ellipsoid<S>>::deleteGJKObject(void* o_)
 {
-  ccd_ellipsoid_t* o = static_cast<ccd_ellipsoid_t*>(o_);
-  delete o;
+  ObjectPool<ccd_ellipsoid_t>::threadLocal().destroy(static_cast<ccd_ellipsoid_t*>(o_));
 }
 
 template <typename S>
@@ -1900,7 +2095,7 @@ GJKCenterFunction GJKInitializer<S, Box<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Box<S>>::createGJKObject(const Box<S>& s, const Transform3<S>& tf)
 {
-  ccd_box_t* o = new ccd_box_t;
+  ccd_box_t* o = ObjectPool<ccd_box_t>::threadLocal().create();
   boxToGJK(s, tf, o);
   return o;
 }
@@ -1908,8 +2103,7 @@ void* GJKInitializer<S, Box<S>>::createGJKObject(const Box<S>& s, const Transfor
 template <typename S>
 void GJKInitializer<S, Box<S>>::deleteGJKObject(void* o_)
 {
-  ccd_box_t* o = static_cast<ccd_box_t*>(o_);
-  delete o;
+  ObjectPool<ccd_box_t>::threadLocal().destroy(static_cast<ccd_box_t*>(o_));
 }
 
 template <typename S>
@@ -1927,7 +2121,7 @@ GJKCenterFunction GJKInitializer<S, Capsule<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Capsule<S>>::createGJKObject(const Capsule<S>& s, const Transform3<S>& tf)
 {
-  ccd_cap_t* o = new ccd_cap_t;
+  ccd_cap_t* o = ObjectPool<ccd_cap_t>::threadLocal().create();
   capToGJK(s, tf, o);
   return o;
 }
@@ -1935,8 +2129,7 @@ void* GJKInitializer<S, Capsule<S>>::createGJKObject(const Capsule<S>& s, const
 template <typename S>
 void GJKInitializer<S, Capsule<S>>::deleteGJKObject(void* o_)
 {
-  ccd_cap_t* o = static_cast<ccd_cap_t*>(o_);
-  delete o;
+  ObjectPool<ccd_cap_t>::threadLocal().destroy(static_cast<ccd_cap_t*>(o_));
 }
 
 template <typename S>
@@ -1954,7 +2147,7 @@ GJKCenterFunction GJKInitializer<S, Cone<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Cone<S>>::createGJKObject(const Cone<S>& s, const Transform3<S>& tf)
 {
-  ccd_cone_t* o = new ccd_cone_t;
+  ccd_cone_t* o = ObjectPool<ccd_cone_t>::threadLocal().create();
   coneToGJK(s, tf, o);
   return o;
 }
@@ -1962,8 +2155,7 @@ void* GJKInitializer<S, Cone<S>>::createGJKObject(const Cone<S>& s, const Transf
 template <typename S>
 void GJKInitializer<S, Cone<S>>::deleteGJKObject(void* o_)
 {
-  ccd_cone_t* o = static_cast<ccd_cone_t*>(o_);
-  delete o;
+  ObjectPool<ccd_cone_t>::threadLocal().destroy(static_cast<ccd_cone_t*>(o_));
 }
 
 template <typename S>
@@ -1981,7 +2173,7 @@ GJKCenterFunction GJKInitializer<S, Convex<S>>::getCenterFunction()
 template <typename S>
 void* GJKInitializer<S, Convex<S>>::createGJKObject(const Convex<S>& s, const Transform3<S>& tf)
 {
-  auto* o = new ccd_convex_t<S>;
+  auto* o = ObjectPool<ccd_convex_t<S>>::threadLocal().create();
   convexToGJK(s, tf, o);
   return o;
 }
@@ -1989,8 +2181,7 @@ void* GJKInitializer<S, Convex<S>>::createGJKObject(const Convex<S>& s, const Tr
 template <typename S>
 void GJKInitializer<S, Convex<S>>::deleteGJKObject(void* o_)
 {
-  auto* o = static_cast<ccd_convex_t<S>*>(o_);
-  delete o;
+  ObjectPool<ccd_convex_t<S>>::threadLocal().destroy(static_cast<ccd_convex_t<S>*>(o_));
 }
 
 inline GJKSupportFunction triGetSupportFunction()
@@ -2006,7 +2197,7 @@ inline GJKCenterFunction triGetCenterFunction()
 template <typename S>
 void* triCreateGJKObject(const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3)
 {
-  ccd_triangle_t* o = new ccd_triangle_t;
+  ccd_triangle_t* o = ObjectPool<ccd_triangle_t>::threadLocal().create();
   Vector3<S> center((P1[0] + P2[0] + P3[0]) / 3, (P1[1] + P2[1] + P3[1]) / 3, (P1[2] + P2[2] + P3[2]) / 3);
 
   ccdVec3Set(&o->p[0], P1[0], P1[1], P1[2]);
@@ -2023,7 +2214,7 @@ void* triCreateGJKObject(const Vector3<S>& P1, const Vector3<S>& P2, const Vecto
 template <typename S>
 void* triCreateGJKObject(const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3, const Transform3<S>& tf)
 {
-  ccd_triangle_t* o = new ccd_triangle_t;
+  ccd_triangle_t* o = ObjectPool<ccd_triangle_t>::threadLocal().create();
   Vector3<S> center((P1[0] + P2[0] + P3[0]) / 3, (P1[1] + P2[1] + P3[1]) / 3, (P1[2] + P2[2] + P3[2]) / 3);
 
   ccdVec3Set(&o->p[0], P1[0], P1[1], P1[2]);
@@ -2041,8 +2232,7 @@ void* triCreateGJKObject(const Vector3<S>& P1, const Vector3<S>& P2, const Vecto
 
 inline void triDeleteGJKObject(void* o_)
 {
-  ccd_triangle_t* o = static_cast<ccd_triangle_t*>(o_);
-  delete o;
+  ObjectPool<ccd_triangle_t>::threadLocal().destroy(static_cast<ccd_triangle_t*>(o_));
 }
 
 } // namespace detail
@@ -76,126 +76,21 @@ Vector3<S> getSupport(
   switch(shape->getNodeType())
   {
   case GEOM_TRIANGLE:
-    {
-      const auto* triangle = static_cast<const TriangleP<S>*>(shape);
-      S dota = dir.dot(triangle->a);
-      S dotb = dir.dot(triangle->b);
-      S dotc = dir.dot(triangle->c);
-      if(dota > dotb)
-      {
-        if(dotc > dota)
-          return triangle->c;
-        else
-          return triangle->a;
-      }
-      else
-      {
-        if(dotc > dotb)
-          return triangle->c;
-        else
-          return triangle->b;
-      }
-    }
-    break;
+    return getShapeSupport(static_cast<const TriangleP<S>*>(shape), dir);
   case GEOM_BOX:
-    {
-      const Box<S>* box = static_cast<const Box<S>*>(shape);
-      return Vector3<S>((dir[0]>0)?(box->side[0]/2):(-box->side[0]/2),
-                   (dir[1]>0)?(box->side[1]/2):(-box->side[1]/2),
-                   (dir[2]>0)?(box->side[2]/2):(-box->side[2]/2));
-    }
-    break;
+    return getShapeSupport(static_cast<const Box<S>*>(shape), dir);
   case GEOM_SPHERE:
-    {
-      const Sphere<S>* sphere = static_cast<const Sphere<S>*>(shape);
-      return dir * sphere->radius;
-    }
-    break;
+    return getShapeSupport(static_cast<const Sphere<S>*>(shape), dir);
   case GEOM_ELLIPSOID:
-    {
-      const Ellipsoid<S>* ellipsoid = static_cast<const Ellipsoid<S>*>(shape);
-
-      const S a2 = ellipsoid->radii[0] * ellipsoid->radii[0];
-      const S b2 = ellipsoid->radii[1] * ellipsoid->radii[1];
-      const S c2 = ellipsoid->radii[2] * ellipsoid->radii[2];
-
-      const Vector3<S> v(a2 * dir[0], b2 * dir[1], c2 * dir[2]);
-      const S d = std::sqrt(v.dot(dir));
-
-      return v / d;
-    }
-    break;
+    return getShapeSupport(static_cast<const Ellipsoid<S>*>(shape), dir);
   case GEOM_CAPSULE:
-    {
-      const Capsule<S>* capsule = static_cast<const Capsule<S>*>(shape);
-      S half_h = capsule->lz * 0.5;
-      Vector3<S> pos1(0, 0, half_h);
-      Vector3<S> pos2(0, 0, -half_h);
-      Vector3<S> v = dir * capsule->radius;
-      pos1 += v;
-      pos2 += v;
-      if(dir.dot(pos1) > dir.dot(pos2))
-        return pos1;
-      else return pos2;
-    }
-    break;
+    return getShapeSupport(static_cast<const Capsule<S>*>(shape), dir);
   case GEOM_CONE:
-    {
-      const Cone<S>* cone = static_cast<const Cone<S>*>(shape);
-      S zdist = dir[0] * dir[0] + dir[1] * dir[1];
-      S len = zdist + dir[2] * dir[2];
-      zdist = std::sqrt(zdist);
-      len = std::sqrt(len);
-      S half_h = cone->lz * 0.5;
-      S radius = cone->radius;
-
-      S sin_a = radius / std::sqrt(radius * radius + 4 * half_h * half_h);
-
-      if(dir[2] > len * sin_a)
-        return Vector3<S>(0, 0, half_h);
-      else if(zdist > 0)
-      {
-        S rad = radius / zdist;
-        return Vector3<S>(rad * dir[0], rad * dir[1], -half_h);
-      }
-      else
-        return Vector3<S>(0, 0, -half_h);
-    }
-    break;
+    return getShapeSupport(static_cast<const Cone<S>*>(shape), dir);
   case GEOM_CYLINDER:
-    {
-      const Cylinder<S>* cylinder = static_cast<const Cylinder<S>*>(shape);
-      S zdist = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1]);
-      S half_h = cylinder->lz * 0.5;
-      if(zdist == 0.0)
-      {
-        return Vector3<S>(0, 0, (dir[2]>0)? half_h:-half_h);
-      }
-      else
-      {
-        S d = cylinder->radius / zdist;
-        return Vector3<S>(d * dir[0], d * dir[1], (dir[2]>0)?half_h:-half_h);
-      }
-    }
-    break;
+    return getShapeSupport(static_cast<const Cylinder<S>*>(shape), dir);
   case GEOM_CONVEX:
-    {
-      const Convex<S>* convex = static_cast<const Convex<S>*>(shape);
-      S maxdot = - std::numeric_limits<S>::max();
-      Vector3<S>* curp = convex->points;
-      Vector3<S> bestv = Vector3<S>::Zero();
-      for(int i = 0; i < convex->num_points; ++i, curp+=1)
-      {
-        S dot = dir.dot(*curp);
-        if(dot > maxdot)
-        {
-          bestv = *curp;
-          maxdot = dot;
-        }
-      }
-      return bestv;
-    }
-    break;
+    return getShapeSupport(static_cast<const Convex<S>*>(shape), dir);
   case GEOM_PLANE:
   break;
   default:
@@ -205,32 +100,212 @@ Vector3<S> getSupport(
   return Vector3<S>::Zero();
 }
 
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const ShapeBase<S>* shape, const Eigen::MatrixBase<Derived>& dir)
+{
+  return getSupport(shape, dir);
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const TriangleP<S>* triangle, const Eigen::MatrixBase<Derived>& dir)
+{
+  S dota = dir.dot(triangle->a);
+  S dotb = dir.dot(triangle->b);
+  S dotc = dir.dot(triangle->c);
+  if(dota > dotb)
+  {
+    if(dotc > dota)
+      return triangle->c;
+    else
+      return triangle->a;
+  }
+  else
+  {
+    if(dotc > dotb)
+      return triangle->c;
+    else
+      return triangle->b;
+  }
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Box<S>* box, const Eigen::MatrixBase<Derived>& dir)
+{
+  return Vector3<S>((dir[0]>0)?(box->side[0]/2):(-box->side[0]/2),
+               (dir[1]>0)?(box->side[1]/2):(-box->side[1]/2),
+               (dir[2]>0)?(box->side[2]/2):(-box->side[2]/2));
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Sphere<S>* sphere, const Eigen::MatrixBase<Derived>& dir)
+{
+  return dir * sphere->radius;
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Ellipsoid<S>* ellipsoid, const Eigen::MatrixBase<Derived>& dir)
+{
+  const S a2 = ellipsoid->radii[0] * ellipsoid->radii[0];
+  const S b2 = ellipsoid->radii[1] * ellipsoid->radii[1];
+  const S c2 = ellipsoid->radii[2] * ellipsoid->radii[2];
+
+  const Vector3<S> v(a2 * dir[0], b2 * dir[1], c2 * dir[2]);
+  const S d = std::sqrt(v.dot(dir));
+
+  return v / d;
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Capsule<S>* capsule, const Eigen::MatrixBase<Derived>& dir)
+{
+  S half_h = capsule->lz * 0.5;
+  Vector3<S> pos1(0, 0, half_h);
+  Vector3<S> pos2(0, 0, -half_h);
+  Vector3<S> v = dir * capsule->radius;
+  pos1 += v;
+  pos2 += v;
+  if(dir.dot(pos1) > dir.dot(pos2))
+    return pos1;
+  else return pos2;
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Cone<S>* cone, const Eigen::MatrixBase<Derived>& dir)
+{
+  S zdist = dir[0] * dir[0] + dir[1] * dir[1];
+  S len = zdist + dir[2] * dir[2];
+  zdist = std::sqrt(zdist);
+  len = std::sqrt(len);
+  S half_h = cone->lz * 0.5;
+  S radius = cone->radius;
+
+  S sin_a = radius / std::sqrt(radius * radius + 4 * half_h * half_h);
+
+  if(dir[2] > len * sin_a)
+    return Vector3<S>(0, 0, half_h);
+  else if(zdist > 0)
+  {
+    S rad = radius / zdist;
+    return Vector3<S>(rad * dir[0], rad * dir[1], -half_h);
+  }
+  else
+    return Vector3<S>(0, 0, -half_h);
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Cylinder<S>* cylinder, const Eigen::MatrixBase<Derived>& dir)
+{
+  S zdist = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1]);
+  S half_h = cylinder->lz * 0.5;
+  if(zdist == 0.0)
+  {
+    return Vector3<S>(0, 0, (dir[2]>0)? half_h:-half_h);
+  }
+  else
+  {
+    S d = cylinder->radius / zdist;
+    return Vector3<S>(d * dir[0], d * dir[1], (dir[2]>0)?half_h:-half_h);
+  }
+}
+
+//==============================================================================
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Convex<S>* convex, const Eigen::MatrixBase<Derived>& dir)
+{
+  S maxdot = - std::numeric_limits<S>::max();
+  Vector3<S>* curp = convex->points;
+  Vector3<S> bestv = Vector3<S>::Zero();
+  for(int i = 0; i < convex->num_points; ++i, curp+=1)
+  {
+    S dot = dir.dot(*curp);
+    if(dot > maxdot)
+    {
+      bestv = *curp;
+      maxdot = dot;
+    }
+  }
+  return bestv;
+}
+
+//==============================================================================
+template <typename S, typename Shape0>
+Vector3<S> minkowskiSupport0(const MinkowskiDiff<S>& md, const Vector3<S>& d)
+{
+  return getShapeSupport(static_cast<const Shape0*>(md.shapes[0]), d);
+}
+
+//==============================================================================
+template <typename S, typename Shape1>
+Vector3<S> minkowskiSupport1(const MinkowskiDiff<S>& md, const Vector3<S>& d)
+{
+  return md.toshape0 * getShapeSupport(static_cast<const Shape1*>(md.shapes[1]), md.toshape1 * d);
+}
+
+//==============================================================================
+template <typename S, typename Shape0, typename Shape1>
+Vector3<S> minkowskiSupport(const MinkowskiDiff<S>& md, const Vector3<S>& d)
+{
+  return minkowskiSupport0<S, Shape0>(md, d) - minkowskiSupport1<S, Shape1>(md, -d);
+}
+
 //==============================================================================
 template <typename S>
 MinkowskiDiff<S>::MinkowskiDiff()
+  : support0_func(&minkowskiSupport0<S, ShapeBase<S>>),
+    support1_func(&minkowskiSupport1<S, ShapeBase<S>>),
+    support_func(&minkowskiSupport<S, ShapeBase<S>, ShapeBase<S>>)
 {
   // Do nothing
 }
 
+//==============================================================================
+template <typename S>
+template <typename Shape0, typename Shape1>
+void MinkowskiDiff<S>::set(const Shape0* shape0, const Shape1* shape1)
+{
+  shapes[0] = shape0;
+  shapes[1] = shape1;
+  support0_func = &minkowskiSupport0<S, Shape0>;
+  support1_func = &minkowskiSupport1<S, Shape1>;
+  support_func = &minkowskiSupport<S, Shape0, Shape1>;
+}
+
 //==============================================================================
 template <typename S>
 Vector3<S> MinkowskiDiff<S>::support0(const Vector3<S>& d) const
 {
-  return getSupport(shapes[0], d);
+  return support0_func(*this, d);
 }
 
 //==============================================================================
 template <typename S>
 Vector3<S> MinkowskiDiff<S>::support1(const Vector3<S>& d) const
 {
-  return toshape0 * getSupport(shapes[1], toshape1 * d);
+  return support1_func(*this, d);
 }
 
 //==============================================================================
 template <typename S>
 Vector3<S> MinkowskiDiff<S>::support(const Vector3<S>& d) const
 {
-  return support0(d) - support1(-d);
+  return support_func(*this, d);
 }
 
 //==============================================================================
@@ -248,9 +323,9 @@ template <typename S>
 Vector3<S> MinkowskiDiff<S>::support0(const Vector3<S>& d, const Vector3<S>& v) const
 {
   if(d.dot(v) <= 0)
-    return getSupport(shapes[0], d);
+    return support0(d);
   else
-    return getSupport(shapes[0], d) + v;
+    return support0(d) + v;
 }
 
 //==============================================================================
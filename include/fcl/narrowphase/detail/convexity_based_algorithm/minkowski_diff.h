@@ -40,6 +40,14 @@
 
 #include "fcl/math/detail/project.h"
 #include "fcl/geometry/shape/shape_base.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/cone.h"
+#include "fcl/geometry/shape/convex.h"
+#include "fcl/geometry/shape/cylinder.h"
+#include "fcl/geometry/shape/ellipsoid.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/geometry/shape/triangle_p.h"
 
 namespace fcl
 {
@@ -53,13 +61,77 @@ Vector3<S> getSupport(
     const ShapeBase<S>* shape,
     const Eigen::MatrixBase<Derived>& dir);
 
+/// @brief the support function for a shape whose type is known at compile
+/// time. The ShapeBase overload dispatches on the node type at run time.
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const ShapeBase<S>* shape, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const TriangleP<S>* triangle, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Box<S>* box, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Sphere<S>* sphere, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Ellipsoid<S>* ellipsoid, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Capsule<S>* capsule, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Cone<S>* cone, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Cylinder<S>* cylinder, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S, typename Derived>
+Vector3<S> getShapeSupport(
+    const Convex<S>* convex, const Eigen::MatrixBase<Derived>& dir);
+
+template <typename S>
+struct MinkowskiDiff;
+
+/// @brief support function of shape0 of md, with shape0 of type Shape0
+template <typename S, typename Shape0>
+Vector3<S> minkowskiSupport0(const MinkowskiDiff<S>& md, const Vector3<S>& d);
+
+/// @brief support function of shape1 of md, with shape1 of type Shape1
+template <typename S, typename Shape1>
+Vector3<S> minkowskiSupport1(const MinkowskiDiff<S>& md, const Vector3<S>& d);
+
+/// @brief support function of the Minkowski difference md of a Shape0 and a
+/// Shape1
+template <typename S, typename Shape0, typename Shape1>
+Vector3<S> minkowskiSupport(const MinkowskiDiff<S>& md, const Vector3<S>& d);
+
 /// @brief Minkowski difference class of two shapes
 template <typename S>
 struct MinkowskiDiff
 {
+  using SupportFunction
+      = Vector3<S> (*)(const MinkowskiDiff<S>& md, const Vector3<S>& d);
+
   /// @brief points to two shapes
   const ShapeBase<S>* shapes[2];
 
+  /// @brief support functions for shape0, shape1 and the pair. By default
+  /// they dispatch on the node types of the shapes for every call; set()
+  /// replaces them by functions compiled for the concrete shape types.
+  SupportFunction support0_func;
+  SupportFunction support1_func;
+  SupportFunction support_func;
+
   /// @brief rotation from shape0 to shape1
   Matrix3<S> toshape1;
 
@@ -68,6 +140,12 @@ struct MinkowskiDiff
 
   MinkowskiDiff();
 
+  /// @brief set the two shapes and select the support functions for their
+  /// types, so that the GJK and EPA inner loops do not dispatch on the node
+  /// type for every support point
+  template <typename Shape0, typename Shape1>
+  void set(const Shape0* shape0, const Shape1* shape1);
+
   /// @brief support function for shape0
   Vector3<S> support0(const Vector3<S>& d) const;
   
@@ -64,16 +64,12 @@
 #include "fcl/narrowphase/detail/traversal/distance/shape_mesh_distance_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/distance/shape_mesh_conservative_advancement_traversal_node.h"
 
-#if FCL_HAVE_OCTOMAP
-
 #include "fcl/narrowphase/detail/traversal/octree/distance/mesh_octree_distance_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/octree/distance/octree_distance_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/octree/distance/octree_mesh_distance_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/octree/distance/octree_shape_distance_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/octree/distance/shape_octree_distance_traversal_node.h"
 
-#endif // FCL_HAVE_OCTOMAP
-
 namespace fcl
 {
 
@@ -81,7 +77,6 @@ namespace detail
 {
 
 //==============================================================================
-#if FCL_HAVE_OCTOMAP
 template <typename Shape, typename NarrowPhaseSolver>
 typename Shape::S ShapeOcTreeDistance(
     const CollisionGeometry<typename Shape::S>* o1,
@@ -202,8 +197,6 @@ typename BV::S OcTreeBVHDistance(
   return result.min_distance;
 }
 
-#endif
-
 template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
 typename Shape1::S ShapeShapeDistance(
     const CollisionGeometry<typename Shape1::S>* o1,
@@ -247,7 +240,7 @@ struct BVHShapeDistancer
     const Shape* obj2 = static_cast<const Shape*>(o2);
 
     initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, request, result);
-    ::fcl::distance(&node);
+    distanceNode(&node);
 
     delete obj1_tmp;
     return result.min_distance;
@@ -271,7 +264,7 @@ typename Shape::S orientedBVHShapeDistance(
   const Shape* obj2 = static_cast<const Shape*>(o2);
 
   initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
-  distance(&node);
+  distanceNode(&node);
 
   return result.min_distance;
 }
@@ -361,7 +354,10 @@ struct BVHDistanceImpl
     Transform3<S> tf2_tmp = tf2;
 
     initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, request, result);
-    distance(&node);
+    if(request.num_threads == 1)
+      distanceNode(&node);
+    else
+      distanceParallel(&node, request.num_threads);
     delete obj1_tmp;
     delete obj2_tmp;
 
@@ -398,7 +394,10 @@ typename BV::S orientedMeshDistance(
   const BVHModel<BV>* obj2 = static_cast<const BVHModel<BV>* >(o2);
 
   initialize(node, *obj1, tf1, *obj2, tf2, request, result);
-  distance(&node);
+  if(request.num_threads == 1)
+    distanceNode(&node);
+  else
+    distanceParallel(&node, request.num_threads);
 
   return result.min_distance;
 }
@@ -662,7 +661,6 @@ DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunctionMatrix()
   distance_matrix[BV_kIOS][BV_kIOS] = &BVHDistance<kIOS<S>, NarrowPhaseSolver>;
   distance_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHDistance<OBBRSS<S>, NarrowPhaseSolver>;
 
-#if FCL_HAVE_OCTOMAP
   distance_matrix[GEOM_OCTREE][GEOM_BOX] = &OcTreeShapeDistance<Box<S>, NarrowPhaseSolver>;
   distance_matrix[GEOM_OCTREE][GEOM_SPHERE] = &OcTreeShapeDistance<Sphere<S>, NarrowPhaseSolver>;
   distance_matrix[GEOM_OCTREE][GEOM_ELLIPSOID] = &OcTreeShapeDistance<Ellipsoid<S>, NarrowPhaseSolver>;
@@ -702,7 +700,6 @@ DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunctionMatrix()
   distance_matrix[BV_KDOP16][GEOM_OCTREE] = &BVHOcTreeDistance<KDOP<S, 16>, NarrowPhaseSolver>;
   distance_matrix[BV_KDOP18][GEOM_OCTREE] = &BVHOcTreeDistance<KDOP<S, 18>, NarrowPhaseSolver>;
   distance_matrix[BV_KDOP24][GEOM_OCTREE] = &BVHOcTreeDistance<KDOP<S, 24>, NarrowPhaseSolver>;
-#endif
 
 }
 
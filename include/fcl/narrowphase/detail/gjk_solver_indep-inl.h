@@ -120,8 +120,7 @@ struct ShapeIntersectIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s1;
-    shape.shapes[1] = &s2;
+    shape.set(&s1, &s2);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -359,8 +358,7 @@ struct ShapeTriangleIntersectIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.set(&s, &tri);
     shape.toshape1 = tf.linear();
     shape.toshape0 = tf.inverse(Eigen::Isometry);
 
@@ -456,8 +454,7 @@ struct ShapeTransformedTriangleIntersectIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.set(&s, &tri);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -597,8 +594,7 @@ struct ShapeDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s1;
-    shape.shapes[1] = &s2;
+    shape.set(&s1, &s2);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -781,8 +777,7 @@ struct ShapeTriangleDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.set(&s, &tri);
     shape.toshape1 = tf.linear();
     shape.toshape0 = tf.inverse(Eigen::Isometry);
 
@@ -871,8 +866,7 @@ struct ShapeTransformedTriangleDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.set(&s, &tri);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -110,6 +110,66 @@ bool initialize(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+extern template
+class MeshCollisionTraversalNodeAABB<double>;
+
+//==============================================================================
+extern template
+bool initialize(
+    MeshCollisionTraversalNodeAABB<double>& node,
+    const BVHModel<AABB<double>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<AABB<double>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+extern template
+class MeshCollisionTraversalNodeKDOP<double, 16>;
+
+//==============================================================================
+extern template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 16>& node,
+    const BVHModel<KDOP<double, 16>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 16>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+extern template
+class MeshCollisionTraversalNodeKDOP<double, 18>;
+
+//==============================================================================
+extern template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 18>& node,
+    const BVHModel<KDOP<double, 18>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 18>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+extern template
+class MeshCollisionTraversalNodeKDOP<double, 24>;
+
+//==============================================================================
+extern template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 24>& node,
+    const BVHModel<KDOP<double, 24>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 24>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
 //==============================================================================
 template <typename BV>
 MeshCollisionTraversalNode<BV>::MeshCollisionTraversalNode()
@@ -149,6 +209,14 @@ void MeshCollisionTraversalNode<BV>::leafTesting(int b1, int b2) const
 
     if(!this->request.enable_contact) // only interested in collision or not
     {
+      if(!this->request.enable_cost)
+      {
+        leaf_batch.push(p1, p2, p3, q1, q2, q3, primitive_id1, primitive_id2);
+        if(leaf_batch.full())
+          leaf_batch.flush(this->model1, this->model2, this->request, *this->result);
+        return;
+      }
+
       if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3))
       {
         is_intersect = true;
@@ -206,6 +274,13 @@ bool MeshCollisionTraversalNode<BV>::canStop() const
   return this->request.isSatisfied(*(this->result));
 }
 
+//==============================================================================
+template <typename BV>
+void MeshCollisionTraversalNode<BV>::postprocess()
+{
+  leaf_batch.flush(this->model1, this->model2, this->request, *this->result);
+}
+
 //==============================================================================
 template <typename BV>
 bool initialize(
@@ -317,7 +392,8 @@ void MeshCollisionTraversalNodeOBB<S>::leafTesting(int b1, int b2) const
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
 }
 
 //==============================================================================
@@ -370,7 +446,8 @@ void MeshCollisionTraversalNodeOBB<S>::leafTesting(
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
 }
 
 //==============================================================================
@@ -394,7 +471,8 @@ void MeshCollisionTraversalNodeOBB<S>::leafTesting(
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
 }
 
 //==============================================================================
@@ -436,7 +514,8 @@ void MeshCollisionTraversalNodeRSS<S>::leafTesting(int b1, int b2) const
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
 }
 
 //==============================================================================
@@ -478,7 +557,8 @@ void MeshCollisionTraversalNodekIOS<S>::leafTesting(int b1, int b2) const
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
 }
 
 //==============================================================================
@@ -520,7 +600,94 @@ void MeshCollisionTraversalNodeOBBRSS<S>::leafTesting(int b1, int b2) const
         this->cost_density,
         this->num_leaf_tests,
         this->request,
-        *this->result);
+        *this->result,
+        &this->leaf_batch);
+}
+
+//==============================================================================
+template <typename S>
+MeshCollisionTraversalNodeAABB<S>::MeshCollisionTraversalNodeAABB()
+  : MeshCollisionTraversalNode<AABB<S>>(),
+    R(Matrix3<S>::Identity())
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+bool MeshCollisionTraversalNodeAABB<S>::BVTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) this->num_bv_tests++;
+
+  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+}
+
+//==============================================================================
+template <typename S>
+void MeshCollisionTraversalNodeAABB<S>::leafTesting(int b1, int b2) const
+{
+  detail::meshCollisionOrientedNodeLeafTesting(
+        b1,
+        b2,
+        this->model1,
+        this->model2,
+        this->vertices1,
+        this->vertices2,
+        this->tri_indices1,
+        this->tri_indices2,
+        R,
+        T,
+        this->tf1,
+        this->tf2,
+        this->enable_statistics,
+        this->cost_density,
+        this->num_leaf_tests,
+        this->request,
+        *this->result,
+        &this->leaf_batch);
+}
+
+//==============================================================================
+template <typename S, std::size_t N>
+MeshCollisionTraversalNodeKDOP<S, N>::MeshCollisionTraversalNodeKDOP()
+  : MeshCollisionTraversalNode<KDOP<S, N>>(),
+    R(Matrix3<S>::Identity())
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S, std::size_t N>
+bool MeshCollisionTraversalNodeKDOP<S, N>::BVTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) this->num_bv_tests++;
+
+  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+}
+
+//==============================================================================
+template <typename S, std::size_t N>
+void MeshCollisionTraversalNodeKDOP<S, N>::leafTesting(int b1, int b2) const
+{
+  detail::meshCollisionOrientedNodeLeafTesting(
+        b1,
+        b2,
+        this->model1,
+        this->model2,
+        this->vertices1,
+        this->vertices2,
+        this->tri_indices1,
+        this->tri_indices2,
+        R,
+        T,
+        this->tf1,
+        this->tf2,
+        this->enable_statistics,
+        this->cost_density,
+        this->num_leaf_tests,
+        this->request,
+        *this->result,
+        &this->leaf_batch);
 }
 
 template <typename BV>
@@ -540,7 +707,8 @@ void meshCollisionOrientedNodeLeafTesting(
     typename BV::S cost_density,
     int& num_leaf_tests,
     const CollisionRequest<typename BV::S>& request,
-    CollisionResult<typename BV::S>& result)
+    CollisionResult<typename BV::S>& result,
+    TriangleBatch<typename BV::S>* leaf_batch)
 {
   using S = typename BV::S;
 
@@ -568,6 +736,15 @@ void meshCollisionOrientedNodeLeafTesting(
 
     if(!request.enable_contact) // only interested in collision or not
     {
+      if(leaf_batch && !request.enable_cost)
+      {
+        leaf_batch->push(p1, p2, p3, R * q1 + T, R * q2 + T, R * q3 + T,
+                         primitive_id1, primitive_id2);
+        if(leaf_batch->full())
+          leaf_batch->flush(model1, model2, request, result);
+        return;
+      }
+
       if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, R, T))
       {
         is_intersect = true;
@@ -637,7 +814,8 @@ void meshCollisionOrientedNodeLeafTesting(
     typename BV::S cost_density,
     int& num_leaf_tests,
     const CollisionRequest<typename BV::S>& request,
-    CollisionResult<typename BV::S>& result)
+    CollisionResult<typename BV::S>& result,
+    TriangleBatch<typename BV::S>* leaf_batch)
 {
   using S = typename BV::S;
 
@@ -665,6 +843,15 @@ void meshCollisionOrientedNodeLeafTesting(
 
     if(!request.enable_contact) // only interested in collision or not
     {
+      if(leaf_batch && !request.enable_cost)
+      {
+        leaf_batch->push(p1, p2, p3, tf * q1, tf * q2, tf * q3,
+                         primitive_id1, primitive_id2);
+        if(leaf_batch->full())
+          leaf_batch->flush(model1, model2, request, result);
+        return;
+      }
+
       if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, tf))
       {
         is_intersect = true;
@@ -804,6 +991,36 @@ bool initialize(
         node, model1, tf1, model2, tf2, request, result);
 }
 
+//==============================================================================
+template <typename S>
+bool initialize(
+    MeshCollisionTraversalNodeAABB<S>& node,
+    const BVHModel<AABB<S>>& model1,
+    const Transform3<S>& tf1,
+    const BVHModel<AABB<S>>& model2,
+    const Transform3<S>& tf2,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result)
+{
+  return detail::setupMeshCollisionOrientedNode(
+        node, model1, tf1, model2, tf2, request, result);
+}
+
+//==============================================================================
+template <typename S, std::size_t N>
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<S, N>& node,
+    const BVHModel<KDOP<S, N>>& model1,
+    const Transform3<S>& tf1,
+    const BVHModel<KDOP<S, N>>& model2,
+    const Transform3<S>& tf2,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result)
+{
+  return detail::setupMeshCollisionOrientedNode(
+        node, model1, tf1, model2, tf2, request, result);
+}
+
 } // namespace detail
 } // namespace fcl
 
@@ -38,6 +38,8 @@
 #ifndef FCL_TRAVERSAL_MESHCOLLISIONTRAVERSALNODE_H
 #define FCL_TRAVERSAL_MESHCOLLISIONTRAVERSALNODE_H
 
+#include "fcl/math/bv/AABB.h"
+#include "fcl/math/bv/kDOP.h"
 #include "fcl/math/bv/OBB.h"
 #include "fcl/math/bv/RSS.h"
 #include "fcl/math/bv/OBBRSS.h"
@@ -45,6 +47,7 @@
 #include "fcl/narrowphase/contact.h"
 #include "fcl/narrowphase/cost_source.h"
 #include "fcl/narrowphase/detail/traversal/collision/intersect.h"
+#include "fcl/narrowphase/detail/traversal/collision/triangle_batch.h"
 #include "fcl/narrowphase/detail/traversal/collision/bvh_collision_traversal_node.h"
 
 namespace fcl
@@ -66,9 +69,16 @@ public:
   /// @brief Intersection testing between leaves (two triangles)
   void leafTesting(int b1, int b2) const;
 
-  /// @brief Whether the traversal process can stop early
+  /// @brief Whether the traversal process can stop early. Hits still waiting
+  /// in leaf_batch are not counted, so the traversal stops only at the flush
+  /// after the hit that satisfies the request: up to
+  /// TriangleBatch::kCapacity - 1 more leaf pairs may be tested. The contacts
+  /// are unchanged, as a flush adds them in the order the pairs were pushed.
   bool canStop() const;
 
+  /// @brief Test the leaf pairs still waiting in leaf_batch
+  void postprocess();
+
   Vector3<S>* vertices1;
   Vector3<S>* vertices2;
 
@@ -76,6 +86,10 @@ public:
   Triangle* tri_indices2;
 
   S cost_density;
+
+  /// @brief Leaf pairs of a query that only asks whether the meshes collide,
+  /// tested a batch at a time
+  mutable TriangleBatch<S> leaf_batch;
 };
 
 /// @brief Initialize traversal node for collision between two meshes, given the
@@ -237,6 +251,77 @@ bool initialize(
     const CollisionRequest<S>& request,
     CollisionResult<S>& result);
 
+/// @brief Traversal node for collision between two meshes whose BVs are AABBs.
+/// The BVs of the second model are tested as oriented boxes in the frame of the
+/// first model, so neither model is transformed or refitted.
+template <typename S>
+class MeshCollisionTraversalNodeAABB : public MeshCollisionTraversalNode<AABB<S>>
+{
+public:
+  MeshCollisionTraversalNodeAABB();
+
+  bool BVTesting(int b1, int b2) const;
+
+  void leafTesting(int b1, int b2) const;
+
+  Matrix3<S> R;
+  Vector3<S> T;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+using MeshCollisionTraversalNodeAABBf = MeshCollisionTraversalNodeAABB<float>;
+using MeshCollisionTraversalNodeAABBd = MeshCollisionTraversalNodeAABB<double>;
+
+/// @brief Initialize traversal node for collision between two meshes,
+/// specialized for AABB type
+template <typename S>
+bool initialize(
+    MeshCollisionTraversalNodeAABB<S>& node,
+    const BVHModel<AABB<S>>& model1,
+    const Transform3<S>& tf1,
+    const BVHModel<AABB<S>>& model2,
+    const Transform3<S>& tf2,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result);
+
+/// @brief Traversal node for collision between two meshes whose BVs are KDOPs.
+/// Like MeshCollisionTraversalNodeAABB, the models are left untouched and the
+/// BVs are compared across the two frames with a conservative test.
+template <typename S, std::size_t N>
+class MeshCollisionTraversalNodeKDOP
+    : public MeshCollisionTraversalNode<KDOP<S, N>>
+{
+public:
+  MeshCollisionTraversalNodeKDOP();
+
+  bool BVTesting(int b1, int b2) const;
+
+  void leafTesting(int b1, int b2) const;
+
+  Matrix3<S> R;
+  Vector3<S> T;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+template <std::size_t N>
+using MeshCollisionTraversalNodeKDOPf = MeshCollisionTraversalNodeKDOP<float, N>;
+template <std::size_t N>
+using MeshCollisionTraversalNodeKDOPd = MeshCollisionTraversalNodeKDOP<double, N>;
+
+/// @brief Initialize traversal node for collision between two meshes,
+/// specialized for KDOP type
+template <typename S, std::size_t N>
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<S, N>& node,
+    const BVHModel<KDOP<S, N>>& model1,
+    const Transform3<S>& tf1,
+    const BVHModel<KDOP<S, N>>& model2,
+    const Transform3<S>& tf2,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result);
+
 template <typename BV>
 void meshCollisionOrientedNodeLeafTesting(
     int b1,
@@ -255,7 +340,8 @@ void meshCollisionOrientedNodeLeafTesting(
     typename BV::S cost_density,
     int& num_leaf_tests,
     const CollisionRequest<typename BV::S>& request,
-    CollisionResult<typename BV::S>& result);
+    CollisionResult<typename BV::S>& result,
+    TriangleBatch<typename BV::S>* leaf_batch = nullptr);
 
 template <typename BV>
 void meshCollisionOrientedNodeLeafTesting(
@@ -274,7 +360,8 @@ void meshCollisionOrientedNodeLeafTesting(
     typename BV::S cost_density,
     int& num_leaf_tests,
     const CollisionRequest<typename BV::S>& request,
-    CollisionResult<typename BV::S>& result);
+    CollisionResult<typename BV::S>& result,
+    TriangleBatch<typename BV::S>* leaf_batch = nullptr);
 
 } // namespace detail
 } // namespace fcl
@@ -0,0 +1,162 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_TRIANGLEBATCH_INL_H
+#define FCL_NARROWPHASE_DETAIL_TRIANGLEBATCH_INL_H
+
+#include "fcl/narrowphase/detail/traversal/collision/triangle_batch.h"
+
+#include "fcl/narrowphase/detail/traversal/collision/intersect.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+class TriangleBatch<double>;
+
+//==============================================================================
+template <typename S>
+constexpr int TriangleBatch<S>::kCapacity;
+
+//==============================================================================
+template <typename S>
+TriangleBatch<S>::TriangleBatch() : p(), q(), id1(), id2(), num_pairs(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void TriangleBatch<S>::push(
+    const Vector3<S>& p1, const Vector3<S>& p2, const Vector3<S>& p3,
+    const Vector3<S>& q1, const Vector3<S>& q2, const Vector3<S>& q3,
+    int id1_, int id2_)
+{
+  const int i = num_pairs;
+
+  for(int k = 0; k < 3; ++k)
+  {
+    p[0][k][i] = p1[k];
+    p[1][k][i] = p2[k];
+    p[2][k][i] = p3[k];
+    q[0][k][i] = q1[k];
+    q[1][k][i] = q2[k];
+    q[2][k][i] = q3[k];
+  }
+
+  id1[i] = id1_;
+  id2[i] = id2_;
+
+  ++num_pairs;
+}
+
+//==============================================================================
+template <typename S>
+void TriangleBatch<S>::flush(
+    const CollisionGeometry<S>* o1,
+    const CollisionGeometry<S>* o2,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result)
+{
+  if(num_pairs == 0)
+    return;
+
+  bool hits[kCapacity];
+  intersectTriangleBatch(*this, hits);
+
+  for(int i = 0; i < num_pairs; ++i)
+  {
+    if(hits[i] && result.numContacts() < request.num_max_contacts)
+      result.addContact(Contact<S>(o1, o2, id1[i], id2[i]));
+  }
+
+  num_pairs = 0;
+}
+
+//==============================================================================
+template <typename S>
+void TriangleBatch<S>::clear()
+{
+  num_pairs = 0;
+}
+
+//==============================================================================
+template <typename S>
+int TriangleBatch<S>::size() const
+{
+  return num_pairs;
+}
+
+//==============================================================================
+template <typename S>
+bool TriangleBatch<S>::empty() const
+{
+  return num_pairs == 0;
+}
+
+//==============================================================================
+template <typename S>
+bool TriangleBatch<S>::full() const
+{
+  return num_pairs == kCapacity;
+}
+
+//==============================================================================
+template <typename S>
+void intersectTriangleBatch(const TriangleBatch<S>& batch, bool* hits)
+{
+  for(int i = 0; i < batch.size(); ++i)
+  {
+    Vector3<S> v[6];
+    for(int k = 0; k < 3; ++k)
+    {
+      for(int j = 0; j < 3; ++j)
+      {
+        v[j][k] = batch.p[j][k][i];
+        v[3 + j][k] = batch.q[j][k][i];
+      }
+    }
+
+    hits[i] = Intersect<S>::intersect_Triangle(v[0], v[1], v[2], v[3], v[4], v[5]);
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
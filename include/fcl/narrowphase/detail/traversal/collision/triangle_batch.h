@@ -0,0 +1,121 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_TRIANGLEBATCH_H
+#define FCL_NARROWPHASE_DETAIL_TRIANGLEBATCH_H
+
+#include "fcl/common/types.h"
+#include "fcl/narrowphase/collision_request.h"
+#include "fcl/narrowphase/collision_result.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Buffer of triangle pairs whose intersection is tested together.
+///
+/// The vertices are stored as structure of arrays (vertex, coordinate, lane)
+/// so that intersectTriangleBatch() can run the separating axis test of
+/// Intersect::intersect_Triangle() on all the pairs at once. The answer for
+/// each pair is the one of Intersect::intersect_Triangle(), up to the rounding
+/// of the projections on the separating axes.
+template <typename S>
+class TriangleBatch
+{
+public:
+
+  /// @brief Number of pairs tested by one call of intersectTriangleBatch()
+  static constexpr int kCapacity = 8;
+
+  TriangleBatch();
+
+  /// @brief Append the pair of triangles (p1, p2, p3) and (q1, q2, q3), given
+  /// in the same frame, with the ids of their primitives
+  void push(const Vector3<S>& p1, const Vector3<S>& p2, const Vector3<S>& p3,
+            const Vector3<S>& q1, const Vector3<S>& q2, const Vector3<S>& q3,
+            int id1, int id2);
+
+  /// @brief Test the buffered pairs and add a contact for each intersecting
+  /// one, in the order the pairs were pushed, until request.num_max_contacts
+  /// is reached. The buffer is empty afterwards.
+  void flush(const CollisionGeometry<S>* o1,
+             const CollisionGeometry<S>* o2,
+             const CollisionRequest<S>& request,
+             CollisionResult<S>& result);
+
+  /// @brief Drop the buffered pairs without testing them
+  void clear();
+
+  int size() const;
+
+  bool empty() const;
+
+  bool full() const;
+
+  /// @brief Vertices of the first triangles, indexed [vertex][coordinate][pair]
+  S p[3][3][kCapacity];
+
+  /// @brief Vertices of the second triangles, indexed [vertex][coordinate][pair]
+  S q[3][3][kCapacity];
+
+  int id1[kCapacity];
+  int id2[kCapacity];
+
+private:
+  int num_pairs;
+};
+
+/// @brief Test the first batch.size() pairs of the batch for intersection;
+/// hits[i] is set to whether the i-th pair intersects. The float and double
+/// versions pick a vectorized kernel for the running CPU (AVX-512, AVX2 or
+/// the baseline instruction set) the first time they are called.
+template <typename S>
+void intersectTriangleBatch(const TriangleBatch<S>& batch, bool* hits);
+
+void intersectTriangleBatch(const TriangleBatch<float>& batch, bool* hits);
+
+void intersectTriangleBatch(const TriangleBatch<double>& batch, bool* hits);
+
+/// @brief Name of the kernel used by intersectTriangleBatch() on this CPU:
+/// "avx512", "avx2" or "default"
+const char* triangleBatchKernelName();
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/traversal/collision/triangle_batch-inl.h"
+
+#endif
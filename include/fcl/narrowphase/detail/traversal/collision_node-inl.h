@@ -71,6 +71,8 @@ void collide2(MeshCollisionTraversalNodeRSS<double>* node, BVHFrontList* front_l
 template <typename S>
 void collide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
 {
+  node->preprocess();
+
   if(front_list && front_list->size() > 0)
   {
     propagateBVHFrontListCollisionRecurse(node, front_list);
@@ -79,12 +81,34 @@ void collide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
   {
     collisionRecurse(node, 0, 0, front_list);
   }
+
+  node->postprocess();
+}
+
+//==============================================================================
+template <typename NodeType>
+void collideNode(NodeType* node, BVHFrontList* front_list)
+{
+  node->preprocess();
+
+  if(front_list && front_list->size() > 0)
+  {
+    propagateBVHFrontListCollisionRecurse(node, front_list);
+  }
+  else
+  {
+    collisionTraverse(node, 0, 0, front_list);
+  }
+
+  node->postprocess();
 }
 
 //==============================================================================
 template <typename S>
 void collide2(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list)
 {
+  node->preprocess();
+
   if(front_list && front_list->size() > 0)
   {
     propagateBVHFrontListCollisionRecurse(node, front_list);
@@ -101,12 +125,16 @@ void collide2(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list)
 
     collisionRecurse(node, 0, 0, R, T, front_list);
   }
+
+  node->postprocess();
 }
 
 //==============================================================================
 template <typename S>
 void collide2(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list)
 {
+  node->preprocess();
+
   if(front_list && front_list->size() > 0)
   {
     propagateBVHFrontListCollisionRecurse(node, front_list);
@@ -115,12 +143,15 @@ void collide2(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list)
   {
     collisionRecurse(node, 0, 0, node->R, node->T, front_list);
   }
+
+  node->postprocess();
 }
 
 //==============================================================================
 template <typename S>
 void selfCollide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
 {
+  node->preprocess();
 
   if(front_list && front_list->size() > 0)
   {
@@ -130,6 +161,8 @@ void selfCollide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
   {
     selfCollisionRecurse(node, 0, front_list);
   }
+
+  node->postprocess();
 }
 
 //==============================================================================
@@ -138,7 +171,9 @@ void distance(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list, int
 {
   node->preprocess();
 
-  if(qsize <= 2)
+  if(front_list && front_list->size() > 0)
+    propagateBVHFrontListDistanceRecurse(node, front_list);
+  else if(qsize <= 2)
     distanceRecurse(node, 0, 0, front_list);
   else
     distanceQueueRecurse(node, 0, 0, front_list, qsize);
@@ -146,6 +181,33 @@ void distance(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list, int
   node->postprocess();
 }
 
+//==============================================================================
+template <typename NodeType>
+void distanceNode(NodeType* node, BVHFrontList* front_list, int qsize)
+{
+  node->preprocess();
+
+  if(front_list && front_list->size() > 0)
+    propagateBVHFrontListDistanceRecurse(node, front_list);
+  else if(qsize <= 2)
+    distanceTraverse(node, 0, 0, front_list);
+  else
+    distanceQueueRecurse(node, 0, 0, front_list, qsize);
+
+  node->postprocess();
+}
+
+//==============================================================================
+template <typename NodeType>
+void distanceParallel(NodeType* node, unsigned int num_threads, int qsize)
+{
+  node->preprocess();
+
+  distanceParallelRecurse(node, 0, 0, qsize, num_threads);
+
+  node->postprocess();
+}
+
 } // namespace detail
 } // namespace fcl
 
@@ -55,6 +55,12 @@ namespace detail
 template <typename S>
 void collide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list = nullptr);
 
+/// @brief collision on a collision traversal node of the concrete type
+/// NodeType, traversed by collisionTraverse() without virtual calls; can use
+/// front list to accelerate
+template <typename NodeType>
+void collideNode(NodeType* node, BVHFrontList* front_list = nullptr);
+
 /// @brief self collision on collision traversal node; can use front list to accelerate
 template <typename S>
 void selfCollide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list = nullptr);
@@ -63,6 +69,17 @@ void selfCollide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list =
 template <typename S>
 void distance(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list = nullptr, int qsize = 2);
 
+/// @brief distance computation on a distance traversal node of the concrete
+/// type NodeType, traversed by distanceTraverse() without virtual calls when
+/// qsize <= 2; can use front list to accelerate
+template <typename NodeType>
+void distanceNode(NodeType* node, BVHFrontList* front_list = nullptr, int qsize = 2);
+
+/// @brief distance computation on a BVH distance traversal node using
+/// num_threads threads; see distanceParallelRecurse()
+template <typename NodeType>
+void distanceParallel(NodeType* node, unsigned int num_threads, int qsize = 2);
+
 /// @brief special collision on OBB traversal node
 template <typename S>
 void collide2(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list = nullptr);
@@ -91,6 +91,21 @@ bool initialize(
     const DistanceRequest<double>& request,
     DistanceResult<double>& result);
 
+//==============================================================================
+extern template
+double triSignedDistance(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    Vector3<double>& P, Vector3<double>& Q);
+
+//==============================================================================
+extern template
+double triSignedDistance(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    const Transform3<double>& tf,
+    Vector3<double>& P, Vector3<double>& Q);
+
 //==============================================================================
 template <typename BV>
 MeshDistanceTraversalNode<BV>::MeshDistanceTraversalNode() : BVHDistanceTraversalNode<BV>()
@@ -104,6 +119,17 @@ MeshDistanceTraversalNode<BV>::MeshDistanceTraversalNode() : BVHDistanceTraversa
   abs_err = this->request.abs_err;
 }
 
+//==============================================================================
+template <typename BV>
+typename BV::S MeshDistanceTraversalNode<BV>::BVTesting(int b1, int b2) const
+{
+  S d = BVHDistanceTraversalNode<BV>::BVTesting(b1, b2);
+  if(this->request.enable_signed_distance && d <= 0)
+    return -maxPenetrationDepth(this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+
+  return d;
+}
+
 //==============================================================================
 template <typename BV>
 void MeshDistanceTraversalNode<BV>::leafTesting(int b1, int b2) const
@@ -130,8 +156,11 @@ void MeshDistanceTraversalNode<BV>::leafTesting(int b1, int b2) const
   // nearest point pair
   Vector3<S> P1, P2;
 
-  S d = TriangleDistance<S>::triDistance(t11, t12, t13, t21, t22, t23,
-                                           P1, P2);
+  S d;
+  if(this->request.enable_signed_distance)
+    d = triSignedDistance(t11, t12, t13, t21, t22, t23, P1, P2);
+  else
+    d = TriangleDistance<S>::triDistance(t11, t12, t13, t21, t22, t23, P1, P2);
 
   if(this->request.enable_nearest_points)
   {
@@ -489,8 +518,12 @@ void meshDistanceOrientedNodeLeafTesting(
   // nearest point pair
   Vector3<S> P1, P2;
 
-  S d = TriangleDistance<S>::triDistance(
-        t11, t12, t13, t21, t22, t23, tf, P1, P2);
+  S d;
+  if(request.enable_signed_distance)
+    d = triSignedDistance(t11, t12, t13, t21, t22, t23, tf, P1, P2);
+  else
+    d = TriangleDistance<S>::triDistance(
+          t11, t12, t13, t21, t22, t23, tf, P1, P2);
 
   if(request.enable_nearest_points)
     result.update(d, model1, model2, primitive_id1, primitive_id2, P1, P2);
@@ -498,6 +531,61 @@ void meshDistanceOrientedNodeLeafTesting(
     result.update(d, model1, model2, primitive_id1, primitive_id2);
 }
 
+//==============================================================================
+template <typename S>
+S triSignedDistance(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    Vector3<S>& P, Vector3<S>& Q)
+{
+  S d = TriangleDistance<S>::triDistance(P1, P2, P3, Q1, Q2, Q3, P, Q);
+  if(d > 0)
+    return d;
+
+  Vector3<S> contacts[2];
+  unsigned int num_contacts = 0;
+  S depth = 0;
+  Vector3<S> normal;
+  if(Intersect<S>::intersect_Triangle(P1, P2, P3, Q1, Q2, Q3,
+                                      contacts, &num_contacts, &depth, &normal)
+     && num_contacts > 0 && depth > 0)
+  {
+    P = contacts[0];
+    Q = contacts[0];
+    return -depth;
+  }
+
+  return d;
+}
+
+//==============================================================================
+template <typename S>
+S triSignedDistance(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Transform3<S>& tf,
+    Vector3<S>& P, Vector3<S>& Q)
+{
+  S d = TriangleDistance<S>::triDistance(P1, P2, P3, Q1, Q2, Q3, tf, P, Q);
+  if(d > 0)
+    return d;
+
+  Vector3<S> contacts[2];
+  unsigned int num_contacts = 0;
+  S depth = 0;
+  Vector3<S> normal;
+  if(Intersect<S>::intersect_Triangle(P1, P2, P3, Q1, Q2, Q3, tf,
+                                      contacts, &num_contacts, &depth, &normal)
+     && num_contacts > 0 && depth > 0)
+  {
+    P = contacts[0];
+    Q = contacts[0];
+    return -depth;
+  }
+
+  return d;
+}
+
 //==============================================================================
 template <typename BV>
 void distancePreprocessOrientedNode(
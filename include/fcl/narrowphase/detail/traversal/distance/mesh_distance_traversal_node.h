@@ -39,9 +39,11 @@
 #define FCL_TRAVERSAL_MESHDISTANCETRAVERSALNODE_H
 
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/triangle_distance.h"
+#include "fcl/narrowphase/detail/traversal/collision/intersect.h"
 #include "fcl/math/bv/RSS.h"
 #include "fcl/math/bv/OBBRSS.h"
 #include "fcl/math/bv/kIOS.h"
+#include "fcl/math/bv/utility.h"
 #include "fcl/narrowphase/detail/traversal/distance/bvh_distance_traversal_node.h"
 
 namespace fcl
@@ -60,6 +62,10 @@ public:
 
   MeshDistanceTraversalNode();
 
+  /// @brief BV culling test in one BVTT node. Overlapping BVs return the
+  /// negated bound on the penetration depth when signed distance is requested
+  S BVTesting(int b1, int b2) const;
+
   /// @brief Distance testing between leaves (two triangles)
   void leafTesting(int b1, int b2) const;
 
@@ -106,7 +112,13 @@ public:
   {
     if (this->enable_statistics) this->num_bv_tests++;
 
-    return distance(tf.linear(), tf.translation(), this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+    const auto& bv1 = this->model1->getBV(b1).bv;
+    const auto& bv2 = this->model2->getBV(b2).bv;
+    S d = distance(tf.linear(), tf.translation(), bv1, bv2);
+    if(this->request.enable_signed_distance && d <= 0)
+      return -maxPenetrationDepth(bv1, bv2);
+
+    return d;
   }
 
   void leafTesting(int b1, int b2) const;
@@ -146,7 +158,13 @@ public:
   {
     if (this->enable_statistics) this->num_bv_tests++;
 
-    return distance(tf.linear(), tf.translation(), this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+    const auto& bv1 = this->model1->getBV(b1).bv;
+    const auto& bv2 = this->model2->getBV(b2).bv;
+    S d = distance(tf.linear(), tf.translation(), bv1, bv2);
+    if(this->request.enable_signed_distance && d <= 0)
+      return -maxPenetrationDepth(bv1, bv2);
+
+    return d;
   }
 
   void leafTesting(int b1, int b2) const;
@@ -186,7 +204,13 @@ public:
   {
     if (this->enable_statistics) this->num_bv_tests++;
 
-    return distance(tf.linear(), tf.translation(), this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+    const auto& bv1 = this->model1->getBV(b1).bv;
+    const auto& bv2 = this->model2->getBV(b2).bv;
+    S d = distance(tf.linear(), tf.translation(), bv1, bv2);
+    if(this->request.enable_signed_distance && d <= 0)
+      return -maxPenetrationDepth(bv1, bv2);
+
+    return d;
   }
 
   void leafTesting(int b1, int b2) const;
@@ -211,6 +235,25 @@ bool initialize(
     const DistanceRequest<S>& request,
     DistanceResult<S>& result);
 
+/// @brief Signed distance between two triangles: the separation distance if
+/// they are disjoint, otherwise the negated penetration depth of
+/// Intersect::intersect_Triangle(), with P and Q both set to the deepest
+/// contact point.
+template <typename S>
+S triSignedDistance(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    Vector3<S>& P, Vector3<S>& Q);
+
+/// @brief Signed distance between two triangles, the second one in
+/// configuration tf relative to the first
+template <typename S>
+S triSignedDistance(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Transform3<S>& tf,
+    Vector3<S>& P, Vector3<S>& Q);
+
 template <typename BV>
 FCL_DEPRECATED
 void meshDistanceOrientedNodeLeafTesting(
@@ -39,9 +39,6 @@
 #define FCL_TRAVERSAL_OCTREE_MESHOCTREECOLLISIONTRAVERSALNODE_H
 
 #include "fcl/config.h"
-#if not(FCL_HAVE_OCTOMAP)
-#error "This header requires fcl to be compiled with octomap support"
-#endif
 
 #include "fcl/geometry/octree/octree.h"
 #include "fcl/geometry/bvh/BVH_model.h"
@@ -268,6 +268,62 @@ void OcTreeSolver<NarrowPhaseSolver>::ShapeOcTreeDistance(
                              tf2, tf1);
 }
 
+//==============================================================================
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S OcTreeSolver<NarrowPhaseSolver>::distanceBound(
+    const AABB<S>& aabb1, const AABB<S>& aabb2) const
+{
+  S d = aabb1.distance(aabb2);
+  if(drequest->enable_signed_distance && d <= 0)
+  {
+    // Moving one box by the overlap along any axis separates the boxes, and so
+    // the solids they enclose. The diameter of the smaller box does not bound
+    // this: a small cell can lie deep inside a large shape.
+    S depth = std::numeric_limits<S>::max();
+    for(int i = 0; i < 3; ++i)
+    {
+      depth = std::min(depth, std::min(aabb1.max_[i] - aabb2.min_[i],
+                                       aabb2.max_[i] - aabb1.min_[i]));
+    }
+    return -depth;
+  }
+
+  return d;
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+bool OcTreeSolver<NarrowPhaseSolver>::distanceSatisfied() const
+{
+  return !drequest->enable_signed_distance && drequest->isSatisfied(*dresult);
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+template <typename Shape>
+void OcTreeSolver<NarrowPhaseSolver>::penetrationDistance(
+    const Box<S>& box, const Transform3<S>& box_tf,
+    const Shape& s, const Transform3<S>& tf2,
+    S& dist, Vector3<S>& p1, Vector3<S>& p2) const
+{
+  // Touching objects may still report a negative distance
+  dist = 0;
+
+  std::vector<ContactPoint<S>> contacts;
+  if(!solver->shapeIntersect(box, box_tf, s, tf2, &contacts))
+    return;
+
+  for(const auto& contact : contacts)
+  {
+    if(-contact.penetration_depth < dist)
+    {
+      dist = -contact.penetration_depth;
+      p1 = contact.pos;
+      p2 = contact.pos;
+    }
+  }
+}
+
 //==============================================================================
 template <typename NarrowPhaseSolver>
 template <typename Shape>
@@ -293,10 +349,12 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeShapeDistanceRecurse(const OcTree<S>
       Vector3<S> closest_p1 = Vector3<S>::Zero();
       Vector3<S> closest_p2 = Vector3<S>::Zero();
       solver->shapeDistance(box, box_tf, s, tf2, &dist, &closest_p1, &closest_p2);
+      if(drequest->enable_signed_distance && dist <= 0)
+        penetrationDistance(box, box_tf, s, tf2, dist, closest_p1, closest_p2);
 
       dresult->update(dist, tree1, &s, root1 - tree1->getRoot(), DistanceResult<S>::NONE, closest_p1, closest_p2);
 
-      return drequest->isSatisfied(*dresult);
+      return distanceSatisfied();
     }
     else
       return false;
@@ -314,7 +372,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeShapeDistanceRecurse(const OcTree<S>
 
       AABB<S> aabb1;
       convertBV(child_bv, tf1, aabb1);
-      S d = aabb1.distance(aabb2);
+      S d = distanceBound(aabb1, aabb2);
       if(d < dresult->min_distance)
       {
         if(OcTreeShapeDistanceRecurse(tree1, child, child_bv, s, aabb2, tf1, tf2))
@@ -506,9 +564,22 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeMeshDistanceRecurse(const OcTree<S>*
       Vector3<S> closest_p1, closest_p2;
       solver->shapeTriangleDistance(box, box_tf, p1, p2, p3, tf2, &dist, &closest_p1, &closest_p2);
 
-      dresult->update(dist, tree1, tree2, root1 - tree1->getRoot(), primitive_id);
+      Vector3<S> contact;
+      S depth;
+      Vector3<S> normal;
+      if(drequest->enable_signed_distance && dist <= 0)
+      {
+        // Touching objects may still report a negative distance
+        if(solver->shapeTriangleIntersect(box, box_tf, p1, p2, p3, tf2, &contact, &depth, &normal)
+           && depth > 0)
+          dresult->update(-depth, tree1, tree2, root1 - tree1->getRoot(), primitive_id, contact, contact);
+        else
+          dresult->update(0, tree1, tree2, root1 - tree1->getRoot(), primitive_id);
+      }
+      else
+        dresult->update(dist, tree1, tree2, root1 - tree1->getRoot(), primitive_id);
 
-      return drequest->isSatisfied(*dresult);
+      return distanceSatisfied();
     }
     else
       return false;
@@ -530,7 +601,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeMeshDistanceRecurse(const OcTree<S>*
         AABB<S> aabb1, aabb2;
         convertBV(child_bv, tf1, aabb1);
         convertBV(tree2->getBV(root2).bv, tf2, aabb2);
-        d = aabb1.distance(aabb2);
+        d = distanceBound(aabb1, aabb2);
 
         if(d < dresult->min_distance)
         {
@@ -547,7 +618,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeMeshDistanceRecurse(const OcTree<S>*
     convertBV(bv1, tf1, aabb1);
     int child = tree2->getBV(root2).leftChild();
     convertBV(tree2->getBV(child).bv, tf2, aabb2);
-    d = aabb1.distance(aabb2);
+    d = distanceBound(aabb1, aabb2);
 
     if(d < dresult->min_distance)
     {
@@ -557,7 +628,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeMeshDistanceRecurse(const OcTree<S>*
 
     child = tree2->getBV(root2).rightChild();
     convertBV(tree2->getBV(child).bv, tf2, aabb2);
-    d = aabb1.distance(aabb2);
+    d = distanceBound(aabb1, aabb2);
 
     if(d < dresult->min_distance)
     {
@@ -783,10 +854,12 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeDistanceRecurse(const OcTree<S>* tre
       Vector3<S> closest_p1 = Vector3<S>::Zero();
       Vector3<S> closest_p2 = Vector3<S>::Zero();
       solver->shapeDistance(box1, box1_tf, box2, box2_tf, &dist, &closest_p1, &closest_p2);
+      if(drequest->enable_signed_distance && dist <= 0)
+        penetrationDistance(box1, box1_tf, box2, box2_tf, dist, closest_p1, closest_p2);
 
       dresult->update(dist, tree1, tree2, root1 - tree1->getRoot(), root2 - tree2->getRoot(), closest_p1, closest_p2);
 
-      return drequest->isSatisfied(*dresult);
+      return distanceSatisfied();
     }
     else
       return false;
@@ -808,7 +881,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeDistanceRecurse(const OcTree<S>* tre
         AABB<S> aabb1, aabb2;
         convertBV(bv1, tf1, aabb1);
         convertBV(bv2, tf2, aabb2);
-        d = aabb1.distance(aabb2);
+        d = distanceBound(aabb1, aabb2);
 
         if(d < dresult->min_distance)
         {
@@ -833,7 +906,7 @@ bool OcTreeSolver<NarrowPhaseSolver>::OcTreeDistanceRecurse(const OcTree<S>* tre
         AABB<S> aabb1, aabb2;
         convertBV(bv1, tf1, aabb1);
         convertBV(bv2, tf2, aabb2);
-        d = aabb1.distance(aabb2);
+        d = distanceBound(aabb1, aabb2);
 
         if(d < dresult->min_distance)
         {
@@ -38,10 +38,10 @@
 #ifndef FCL_TRAVERSAL_OCTREE_OCTREESOLVER_H
 #define FCL_TRAVERSAL_OCTREE_OCTREESOLVER_H
 
+#include <algorithm>
+#include <limits>
+
 #include "fcl/config.h"
-#if not(FCL_HAVE_OCTOMAP)
-#error "This header requires fcl to be compiled with octomap support"
-#endif
 
 #include "fcl/math/bv/utility.h"
 #include "fcl/geometry/octree/octree.h"
@@ -143,6 +143,24 @@ public:
 
 private:
 
+  /// @brief Distance between two world space AABBs used for pruning. When
+  /// signed distance is requested, overlapping boxes return the negated
+  /// smallest translation that separates them, which bounds the penetration
+  /// depth of their contents
+  S distanceBound(const AABB<S>& aabb1, const AABB<S>& aabb2) const;
+
+  /// @brief Whether the distance traversal can stop: once the objects touch,
+  /// unless signed distance is still searching for the deepest penetration
+  bool distanceSatisfied() const;
+
+  /// @brief Replace a non-positive distance between an occupied cell and a
+  /// shape by the negated penetration depth, with both witness points at the
+  /// deepest contact, or by zero if the two only touch
+  template <typename Shape>
+  void penetrationDistance(const Box<S>& box, const Transform3<S>& box_tf,
+                           const Shape& s, const Transform3<S>& tf2,
+                           S& dist, Vector3<S>& p1, Vector3<S>& p2) const;
+
   template <typename Shape>
   bool OcTreeShapeDistanceRecurse(const OcTree<S>* tree1, const typename OcTree<S>::OcTreeNode* root1, const AABB<S>& bv1,
                                   const Shape& s, const AABB<S>& aabb2,
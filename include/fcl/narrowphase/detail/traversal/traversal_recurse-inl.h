@@ -40,9 +40,13 @@
 
 #include "fcl/narrowphase/detail/traversal/traversal_recurse.h"
 
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
 
 #include "fcl/common/unused.h"
+#include "fcl/common/detail/parallel.h"
 
 namespace fcl
 {
@@ -78,6 +82,10 @@ void distanceQueueRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b
 extern template
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
 
+//==============================================================================
+extern template
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase<double>* node, BVHFrontList* front_list);
+
 //==============================================================================
 template <typename S>
 void collisionRecurse(CollisionTraversalNodeBase<S>* node, int b1, int b2, BVHFrontList* front_list)
@@ -334,47 +342,240 @@ struct BVT_Comparer
 };
 
 //==============================================================================
+/** @brief Priority queue of BVTs, closest first. The heap lives at the end of
+ * a per-thread arena that keeps its capacity from one query to the next;
+ * queues of nested recursions stack on top of each other and give their part
+ * of the arena back when destroyed. */
 template <typename S>
 struct BVTQ
 {
-  BVTQ() : qsize(2) {}
+  BVTQ() : qsize(2), arena(threadLocalArena()), base(arena.size()) {}
+
+  BVTQ(const BVTQ&) = delete;
+  BVTQ& operator=(const BVTQ&) = delete;
+
+  ~BVTQ()
+  {
+    arena.resize(base);
+  }
 
   bool empty() const
   {
-    return pq.empty();
+    return arena.size() == base;
   }
 
   size_t size() const
   {
-    return pq.size();
+    return arena.size() - base;
   }
 
   const BVT<S>& top() const
   {
-    return pq.top();
+    return arena[base];
   }
 
   void push(const BVT<S>& x)
   {
-    pq.push(x);
+    arena.push_back(x);
+    std::push_heap(arena.begin() + base, arena.end(), BVT_Comparer<S>());
   }
 
   void pop()
   {
-    pq.pop();
+    std::pop_heap(arena.begin() + base, arena.end(), BVT_Comparer<S>());
+    arena.pop_back();
   }
 
   bool full() const
   {
-    return (pq.size() + 1 >= qsize);
+    return (size() + 1 >= qsize);
   }
 
-  std::priority_queue<BVT<S>, std::vector<BVT<S>>, BVT_Comparer<S>> pq;
+  static std::vector<BVT<S>>& threadLocalArena()
+  {
+    static thread_local std::vector<BVT<S>> arena;
+    return arena;
+  }
 
   /** @brief Queue size */
   unsigned int qsize;
+
+  std::vector<BVT<S>>& arena;
+
+  /** @brief Start of this queue in the arena */
+  size_t base;
+};
+
+//==============================================================================
+/** @brief Stack of BVTs for the iterative traversals. Like BVTQ, it lives at
+ * the end of a per-thread arena that keeps its capacity between queries. */
+template <typename S>
+struct BVTStack
+{
+  BVTStack() : arena(threadLocalArena()), base(arena.size()) {}
+
+  BVTStack(const BVTStack&) = delete;
+  BVTStack& operator=(const BVTStack&) = delete;
+
+  ~BVTStack()
+  {
+    arena.resize(base);
+  }
+
+  bool empty() const
+  {
+    return arena.size() == base;
+  }
+
+  const BVT<S>& top() const
+  {
+    return arena.back();
+  }
+
+  void push(const BVT<S>& x)
+  {
+    arena.push_back(x);
+  }
+
+  void push(int b1, int b2, S d = S(0))
+  {
+    arena.push_back(BVT<S>{d, b1, b2});
+  }
+
+  void pop()
+  {
+    arena.pop_back();
+  }
+
+  static std::vector<BVT<S>>& threadLocalArena()
+  {
+    static thread_local std::vector<BVT<S>> arena;
+    return arena;
+  }
+
+  std::vector<BVT<S>>& arena;
+
+  /** @brief Start of this stack in the arena */
+  size_t base;
 };
 
+//==============================================================================
+template <typename NodeType>
+void collisionTraverse(NodeType* node, int b1, int b2, BVHFrontList* front_list)
+{
+  using S = typename NodeType::S;
+
+  // The node is called through NodeType:: so that the calls are bound
+  // statically. The first child is visited right away and the second one is
+  // left on the stack, which gives the order of collisionRecurse().
+  BVTStack<S> stack;
+
+  while(true)
+  {
+    if(node->NodeType::isFirstNodeLeaf(b1) && node->NodeType::isSecondNodeLeaf(b2))
+    {
+      updateFrontList(front_list, b1, b2);
+
+      if(!node->NodeType::BVTesting(b1, b2))
+        node->NodeType::leafTesting(b1, b2);
+    }
+    else if(node->NodeType::BVTesting(b1, b2))
+    {
+      updateFrontList(front_list, b1, b2);
+    }
+    else
+    {
+      if(node->NodeType::firstOverSecond(b1, b2))
+      {
+        stack.push(node->NodeType::getFirstRightChild(b1), b2);
+        b1 = node->NodeType::getFirstLeftChild(b1);
+      }
+      else
+      {
+        stack.push(b1, node->NodeType::getSecondRightChild(b2));
+        b2 = node->NodeType::getSecondLeftChild(b2);
+      }
+      continue;
+    }
+
+    if(stack.empty()) return;
+
+    // early stop is disabled is front_list is used
+    if(!front_list && node->NodeType::canStop()) return;
+
+    b1 = stack.top().b1;
+    b2 = stack.top().b2;
+    stack.pop();
+  }
+}
+
+//==============================================================================
+template <typename NodeType>
+void distanceTraverse(NodeType* node, int b1, int b2, BVHFrontList* front_list)
+{
+  using S = typename NodeType::S;
+
+  // The closer child is visited right away and the farther one is left on the
+  // stack; it is only checked against canStop() once the closer subtree is
+  // done, as in distanceRecurse().
+  BVTStack<S> stack;
+  BVT<S> test;
+  test.b1 = b1;
+  test.b2 = b2;
+
+  while(true)
+  {
+    if(node->NodeType::isFirstNodeLeaf(test.b1) && node->NodeType::isSecondNodeLeaf(test.b2))
+    {
+      updateFrontList(front_list, test.b1, test.b2);
+
+      node->NodeType::leafTesting(test.b1, test.b2);
+    }
+    else
+    {
+      BVT<S> bvt1 = test;
+      BVT<S> bvt2 = test;
+      if(node->NodeType::firstOverSecond(test.b1, test.b2))
+      {
+        bvt1.b1 = node->NodeType::getFirstLeftChild(test.b1);
+        bvt2.b1 = node->NodeType::getFirstRightChild(test.b1);
+      }
+      else
+      {
+        bvt1.b2 = node->NodeType::getSecondLeftChild(test.b2);
+        bvt2.b2 = node->NodeType::getSecondRightChild(test.b2);
+      }
+      bvt1.d = node->NodeType::BVTesting(bvt1.b1, bvt1.b2);
+      bvt2.d = node->NodeType::BVTesting(bvt2.b1, bvt2.b2);
+
+      if(bvt2.d < bvt1.d)
+        std::swap(bvt1, bvt2);
+
+      stack.push(bvt2);
+      if(!node->NodeType::canStop(bvt1.d))
+      {
+        test = bvt1;
+        continue;
+      }
+
+      updateFrontList(front_list, bvt1.b1, bvt1.b2);
+    }
+
+    // pop pairs until one that cannot be pruned is found
+    while(true)
+    {
+      if(stack.empty()) return;
+
+      test = stack.top();
+      stack.pop();
+
+      if(!node->NodeType::canStop(test.d)) break;
+
+      updateFrontList(front_list, test.b1, test.b2);
+    }
+  }
+}
+
 //==============================================================================
 template <typename S>
 void distanceQueueRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BVHFrontList* front_list, int qsize)
@@ -446,70 +647,242 @@ void distanceQueueRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BV
 
       if(node->canStop(min_test.d))
       {
+        // the pairs left in the queue are pruned as well
         updateFrontList(front_list, min_test.b1, min_test.b2);
+        for(; front_list && !bvtq.empty(); bvtq.pop())
+          updateFrontList(front_list, bvtq.top().b1, bvtq.top().b2);
         break;
       }
     }
   }
 }
 
+//==============================================================================
+/** @brief Copy of a distance traversal node for one worker of
+ * distanceParallelRecurse(). It prunes against the smallest distance found by
+ * any worker and publishes its own improvements to it. */
+template <typename NodeType>
+class SharedBoundDistanceNode : public NodeType
+{
+public:
+  using S = typename NodeType::S;
+
+  SharedBoundDistanceNode(const NodeType& node, std::atomic<S>* bound_)
+    : NodeType(node), bound(bound_)
+  {
+  }
+
+  void leafTesting(int b1, int b2) const
+  {
+    NodeType::leafTesting(b1, b2);
+
+    const S d = this->result->min_distance;
+    S current = bound->load(std::memory_order_relaxed);
+    while(d < current
+          && !bound->compare_exchange_weak(current, d, std::memory_order_relaxed))
+    {
+      // current is reloaded by compare_exchange_weak
+    }
+  }
+
+  bool canStop(S c) const
+  {
+    return NodeType::canStop(c) || c >= bound->load(std::memory_order_relaxed);
+  }
+
+  std::atomic<S>* bound;
+};
+
+//==============================================================================
+template <typename NodeType>
+void distanceParallelRecurse(NodeType* node, int b1, int b2, int qsize, unsigned int num_threads)
+{
+  using S = typename NodeType::S;
+  using WorkerNode = SharedBoundDistanceNode<NodeType>;
+
+  num_threads = resolveNumThreads(num_threads);
+  if(num_threads <= 1)
+  {
+    if(qsize <= 2)
+      distanceTraverse(node, b1, b2, nullptr);
+    else
+      distanceQueueRecurse(node, b1, b2, nullptr, qsize);
+    return;
+  }
+
+  // Expand the BVTT best first until there are enough subtree pairs to keep
+  // every thread busy
+  const size_t num_tasks = 32 * static_cast<size_t>(num_threads);
+  std::vector<BVT<S>> tasks;
+  {
+    BVTQ<S> bvtq;
+    BVT<S> root;
+    root.b1 = b1;
+    root.b2 = b2;
+    root.d = node->BVTesting(b1, b2);
+    bvtq.push(root);
+
+    while(!bvtq.empty() && bvtq.size() + tasks.size() < num_tasks)
+    {
+      BVT<S> min_test = bvtq.top();
+      bvtq.pop();
+
+      if(node->canStop(min_test.d))
+        continue;
+
+      if(node->isFirstNodeLeaf(min_test.b1) && node->isSecondNodeLeaf(min_test.b2))
+      {
+        tasks.push_back(min_test);
+        continue;
+      }
+
+      BVT<S> bvt1 = min_test;
+      BVT<S> bvt2 = min_test;
+      if(node->firstOverSecond(min_test.b1, min_test.b2))
+      {
+        bvt1.b1 = node->getFirstLeftChild(min_test.b1);
+        bvt2.b1 = node->getFirstRightChild(min_test.b1);
+      }
+      else
+      {
+        bvt1.b2 = node->getSecondLeftChild(min_test.b2);
+        bvt2.b2 = node->getSecondRightChild(min_test.b2);
+      }
+      bvt1.d = node->BVTesting(bvt1.b1, bvt1.b2);
+      bvt2.d = node->BVTesting(bvt2.b1, bvt2.b2);
+
+      bvtq.push(bvt1);
+      bvtq.push(bvt2);
+    }
+
+    while(!bvtq.empty())
+    {
+      tasks.push_back(bvtq.top());
+      bvtq.pop();
+    }
+  }
+
+  // Hand the subtree pairs out closest first
+  std::sort(tasks.begin(), tasks.end(),
+            [](const BVT<S>& lhs, const BVT<S>& rhs) { return lhs.d < rhs.d; });
+
+  std::atomic<S> bound(node->result->min_distance);
+  std::vector<DistanceResult<S>> results(num_threads, *node->result);
+  std::vector<WorkerNode, Eigen::aligned_allocator<WorkerNode>> workers;
+  workers.reserve(num_threads);
+  for(unsigned int i = 0; i < num_threads; ++i)
+  {
+    workers.emplace_back(*node, &bound);
+    workers.back().result = &results[i];
+  }
+
+  parallelFor(tasks.size(), num_threads, [&](size_t i, unsigned int thread_id)
+  {
+    WorkerNode& worker = workers[thread_id];
+    const BVT<S>& task = tasks[i];
+
+    if(worker.canStop(task.d))
+      return;
+
+    if(worker.isFirstNodeLeaf(task.b1) && worker.isSecondNodeLeaf(task.b2))
+      worker.leafTesting(task.b1, task.b2);
+    else if(qsize <= 2)
+      distanceTraverse(&worker, task.b1, task.b2, nullptr);
+    else
+      distanceQueueRecurse(&worker, task.b1, task.b2, nullptr, qsize);
+  });
+
+  const int num_bv_tests = node->num_bv_tests;
+  const int num_leaf_tests = node->num_leaf_tests;
+  for(unsigned int i = 0; i < num_threads; ++i)
+  {
+    node->result->update(results[i]);
+    node->num_bv_tests += workers[i].num_bv_tests - num_bv_tests;
+    node->num_leaf_tests += workers[i].num_leaf_tests - num_leaf_tests;
+  }
+}
+
 //==============================================================================
 template <typename S>
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
 {
-  BVHFrontList::iterator front_iter;
+  // The nodes replacing the invalidated ones go to a separate list so that
+  // the loop only visits the front of the previous query
   BVHFrontList append;
-  for(front_iter = front_list->begin(); front_iter != front_list->end(); ++front_iter)
+  const std::size_t front_size = front_list->size();
+  for(std::size_t i = 0; i < front_size; ++i)
   {
-    int b1 = front_iter->left;
-    int b2 = front_iter->right;
+    BVHFrontNode& front_node = (*front_list)[i];
+    int b1 = front_node.left;
+    int b2 = front_node.right;
     bool l1 = node->isFirstNodeLeaf(b1);
     bool l2 = node->isSecondNodeLeaf(b2);
 
     if(l1 & l2)
     {
-      front_iter->valid = false; // the front node is no longer valid, in collideRecurse will add again.
+      front_node.valid = false; // the front node is no longer valid, in collideRecurse will add again.
       collisionRecurse(node, b1, b2, &append);
     }
     else
     {
       if(!node->BVTesting(b1, b2))
       {
-        front_iter->valid = false;
+        front_node.valid = false;
 
         if(node->firstOverSecond(b1, b2))
         {
           int c1 = node->getFirstLeftChild(b1);
           int c2 = node->getFirstRightChild(b1);
 
-          collisionRecurse(node, c1, b2, front_list);
-          collisionRecurse(node, c2, b2, front_list);
+          collisionRecurse(node, c1, b2, &append);
+          collisionRecurse(node, c2, b2, &append);
         }
         else
         {
           int c1 = node->getSecondLeftChild(b2);
           int c2 = node->getSecondRightChild(b2);
 
-          collisionRecurse(node, b1, c1, front_list);
-          collisionRecurse(node, b1, c2, front_list);
+          collisionRecurse(node, b1, c1, &append);
+          collisionRecurse(node, b1, c2, &append);
         }
       }
     }
   }
 
-
   // clean the old front list (remove invalid node)
-  for(front_iter = front_list->begin(); front_iter != front_list->end();)
+  front_list->erase(
+        std::remove_if(front_list->begin(), front_list->end(),
+                       [](const BVHFrontNode& front_node) { return !front_node.valid; }),
+        front_list->end());
+
+  front_list->insert(front_list->end(), append.begin(), append.end());
+}
+
+//==============================================================================
+template <typename S>
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list)
+{
+  // Every leaf pair lies below exactly one node of the previous front. Visit
+  // the front closest first so that the farther nodes are pruned against the
+  // best distance found so far, and rebuild the front while doing so.
+  std::vector<BVT<S>> tests(front_list->size());
+  for(std::size_t i = 0; i < tests.size(); ++i)
   {
-    if(!front_iter->valid)
-      front_iter = front_list->erase(front_iter);
-    else
-      ++front_iter;
+    tests[i].b1 = (*front_list)[i].left;
+    tests[i].b2 = (*front_list)[i].right;
+    tests[i].d = node->BVTesting(tests[i].b1, tests[i].b2);
   }
 
-  for(front_iter = append.begin(); front_iter != append.end(); ++front_iter)
+  std::sort(tests.begin(), tests.end(),
+            [](const BVT<S>& lhs, const BVT<S>& rhs) { return lhs.d < rhs.d; });
+
+  front_list->clear();
+  for(const auto& test : tests)
   {
-    front_list->push_back(*front_iter);
+    if(node->canStop(test.d))
+      updateFrontList(front_list, test.b1, test.b2);
+    else
+      distanceRecurse(node, test.b1, test.b2, front_list);
   }
 }
 
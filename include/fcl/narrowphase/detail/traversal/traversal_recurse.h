@@ -70,14 +70,40 @@ void selfCollisionRecurse(CollisionTraversalNodeBase<S>* node, int b, BVHFrontLi
 template <typename S>
 void distanceRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BVHFrontList* front_list);
 
+/// @brief Iterative counterpart of collisionRecurse() for a node of the
+/// concrete type NodeType. The pairs to visit are kept on an explicit stack
+/// and the node is called without virtual dispatch, so that the BV tests and
+/// child lookups of NodeType can be inlined.
+template <typename NodeType>
+void collisionTraverse(NodeType* node, int b1, int b2, BVHFrontList* front_list);
+
+/// @brief Iterative counterpart of distanceRecurse() for a node of the
+/// concrete type NodeType; see collisionTraverse()
+template <typename NodeType>
+void distanceTraverse(NodeType* node, int b1, int b2, BVHFrontList* front_list);
+
 /// @brief Recurse function for distance, using queue acceleration
 template <typename S>
 void distanceQueueRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BVHFrontList* front_list, int qsize);
 
+/// @brief Recurse function for distance on num_threads threads (0 means one
+/// per hardware thread). The BVTT is expanded best first into subtree pairs,
+/// which are handed out closest first to workers traversing them with their
+/// own copy of the node and result; the workers share the smallest distance
+/// found so far through an atomic and prune against it. The results are
+/// merged into node->result. Front lists are not supported.
+template <typename NodeType>
+void distanceParallelRecurse(NodeType* node, int b1, int b2, int qsize, unsigned int num_threads);
+
 /// @brief Recurse function for front list propagation
 template <typename S>
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list);
 
+/// @brief Front list propagation for distance: the front of the previous
+/// query is visited closest first and replaced by the front of this one
+template <typename S>
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list);
+
 } // namespace detail
 } // namespace fcl
 
@@ -137,13 +137,17 @@ typename NarrowPhaseSolver::S distance(
     }
   }
 
+  // Mesh-mesh and octree queries compute the penetration depth within the
+  // distance traversal itself, bounding the depth reachable under each pair of
+  // overlapping BVs (see maxPenetrationDepth() and
+  // OcTreeSolver::distanceBound()).
+  //
   // TODO(JS): FCL supports negative distance calculation only for OT_GEOM shape
   // types (i.e., primitive shapes like sphere, cylinder, box, and so on). As a
-  // workaround for the rest shape types like mesh and octree, following
-  // computes negative distance using additional penetration depth computation
-  // of collision checking routine. The downside of this workaround is that the
-  // pair of nearest points is not guaranteed to be on the surface of the
-  // objects.
+  // workaround for the remaining mesh-shape pairs, following computes negative
+  // distance using additional penetration depth computation of collision
+  // checking routine. The downside of this workaround is that the pair of
+  // nearest points is not guaranteed to be on the surface of the objects.
   if(res
      && result.min_distance < static_cast<S>(0)
      && request.enable_signed_distance)
@@ -154,6 +158,15 @@ typename NarrowPhaseSolver::S distance(
       return res;
     }
 
+    if ((object_type1 == OT_BVH && object_type2 == OT_BVH)
+        || object_type1 == OT_OCTREE || object_type2 == OT_OCTREE)
+    {
+      if(!nsolver_)
+        delete nsolver;
+
+      return res;
+    }
+
     CollisionRequest<S> collision_request;
     collision_request.enable_contact = true;
 
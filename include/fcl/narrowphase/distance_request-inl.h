@@ -63,7 +63,8 @@ DistanceRequest<S>::DistanceRequest(
     rel_err(rel_err_),
     abs_err(abs_err_),
     distance_tolerance(distance_tolerance_),
-    gjk_solver_type(gjk_solver_type_)
+    gjk_solver_type(gjk_solver_type_),
+    num_threads(1)
 {
   // Do nothing
 }
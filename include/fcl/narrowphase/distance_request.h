@@ -77,11 +77,12 @@ struct DistanceRequest
   /// NP_X: The pair of nearest points are NOT guaranteed to be on the surface
   ///       of objects.
   ///
-  /// If this flag is set to true, FCL will perform additional collision
-  /// checking when the two objects are in collision in order to get the exact
-  /// negative distance, which is the negated penetration depth. If there are
-  /// multiple contact for the two objects, then the maximum penetration depth
-  /// is used.
+  /// If this flag is set to true, FCL computes the negative distance, which is
+  /// the negated penetration depth, when the two objects are in collision. If
+  /// there are multiple contact for the two objects, then the maximum
+  /// penetration depth is used. Meshes and octrees obtain it in the same
+  /// traversal as the distance; other pairs perform additional collision
+  /// checking.
   ///
   /// If this flag is set to false, the result minimum distance is
   /// implementation defined (mostly -1).
@@ -101,6 +102,10 @@ struct DistanceRequest
   /// @brief narrow phase solver type
   GJKSolverType gjk_solver_type;
 
+  /// @brief Number of threads used to traverse the BVHs of mesh-mesh distance
+  /// queries; 0 means one per hardware thread. The default is 1.
+  unsigned int num_threads;
+
   explicit DistanceRequest(
       bool enable_nearest_points_ = false,
       bool enable_signed_distance = false,
@@ -40,6 +40,12 @@
 namespace fcl
 {
 
+template
+class SpatialHashingCollisionManager<
+    double,
+    detail::FlatHashTable<
+        AABB<double>, CollisionObject<double>*, detail::SpatialHash<double>>>;
+
 template
 class SpatialHashingCollisionManager<
     double,
@@ -0,0 +1,218 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/broadphase/detail/lbvh.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "fcl/common/detail/parallel.h"
+
+namespace fcl
+{
+
+/// @cond IGNORE
+namespace detail
+{
+
+namespace
+{
+
+/// @brief minimum number of primitives handled by each thread
+const std::size_t kMinPrimitivesPerThread = 4096;
+
+/// @brief number of bits sorted by each radix sort pass
+const int kRadixBits = 8;
+
+const std::size_t kRadixSize = std::size_t(1) << kRadixBits;
+
+//==============================================================================
+int countLeadingZeros(uint64 x)
+{
+  if(x == 0) return 64;
+
+  int n = 0;
+  if((x & 0xFFFFFFFF00000000ull) == 0) { n += 32; x <<= 32; }
+  if((x & 0xFFFF000000000000ull) == 0) { n += 16; x <<= 16; }
+  if((x & 0xFF00000000000000ull) == 0) { n += 8; x <<= 8; }
+  if((x & 0xF000000000000000ull) == 0) { n += 4; x <<= 4; }
+  if((x & 0xC000000000000000ull) == 0) { n += 2; x <<= 2; }
+  if((x & 0x8000000000000000ull) == 0) { n += 1; }
+  return n;
+}
+
+/// @brief Length of the common prefix of the keys i and j, the key of a leaf
+/// being its morton code followed by its position; -1 if j is out of range.
+struct CommonPrefix
+{
+  const std::vector<uint32>& codes;
+  std::int64_t n;
+
+  int operator()(std::int64_t i, std::int64_t j) const
+  {
+    if(j < 0 || j >= n) return -1;
+
+    const uint64 key_i = (uint64(codes[i]) << 32) | uint64(i);
+    const uint64 key_j = (uint64(codes[j]) << 32) | uint64(j);
+    return countLeadingZeros(key_i ^ key_j);
+  }
+};
+
+} // namespace
+
+//==============================================================================
+unsigned int lbvhNumThreads(std::size_t n, unsigned int num_threads)
+{
+  const std::size_t max_threads = 1 + n / kMinPrimitivesPerThread;
+  return static_cast<unsigned int>(
+        std::min<std::size_t>(resolveNumThreads(num_threads), max_threads));
+}
+
+//==============================================================================
+void radixSortMorton(
+    std::vector<uint32>& codes,
+    std::vector<std::size_t>& indices,
+    unsigned int num_threads)
+{
+  const std::size_t n = codes.size();
+  num_threads = lbvhNumThreads(n, num_threads);
+
+  std::vector<uint32> codes_tmp(n);
+  std::vector<std::size_t> indices_tmp(n);
+  std::vector<std::size_t> counts(num_threads * kRadixSize);
+
+  for(int shift = 0; shift < 30; shift += kRadixBits)
+  {
+    // Count the digits of each chunk
+    std::fill(counts.begin(), counts.end(), 0);
+    parallelForChunks(n, num_threads, [&](std::size_t begin, std::size_t end, unsigned int thread_id)
+    {
+      std::size_t* count = &counts[thread_id * kRadixSize];
+      for(std::size_t i = begin; i < end; ++i)
+        ++count[(codes[i] >> shift) & (kRadixSize - 1)];
+    });
+
+    // Turn the counts into the scatter offsets of each chunk, the chunks of a
+    // digit following each other to keep the sort stable
+    std::size_t offset = 0;
+    for(std::size_t digit = 0; digit < kRadixSize; ++digit)
+    {
+      for(unsigned int t = 0; t < num_threads; ++t)
+      {
+        const std::size_t count = counts[t * kRadixSize + digit];
+        counts[t * kRadixSize + digit] = offset;
+        offset += count;
+      }
+    }
+
+    parallelForChunks(n, num_threads, [&](std::size_t begin, std::size_t end, unsigned int thread_id)
+    {
+      std::size_t* next = &counts[thread_id * kRadixSize];
+      for(std::size_t i = begin; i < end; ++i)
+      {
+        const std::size_t dst = next[(codes[i] >> shift) & (kRadixSize - 1)]++;
+        codes_tmp[dst] = codes[i];
+        indices_tmp[dst] = indices[i];
+      }
+    });
+
+    codes.swap(codes_tmp);
+    indices.swap(indices_tmp);
+  }
+}
+
+//==============================================================================
+void emitLBVHHierarchy(
+    const std::vector<uint32>& codes,
+    std::vector<std::size_t>& children,
+    std::vector<std::size_t>& parents,
+    unsigned int num_threads)
+{
+  const std::size_t n = codes.size();
+  children.resize(2 * (n - 1));
+  parents.resize(2 * n - 1);
+  parents[0] = -1;
+
+  const CommonPrefix delta{codes, static_cast<std::int64_t>(n)};
+
+  parallelForChunks(n - 1, lbvhNumThreads(n, num_threads),
+                    [&](std::size_t begin, std::size_t end, unsigned int)
+  {
+    for(std::size_t node = begin; node < end; ++node)
+    {
+      const std::int64_t i = static_cast<std::int64_t>(node);
+
+      // Direction of the range covered by the node
+      const std::int64_t d = (delta(i, i + 1) - delta(i, i - 1) >= 0) ? 1 : -1;
+
+      // Upper bound of the length of the range, then its other end
+      const int delta_min = delta(i, i - d);
+      std::int64_t l_max = 2;
+      while(delta(i, i + l_max * d) > delta_min)
+        l_max *= 2;
+
+      std::int64_t l = 0;
+      for(std::int64_t t = l_max / 2; t >= 1; t /= 2)
+      {
+        if(delta(i, i + (l + t) * d) > delta_min)
+          l += t;
+      }
+      const std::int64_t j = i + l * d;
+
+      // Split position, i.e., the last leaf sharing the prefix of i
+      const int delta_node = delta(i, j);
+      std::int64_t s = 0;
+      std::int64_t t = l;
+      do
+      {
+        t = (t + 1) / 2;
+        if(delta(i, i + (s + t) * d) > delta_node)
+          s += t;
+      } while(t > 1);
+      const std::int64_t gamma = i + s * d + std::min<std::int64_t>(d, 0);
+
+      const std::size_t left = (std::min(i, j) == gamma) ? (n - 1 + gamma) : gamma;
+      const std::size_t right = (std::max(i, j) == gamma + 1) ? (n + gamma) : (gamma + 1);
+
+      children[2 * node] = left;
+      children[2 * node + 1] = right;
+      parents[left] = node;
+      parents[right] = node;
+    }
+  });
+}
+
+} // namespace detail
+/// @endcond
+} // namespace fcl
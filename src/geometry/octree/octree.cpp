@@ -37,10 +37,6 @@
 
 #include "fcl/geometry/octree/octree-inl.h"
 
-#include "fcl/config.h"
-
-#if FCL_HAVE_OCTOMAP
-
 namespace fcl
 {
 
@@ -52,6 +48,4 @@ class OcTree<double>;
 template
 void computeChildBV(const AABB<double>& root_bv, unsigned int i, AABB<double>& child_bv);
 
-} // namespace fcl
-
-#endif
\ No newline at end of file
+} // namespace fcl
\ No newline at end of file
@@ -58,4 +58,15 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+template
+std::size_t collideBatch(
+    const CollisionGeometry<double>* o1,
+    const Eigen::aligned_vector<Transform3<double>>& tf1,
+    const CollisionGeometry<double>* o2,
+    const Eigen::aligned_vector<Transform3<double>>& tf2,
+    const CollisionRequest<double>& request,
+    std::vector<CollisionResult<double>>& results,
+    unsigned int num_threads);
+
 } // namespace fcl
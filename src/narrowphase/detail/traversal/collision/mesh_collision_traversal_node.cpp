@@ -103,5 +103,65 @@ bool initialize(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+template
+class MeshCollisionTraversalNodeAABB<double>;
+
+//==============================================================================
+template
+bool initialize(
+    MeshCollisionTraversalNodeAABB<double>& node,
+    const BVHModel<AABB<double>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<AABB<double>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+template
+class MeshCollisionTraversalNodeKDOP<double, 16>;
+
+//==============================================================================
+template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 16>& node,
+    const BVHModel<KDOP<double, 16>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 16>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+template
+class MeshCollisionTraversalNodeKDOP<double, 18>;
+
+//==============================================================================
+template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 18>& node,
+    const BVHModel<KDOP<double, 18>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 18>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+//==============================================================================
+template
+class MeshCollisionTraversalNodeKDOP<double, 24>;
+
+//==============================================================================
+template
+bool initialize(
+    MeshCollisionTraversalNodeKDOP<double, 24>& node,
+    const BVHModel<KDOP<double, 24>>& model1,
+    const Transform3<double>& tf1,
+    const BVHModel<KDOP<double, 24>>& model2,
+    const Transform3<double>& tf2,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
 } // namespace detail
 } // namespace fcl
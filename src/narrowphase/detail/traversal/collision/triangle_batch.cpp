@@ -0,0 +1,317 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/narrowphase/detail/traversal/collision/triangle_batch-inl.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FCL_TRIANGLE_BATCH_DISPATCH 1
+#define FCL_TRIANGLE_BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define FCL_TRIANGLE_BATCH_DISPATCH 0
+#define FCL_TRIANGLE_BATCH_INLINE inline
+#endif
+
+// The AVX-512 target of clang also enables FMA; keep the products and sums
+// separately rounded like in Intersect::intersect_Triangle().
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template
+class TriangleBatch<double>;
+
+namespace
+{
+
+//==============================================================================
+template <typename S>
+struct Vec3
+{
+  S x, y, z;
+};
+
+//==============================================================================
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE Vec3<S> sub(const Vec3<S>& a, const Vec3<S>& b)
+{
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+//==============================================================================
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE Vec3<S> cross(const Vec3<S>& a, const Vec3<S>& b)
+{
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+//==============================================================================
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE S dot(const Vec3<S>& a, const Vec3<S>& b)
+{
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//==============================================================================
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE S min3(S a, S b, S c)
+{
+  S m = (b < a) ? b : a;
+  return (c < m) ? c : m;
+}
+
+//==============================================================================
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE S max3(S a, S b, S c)
+{
+  S m = (a < b) ? b : a;
+  return (m < c) ? c : m;
+}
+
+//==============================================================================
+/// @brief Branch free version of Intersect::project6(), returns true if the
+/// projections of the triangles on ax do not overlap
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE bool separated(
+    const Vec3<S>& ax,
+    const Vec3<S>& p1, const Vec3<S>& p2, const Vec3<S>& p3,
+    const Vec3<S>& q1, const Vec3<S>& q2, const Vec3<S>& q3)
+{
+  const S P1 = dot(ax, p1);
+  const S P2 = dot(ax, p2);
+  const S P3 = dot(ax, p3);
+  const S Q1 = dot(ax, q1);
+  const S Q2 = dot(ax, q2);
+  const S Q3 = dot(ax, q3);
+
+  return (min3(P1, P2, P3) > max3(Q1, Q2, Q3))
+      | (min3(Q1, Q2, Q3) > max3(P1, P2, P3));
+}
+
+//==============================================================================
+/// @brief The 17 axes separating axis test of Intersect::intersect_Triangle()
+/// evaluated on all the lanes of the batch. The loop body has no branch so
+/// that the compiler turns it into vector instructions of the target the
+/// caller is compiled for.
+template <typename S>
+FCL_TRIANGLE_BATCH_INLINE void intersectTriangleLanes(
+    const TriangleBatch<S>& batch, bool* hits)
+{
+  constexpr int N = TriangleBatch<S>::kCapacity;
+
+  // Lane results are kept in S wide words so that the whole loop runs on
+  // vectors of the same width
+  S overlap[N];
+
+  for(int i = 0; i < N; ++i)
+  {
+    const Vec3<S> P1 = {batch.p[0][0][i], batch.p[0][1][i], batch.p[0][2][i]};
+    const Vec3<S> P2 = {batch.p[1][0][i], batch.p[1][1][i], batch.p[1][2][i]};
+    const Vec3<S> P3 = {batch.p[2][0][i], batch.p[2][1][i], batch.p[2][2][i]};
+    const Vec3<S> Q1 = {batch.q[0][0][i], batch.q[0][1][i], batch.q[0][2][i]};
+    const Vec3<S> Q2 = {batch.q[1][0][i], batch.q[1][1][i], batch.q[1][2][i]};
+    const Vec3<S> Q3 = {batch.q[2][0][i], batch.q[2][1][i], batch.q[2][2][i]};
+
+    const Vec3<S> p1 = sub(P1, P1);
+    const Vec3<S> p2 = sub(P2, P1);
+    const Vec3<S> p3 = sub(P3, P1);
+    const Vec3<S> q1 = sub(Q1, P1);
+    const Vec3<S> q2 = sub(Q2, P1);
+    const Vec3<S> q3 = sub(Q3, P1);
+
+    const Vec3<S> e1 = sub(p2, p1);
+    const Vec3<S> e2 = sub(p3, p2);
+    const Vec3<S> e3 = sub(p1, p3);
+    const Vec3<S> f1 = sub(q2, q1);
+    const Vec3<S> f2 = sub(q3, q2);
+    const Vec3<S> f3 = sub(q1, q3);
+
+    const Vec3<S> n1 = cross(e1, e2);
+    const Vec3<S> m1 = cross(f1, f2);
+
+    bool sep = separated(n1, p1, p2, p3, q1, q2, q3);
+    sep |= separated(m1, p1, p2, p3, q1, q2, q3);
+
+    sep |= separated(cross(e1, f1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e1, f2), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e1, f3), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e2, f1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e2, f2), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e2, f3), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e3, f1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e3, f2), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e3, f3), p1, p2, p3, q1, q2, q3);
+
+    sep |= separated(cross(e1, n1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e2, n1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(e3, n1), p1, p2, p3, q1, q2, q3);
+
+    sep |= separated(cross(f1, m1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(f2, m1), p1, p2, p3, q1, q2, q3);
+    sep |= separated(cross(f3, m1), p1, p2, p3, q1, q2, q3);
+
+    overlap[i] = sep ? S(0) : S(1);
+  }
+
+  for(int i = 0; i < N; ++i)
+    hits[i] = (overlap[i] != S(0));
+}
+
+//==============================================================================
+template <typename S>
+using TriangleBatchKernel = void (*)(const TriangleBatch<S>&, bool*);
+
+//==============================================================================
+template <typename S>
+void intersectTriangleBatchDefault(const TriangleBatch<S>& batch, bool* hits)
+{
+  intersectTriangleLanes(batch, hits);
+}
+
+#if FCL_TRIANGLE_BATCH_DISPATCH
+
+//==============================================================================
+__attribute__((target("avx2")))
+void intersectTriangleBatchAVX2(const TriangleBatch<float>& batch, bool* hits)
+{
+  intersectTriangleLanes(batch, hits);
+}
+
+//==============================================================================
+__attribute__((target("avx2")))
+void intersectTriangleBatchAVX2(const TriangleBatch<double>& batch, bool* hits)
+{
+  intersectTriangleLanes(batch, hits);
+}
+
+//==============================================================================
+__attribute__((target("avx512f")))
+void intersectTriangleBatchAVX512(const TriangleBatch<float>& batch, bool* hits)
+{
+  intersectTriangleLanes(batch, hits);
+}
+
+//==============================================================================
+__attribute__((target("avx512f")))
+void intersectTriangleBatchAVX512(const TriangleBatch<double>& batch, bool* hits)
+{
+  intersectTriangleLanes(batch, hits);
+}
+
+#endif
+
+//==============================================================================
+enum TriangleBatchKernelLevel
+{
+  KERNEL_DEFAULT,
+  KERNEL_AVX2,
+  KERNEL_AVX512
+};
+
+//==============================================================================
+TriangleBatchKernelLevel detectKernelLevel()
+{
+#if FCL_TRIANGLE_BATCH_DISPATCH
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f"))
+    return KERNEL_AVX512;
+  if(__builtin_cpu_supports("avx2"))
+    return KERNEL_AVX2;
+#endif
+  return KERNEL_DEFAULT;
+}
+
+//==============================================================================
+TriangleBatchKernelLevel kernelLevel()
+{
+  static const TriangleBatchKernelLevel level = detectKernelLevel();
+  return level;
+}
+
+//==============================================================================
+template <typename S>
+TriangleBatchKernel<S> selectKernel()
+{
+#if FCL_TRIANGLE_BATCH_DISPATCH
+  switch(kernelLevel())
+  {
+  case KERNEL_AVX512:
+    return &intersectTriangleBatchAVX512;
+  case KERNEL_AVX2:
+    return &intersectTriangleBatchAVX2;
+  default:
+    break;
+  }
+#endif
+  return &intersectTriangleBatchDefault<S>;
+}
+
+} // namespace
+
+//==============================================================================
+void intersectTriangleBatch(const TriangleBatch<float>& batch, bool* hits)
+{
+  static const TriangleBatchKernel<float> kernel = selectKernel<float>();
+  kernel(batch, hits);
+}
+
+//==============================================================================
+void intersectTriangleBatch(const TriangleBatch<double>& batch, bool* hits)
+{
+  static const TriangleBatchKernel<double> kernel = selectKernel<double>();
+  kernel(batch, hits);
+}
+
+//==============================================================================
+const char* triangleBatchKernelName()
+{
+  switch(kernelLevel())
+  {
+  case KERNEL_AVX512:
+    return "avx512";
+  case KERNEL_AVX2:
+    return "avx2";
+  default:
+    return "default";
+  }
+}
+
+} // namespace detail
+} // namespace fcl
@@ -88,5 +88,20 @@ bool initialize(
     const DistanceRequest<double>& request,
     DistanceResult<double>& result);
 
+//==============================================================================
+template
+double triSignedDistance(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    Vector3<double>& P, Vector3<double>& Q);
+
+//==============================================================================
+template
+double triSignedDistance(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    const Transform3<double>& tf,
+    Vector3<double>& P, Vector3<double>& Q);
+
 } // namespace detail
 } // namespace fcl
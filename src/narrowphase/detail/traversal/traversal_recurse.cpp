@@ -71,5 +71,9 @@ void distanceQueueRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b
 template
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
 
+//==============================================================================
+template
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase<double>* node, BVHFrontList* front_list);
+
 } // namespace detail
 } // namespace fcl
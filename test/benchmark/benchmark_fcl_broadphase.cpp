@@ -0,0 +1,289 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_spatialhash.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/detail/sparse_hash_table.h"
+#include "fcl/broadphase/detail/spatial_hash.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+namespace {
+
+enum ManagerType
+{
+  MANAGER_NAIVE,
+  MANAGER_SSAP,
+  MANAGER_SAP,
+  MANAGER_INTERVAL_TREE,
+  MANAGER_SPATIAL_HASH,
+  MANAGER_SPATIAL_HASH_SPARSE,
+  MANAGER_DYNAMIC_AABB_TREE,
+  MANAGER_DYNAMIC_AABB_TREE_ARRAY,
+  NUM_MANAGER_TYPES
+};
+
+const char* managerName(int type)
+{
+  static const char* names[NUM_MANAGER_TYPES] =
+  {"naive", "ssap", "sap", "interval_tree", "spatial_hash", "spatial_hash_sparse",
+   "dynamic_aabb_tree", "dynamic_aabb_tree_array"};
+  return names[type];
+}
+
+//==============================================================================
+template <typename S>
+std::unique_ptr<BroadPhaseCollisionManager<S>> createManager(
+    int type, std::vector<CollisionObject<S>*>& env)
+{
+  switch(type)
+  {
+  case MANAGER_NAIVE:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new NaiveCollisionManager<S>());
+  case MANAGER_SSAP:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new SSaPCollisionManager<S>());
+  case MANAGER_SAP:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new SaPCollisionManager<S>());
+  case MANAGER_INTERVAL_TREE:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new IntervalTreeCollisionManager<S>());
+  case MANAGER_SPATIAL_HASH:
+  case MANAGER_SPATIAL_HASH_SPARSE:
+  {
+    Vector3<S> lower_limit, upper_limit;
+    SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
+    S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / 20, (upper_limit[1] - lower_limit[1]) / 20), (upper_limit[2] - lower_limit[2])/20);
+    if(type == MANAGER_SPATIAL_HASH)
+      return std::unique_ptr<BroadPhaseCollisionManager<S>>(
+            new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(
+          new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >(cell_size, lower_limit, upper_limit));
+  }
+  case MANAGER_DYNAMIC_AABB_TREE:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new DynamicAABBTreeCollisionManager<S>());
+  case MANAGER_DYNAMIC_AABB_TREE_ARRAY:
+    return std::unique_ptr<BroadPhaseCollisionManager<S>>(new DynamicAABBTreeCollisionManager_Array<S>());
+  default:
+    return nullptr;
+  }
+}
+
+//==============================================================================
+/// @brief Owns the objects produced by test::generateEnvironments(). The
+/// random seed is fixed so that every manager sees the same scene.
+template <typename S>
+struct Environment
+{
+  Environment(S env_scale, std::size_t env_size, unsigned int seed = 1)
+  {
+    std::srand(seed);
+    test::generateEnvironments(objects, env_scale, env_size);
+  }
+
+  ~Environment()
+  {
+    for(auto obj : objects)
+      delete obj;
+  }
+
+  std::vector<CollisionObject<S>*> objects;
+};
+
+constexpr double kEnvScale = 100;
+
+//==============================================================================
+/// @brief registerObjects() + setup(); args are {manager, env_size}
+void BM_BroadPhaseSetup(benchmark::State& state)
+{
+  const int type = state.range(0);
+  Environment<double> env(kEnvScale, state.range(1));
+
+  for(auto _ : state)
+  {
+    auto manager = createManager<double>(type, env.objects);
+    manager->registerObjects(env.objects);
+    manager->setup();
+    benchmark::DoNotOptimize(manager);
+  }
+
+  state.SetLabel(managerName(type));
+  state.counters["objects"] = env.objects.size();
+}
+
+//==============================================================================
+/// @brief Exhaustive self collision; args are {manager, env_size}
+void BM_BroadPhaseSelfCollide(benchmark::State& state)
+{
+  const int type = state.range(0);
+  Environment<double> env(kEnvScale, state.range(1));
+
+  auto manager = createManager<double>(type, env.objects);
+  manager->registerObjects(env.objects);
+  manager->setup();
+
+  std::size_t num_contacts = 0;
+  for(auto _ : state)
+  {
+    test::CollisionData<double> cdata;
+    cdata.request.num_max_contacts = 100000;
+    manager->collide(&cdata, test::defaultCollisionFunction);
+    num_contacts = cdata.result.numContacts();
+  }
+
+  state.SetLabel(managerName(type));
+  state.counters["objects"] = env.objects.size();
+  state.counters["contacts"] = num_contacts;
+}
+
+//==============================================================================
+/// @brief Collision of 30 query objects against the manager; args are
+/// {manager, env_size}
+void BM_BroadPhaseQueryCollide(benchmark::State& state)
+{
+  const int type = state.range(0);
+  Environment<double> env(kEnvScale, state.range(1));
+  Environment<double> query(kEnvScale, 10, 2);
+
+  auto manager = createManager<double>(type, env.objects);
+  manager->registerObjects(env.objects);
+  manager->setup();
+
+  for(auto _ : state)
+  {
+    for(auto obj : query.objects)
+    {
+      test::CollisionData<double> cdata;
+      manager->collide(obj, &cdata, test::defaultCollisionFunction);
+      benchmark::DoNotOptimize(cdata.result);
+    }
+  }
+
+  state.SetLabel(managerName(type));
+  state.counters["objects"] = env.objects.size();
+}
+
+//==============================================================================
+/// @brief Self distance; args are {manager, env_size}
+void BM_BroadPhaseSelfDistance(benchmark::State& state)
+{
+  const int type = state.range(0);
+  Environment<double> env(kEnvScale, state.range(1));
+
+  auto manager = createManager<double>(type, env.objects);
+  manager->registerObjects(env.objects);
+  manager->setup();
+
+  for(auto _ : state)
+  {
+    test::DistanceData<double> cdata;
+    manager->distance(&cdata, test::defaultDistanceFunction);
+    benchmark::DoNotOptimize(cdata.result.min_distance);
+  }
+
+  state.SetLabel(managerName(type));
+  state.counters["objects"] = env.objects.size();
+}
+
+//==============================================================================
+/// @brief Moves every object slightly, then update() + exhaustive self
+/// collision; args are {manager, env_size}
+void BM_BroadPhaseUpdateCollide(benchmark::State& state)
+{
+  const int type = state.range(0);
+  Environment<double> env(kEnvScale, state.range(1));
+
+  auto manager = createManager<double>(type, env.objects);
+  manager->registerObjects(env.objects);
+  manager->setup();
+
+  double delta = 0.5;
+  for(auto _ : state)
+  {
+    for(auto obj : env.objects)
+    {
+      obj->setTranslation(obj->getTranslation() + Vector3<double>::Constant(delta));
+      obj->computeAABB();
+    }
+    delta = -delta;
+
+    manager->update();
+
+    test::CollisionData<double> cdata;
+    cdata.request.num_max_contacts = 100000;
+    manager->collide(&cdata, test::defaultCollisionFunction);
+    benchmark::DoNotOptimize(cdata.result);
+  }
+
+  state.SetLabel(managerName(type));
+  state.counters["objects"] = env.objects.size();
+}
+
+//==============================================================================
+/// @brief Registers {manager, env_size} for every manager and scene size. The
+/// naive manager is quadratic and skips the largest scenes.
+void managerArguments(benchmark::internal::Benchmark* b, std::int64_t max_env_size)
+{
+  b->ArgNames({"manager", "env_size"});
+  for(int type = 0; type < NUM_MANAGER_TYPES; ++type)
+  {
+    for(std::int64_t env_size = 10; env_size <= max_env_size; env_size *= 10)
+    {
+      if(type == MANAGER_NAIVE && env_size > 1000)
+        continue;
+      b->Args({type, env_size});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void allSizes(benchmark::internal::Benchmark* b) { managerArguments(b, 10000); }
+
+void smallSizes(benchmark::internal::Benchmark* b) { managerArguments(b, 1000); }
+
+} // namespace
+
+BENCHMARK(BM_BroadPhaseSetup)->Apply(allSizes);
+BENCHMARK(BM_BroadPhaseSelfCollide)->Apply(allSizes);
+BENCHMARK(BM_BroadPhaseQueryCollide)->Apply(allSizes);
+BENCHMARK(BM_BroadPhaseUpdateCollide)->Apply(allSizes);
+BENCHMARK(BM_BroadPhaseSelfDistance)->Apply(smallSizes);
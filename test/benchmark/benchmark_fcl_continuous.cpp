@@ -0,0 +1,213 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "fcl/narrowphase/continuous_collision.h"
+#include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+namespace {
+
+constexpr std::size_t kNumTransforms = 100;
+
+//==============================================================================
+/// @brief Start and goal configurations of the moving object
+template <typename S>
+struct Motions
+{
+  explicit Motions(S extent, S delta)
+  {
+    S extents[] = {-extent, -extent, -extent, extent, extent, extent};
+    S delta_trans[] = {delta, delta, delta};
+    test::generateRandomTransforms(extents, delta_trans, 0.005 * 2 * 3.1415, tf_beg, tf_end, kNumTransforms);
+  }
+
+  Eigen::aligned_vector<Transform3<S>> tf_beg;
+  Eigen::aligned_vector<Transform3<S>> tf_end;
+};
+
+const char* motionName(int type)
+{
+  static const char* names[] = {"trans", "linear", "screw", "spline"};
+  return names[type];
+}
+
+const char* solverName(int type)
+{
+  static const char* names[] = {"naive", "conservative_advancement", "ray_shooting", "polynomial"};
+  return names[type];
+}
+
+//==============================================================================
+/// @brief Continuous collision of a box moving past a sphere; args are
+/// {CCDSolverType, CCDMotionType}
+void BM_ContinuousShapeShape(benchmark::State& state)
+{
+  using S = double;
+
+  Box<S> box(10, 20, 30);
+  Sphere<S> sphere(15);
+  static const Motions<S> motions(40, 40);
+
+  ContinuousCollisionRequest<S> request;
+  request.ccd_solver_type = static_cast<CCDSolverType>(state.range(0));
+  request.ccd_motion_type = static_cast<CCDMotionType>(state.range(1));
+  request.gjk_solver_type = GST_INDEP;
+
+  std::size_t i = 0;
+  std::size_t num_collisions = 0;
+  for(auto _ : state)
+  {
+    ContinuousCollisionResult<S> result;
+    continuousCollide(&box, motions.tf_beg[i], motions.tf_end[i],
+                      &sphere, Transform3<S>::Identity(), Transform3<S>::Identity(),
+                      request, result);
+    num_collisions += result.is_collide;
+    if(++i == kNumTransforms) i = 0;
+  }
+
+  state.SetLabel(std::string(solverName(state.range(0))) + "/" + motionName(state.range(1)));
+  state.counters["hit_rate"] = benchmark::Counter(
+      static_cast<double>(num_collisions), benchmark::Counter::kAvgIterations);
+}
+
+//==============================================================================
+/// @brief Continuous collision of rob.obj moving through env.obj; args are
+/// {CCDSolverType, CCDMotionType}
+template <typename BV>
+void BM_ContinuousMeshMesh(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> env;
+  env.beginModel();
+  env.addSubModel(p1, t1);
+  env.endModel();
+
+  BVHModel<BV> rob;
+  rob.beginModel();
+  rob.addSubModel(p2, t2);
+  rob.endModel();
+
+  static const Motions<S> motions(1000, 100);
+
+  ContinuousCollisionRequest<S> request;
+  request.ccd_solver_type = static_cast<CCDSolverType>(state.range(0));
+  request.ccd_motion_type = static_cast<CCDMotionType>(state.range(1));
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    ContinuousCollisionResult<S> result;
+    benchmark::DoNotOptimize(
+          continuousCollide(&rob, motions.tf_beg[i], motions.tf_end[i],
+                            &env, Transform3<S>::Identity(), Transform3<S>::Identity(),
+                            request, result));
+    if(++i == kNumTransforms) i = 0;
+  }
+
+  state.SetLabel(std::string(solverName(state.range(0))) + "/" + motionName(state.range(1)));
+}
+
+//==============================================================================
+/// @brief CCDC_NAIVE with 1000 samples on the motions of
+/// BM_ContinuousShapeShape; args are {adaptive stepping, CCDMotionType}. The
+/// "queries" counter is the number of discrete queries per call.
+void BM_ContinuousNaiveStepping(benchmark::State& state)
+{
+  using S = double;
+
+  Box<S> box(10, 20, 30);
+  Sphere<S> sphere(15);
+  box.computeLocalAABB();
+  sphere.computeLocalAABB();
+  static const Motions<S> motions(40, 40);
+
+  ContinuousCollisionRequest<S> request(
+        1000, 0.001, static_cast<CCDMotionType>(state.range(1)), GST_INDEP,
+        CCDC_NAIVE, state.range(0) != 0);
+
+  std::size_t i = 0;
+  std::size_t num_queries = 0;
+  for(auto _ : state)
+  {
+    ContinuousCollisionResult<S> result;
+    continuousCollide(&box, motions.tf_beg[i], motions.tf_end[i],
+                      &sphere, Transform3<S>::Identity(), Transform3<S>::Identity(),
+                      request, result);
+    num_queries += result.num_queries;
+    if(++i == kNumTransforms) i = 0;
+  }
+
+  state.SetLabel(motionName(state.range(1)));
+  state.counters["queries"] = benchmark::Counter(
+      static_cast<double>(num_queries), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+BENCHMARK(BM_ContinuousShapeShape)
+    ->ArgNames({"solver", "motion"})
+    ->ArgsProduct({{CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT},
+                   {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW}});
+
+BENCHMARK_TEMPLATE(BM_ContinuousMeshMesh, RSSd)
+    ->ArgNames({"solver", "motion"})
+    ->ArgsProduct({{CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT},
+                   {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_ContinuousMeshMesh, OBBRSSd)
+    ->ArgNames({"solver", "motion"})
+    ->ArgsProduct({{CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT},
+                   {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_ContinuousMeshMesh, AABBd)
+    ->ArgNames({"solver", "motion"})
+    ->Args({CCDC_NAIVE, CCDM_TRANS})
+    ->Args({CCDC_POLYNOMIAL_SOLVER, CCDM_TRANS})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ContinuousNaiveStepping)
+    ->ArgNames({"adaptive", "motion"})
+    ->ArgsProduct({{0, 1}, {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW}});
@@ -0,0 +1,347 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/detail/traversal/collision_node.h"
+#include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+namespace {
+
+constexpr std::size_t kNumTransforms = 100;
+
+//==============================================================================
+template <typename BV>
+std::shared_ptr<BVHModel<BV>> loadMesh(const char* filename, detail::SplitMethodType split_method,
+                                       unsigned int num_build_threads = 1)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> triangles;
+  test::loadOBJFile(filename, points, triangles);
+
+  auto model = std::make_shared<BVHModel<BV>>();
+  model->bv_splitter.reset(new detail::BVSplitter<BV>(split_method));
+  model->num_build_threads = num_build_threads;
+  model->beginModel();
+  model->addSubModel(points, triangles);
+  model->endModel();
+
+  return model;
+}
+
+//==============================================================================
+template <typename S>
+const Eigen::aligned_vector<Transform3<S>>& meshTransforms()
+{
+  static const Eigen::aligned_vector<Transform3<S>> transforms = []()
+  {
+    S extents[] = {-1000, -1000, -1000, 1000, 1000, 1000};
+    Eigen::aligned_vector<Transform3<S>> result;
+    test::generateRandomTransforms(extents, result, kNumTransforms);
+    return result;
+  }();
+  return transforms;
+}
+
+//==============================================================================
+/// @brief Mesh-mesh collision between env.obj and rob.obj. state.range(0) is
+/// the maximum number of contacts (1 stops at the first contact).
+template <typename BV>
+void BM_MeshMeshCollide(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  auto env = loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", detail::SPLIT_METHOD_MEAN);
+  auto rob = loadMesh<BV>(TEST_RESOURCES_DIR"/rob.obj", detail::SPLIT_METHOD_MEAN);
+  const auto& transforms = meshTransforms<S>();
+
+  CollisionRequest<S> request;
+  request.num_max_contacts = state.range(0);
+
+  std::size_t i = 0;
+  std::size_t num_contacts = 0;
+  for(auto _ : state)
+  {
+    CollisionResult<S> result;
+    collide(env.get(), transforms[i],
+            rob.get(), Transform3<S>::Identity(), request, result);
+    num_contacts += result.numContacts();
+    if(++i == transforms.size()) i = 0;
+  }
+
+  state.counters["contacts"] = benchmark::Counter(
+      static_cast<double>(num_contacts), benchmark::Counter::kAvgIterations);
+}
+
+//==============================================================================
+/// @brief Mesh-mesh distance between env.obj and rob.obj
+template <typename BV>
+void BM_MeshMeshDistance(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  auto env = loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", detail::SPLIT_METHOD_MEAN);
+  auto rob = loadMesh<BV>(TEST_RESOURCES_DIR"/rob.obj", detail::SPLIT_METHOD_MEAN);
+  const auto& transforms = meshTransforms<S>();
+
+  DistanceRequest<S> request;
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    DistanceResult<S> result;
+    benchmark::DoNotOptimize(
+          distance(env.get(), transforms[i],
+                   rob.get(), Transform3<S>::Identity(), request, result));
+    if(++i == transforms.size()) i = 0;
+  }
+}
+
+//==============================================================================
+/// @brief Seconds per single-threaded mesh-mesh distance query between env.obj
+/// and rob.obj over meshTransforms(), measured once per BV type
+template <typename BV>
+double sequentialDistanceTime(const BVHModel<BV>& env, const BVHModel<BV>& rob)
+{
+  using S = typename BV::S;
+
+  static const double time = [&]()
+  {
+    const auto& transforms = meshTransforms<S>();
+    DistanceRequest<S> request;
+
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto& tf : transforms)
+    {
+      DistanceResult<S> result;
+      benchmark::DoNotOptimize(
+            distance(&env, tf, &rob, Transform3<S>::Identity(), request, result));
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / transforms.size();
+  }();
+  return time;
+}
+
+//==============================================================================
+/// @brief Mesh-mesh distance between env.obj and rob.obj on state.range(0)
+/// threads. The speedup counter is relative to a single-threaded query.
+template <typename BV>
+void BM_MeshMeshDistanceParallel(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  auto env = loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", detail::SPLIT_METHOD_MEAN);
+  auto rob = loadMesh<BV>(TEST_RESOURCES_DIR"/rob.obj", detail::SPLIT_METHOD_MEAN);
+  const auto& transforms = meshTransforms<S>();
+  const double sequential_time = sequentialDistanceTime<BV>(*env, *rob);
+
+  DistanceRequest<S> request;
+  request.num_threads = state.range(0);
+
+  std::size_t i = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for(auto _ : state)
+  {
+    DistanceResult<S> result;
+    benchmark::DoNotOptimize(
+          distance(env.get(), transforms[i],
+                   rob.get(), Transform3<S>::Identity(), request, result));
+    if(++i == transforms.size()) i = 0;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  state.counters["speedup"] =
+      sequential_time * state.iterations() / elapsed.count();
+}
+
+//==============================================================================
+/// @brief Traversal of an oriented mesh-mesh collision node between env.obj
+/// and rob.obj. state.range(0) is the maximum number of contacts, and
+/// state.range(1) selects the recursive detail::collide() (0) or the
+/// statically bound detail::collideNode() (1).
+template <typename NodeType, typename BV>
+void BM_MeshMeshCollideTraversal(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  auto env = loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", detail::SPLIT_METHOD_MEAN);
+  auto rob = loadMesh<BV>(TEST_RESOURCES_DIR"/rob.obj", detail::SPLIT_METHOD_MEAN);
+  const auto& transforms = meshTransforms<S>();
+  const bool use_static = state.range(1) != 0;
+
+  CollisionRequest<S> request;
+  request.num_max_contacts = state.range(0);
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    CollisionResult<S> result;
+    NodeType node;
+    detail::initialize(node, *env, transforms[i],
+                       *rob, Transform3<S>::Identity(), request, result);
+    if(use_static)
+      detail::collideNode(&node);
+    else
+      detail::collide(&node);
+    benchmark::DoNotOptimize(result.numContacts());
+    if(++i == transforms.size()) i = 0;
+  }
+}
+
+//==============================================================================
+/// @brief Traversal of an oriented mesh-mesh distance node between env.obj and
+/// rob.obj. state.range(0) selects the recursive detail::distance() (0) or the
+/// statically bound detail::distanceNode() (1).
+template <typename NodeType, typename BV>
+void BM_MeshMeshDistanceTraversal(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  auto env = loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", detail::SPLIT_METHOD_MEAN);
+  auto rob = loadMesh<BV>(TEST_RESOURCES_DIR"/rob.obj", detail::SPLIT_METHOD_MEAN);
+  const auto& transforms = meshTransforms<S>();
+  const bool use_static = state.range(0) != 0;
+
+  DistanceRequest<S> request;
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    DistanceResult<S> result;
+    NodeType node;
+    detail::initialize(node, *env, transforms[i],
+                       *rob, Transform3<S>::Identity(), request, result);
+    if(use_static)
+      detail::distanceNode(&node);
+    else
+      detail::distance(&node);
+    benchmark::DoNotOptimize(result.min_distance);
+    if(++i == transforms.size()) i = 0;
+  }
+}
+
+//==============================================================================
+/// @brief BVH construction of env.obj; state.range(0) is the detail::SplitMethodType
+/// and state.range(1) the number of build threads
+template <typename BV>
+void BM_MeshBuild(benchmark::State& state)
+{
+  const auto split_method = static_cast<detail::SplitMethodType>(state.range(0));
+  const auto num_build_threads = static_cast<unsigned int>(state.range(1));
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+          loadMesh<BV>(TEST_RESOURCES_DIR"/env.obj", split_method, num_build_threads));
+  }
+}
+
+} // namespace
+
+#define FCL_MESH_COLLIDE_BENCHMARK(BV)                                        \
+  BENCHMARK_TEMPLATE(BM_MeshMeshCollide, BV)                                  \
+      ->ArgName("max_contacts")->Arg(1)->Arg(100000)                          \
+      ->Unit(benchmark::kMicrosecond)
+
+#define FCL_MESH_DISTANCE_BENCHMARK(BV)                                       \
+  BENCHMARK_TEMPLATE(BM_MeshMeshDistance, BV)->Unit(benchmark::kMicrosecond)
+
+#define FCL_MESH_DISTANCE_PARALLEL_BENCHMARK(BV)                              \
+  BENCHMARK_TEMPLATE(BM_MeshMeshDistanceParallel, BV)                         \
+      ->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)                    \
+      ->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+#define FCL_MESH_COLLIDE_TRAVERSAL_BENCHMARK(Node, BV)                        \
+  BENCHMARK_TEMPLATE(BM_MeshMeshCollideTraversal, Node, BV)                   \
+      ->ArgNames({"max_contacts", "static"})                                  \
+      ->Args({1, 0})->Args({1, 1})->Args({100000, 0})->Args({100000, 1})      \
+      ->Unit(benchmark::kMicrosecond)
+
+#define FCL_MESH_DISTANCE_TRAVERSAL_BENCHMARK(Node, BV)                       \
+  BENCHMARK_TEMPLATE(BM_MeshMeshDistanceTraversal, Node, BV)                  \
+      ->ArgName("static")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)
+
+#define FCL_MESH_BUILD_BENCHMARK(BV)                                          \
+  BENCHMARK_TEMPLATE(BM_MeshBuild, BV)                                        \
+      ->ArgNames({"split", "threads"})                                        \
+      ->ArgsProduct({{detail::SPLIT_METHOD_MEAN,                              \
+                      detail::SPLIT_METHOD_MEDIAN,                            \
+                      detail::SPLIT_METHOD_BV_CENTER,                         \
+                      detail::SPLIT_METHOD_SAH},                              \
+                     {1, 4}})                                                 \
+      ->UseRealTime()->Unit(benchmark::kMillisecond)
+
+FCL_MESH_COLLIDE_BENCHMARK(AABBd);
+FCL_MESH_COLLIDE_BENCHMARK(OBBd);
+FCL_MESH_COLLIDE_BENCHMARK(RSSd);
+FCL_MESH_COLLIDE_BENCHMARK(kIOSd);
+FCL_MESH_COLLIDE_BENCHMARK(OBBRSSd);
+FCL_MESH_COLLIDE_BENCHMARK(KDOPd<16>);
+FCL_MESH_COLLIDE_BENCHMARK(KDOPd<18>);
+FCL_MESH_COLLIDE_BENCHMARK(KDOPd<24>);
+
+// Mesh distance is only supported for these BV types
+FCL_MESH_DISTANCE_BENCHMARK(RSSd);
+FCL_MESH_DISTANCE_BENCHMARK(kIOSd);
+FCL_MESH_DISTANCE_BENCHMARK(OBBRSSd);
+
+FCL_MESH_DISTANCE_PARALLEL_BENCHMARK(RSSd);
+FCL_MESH_DISTANCE_PARALLEL_BENCHMARK(kIOSd);
+FCL_MESH_DISTANCE_PARALLEL_BENCHMARK(OBBRSSd);
+
+FCL_MESH_COLLIDE_TRAVERSAL_BENCHMARK(detail::MeshCollisionTraversalNodeOBB<double>, OBBd);
+FCL_MESH_COLLIDE_TRAVERSAL_BENCHMARK(detail::MeshCollisionTraversalNodeRSS<double>, RSSd);
+FCL_MESH_COLLIDE_TRAVERSAL_BENCHMARK(detail::MeshCollisionTraversalNodekIOS<double>, kIOSd);
+FCL_MESH_COLLIDE_TRAVERSAL_BENCHMARK(detail::MeshCollisionTraversalNodeOBBRSS<double>, OBBRSSd);
+
+FCL_MESH_DISTANCE_TRAVERSAL_BENCHMARK(detail::MeshDistanceTraversalNodeRSS<double>, RSSd);
+FCL_MESH_DISTANCE_TRAVERSAL_BENCHMARK(detail::MeshDistanceTraversalNodekIOS<double>, kIOSd);
+FCL_MESH_DISTANCE_TRAVERSAL_BENCHMARK(detail::MeshDistanceTraversalNodeOBBRSS<double>, OBBRSSd);
+
+FCL_MESH_BUILD_BENCHMARK(AABBd);
+FCL_MESH_BUILD_BENCHMARK(OBBd);
+FCL_MESH_BUILD_BENCHMARK(RSSd);
+FCL_MESH_BUILD_BENCHMARK(OBBRSSd);
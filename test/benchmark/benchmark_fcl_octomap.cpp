@@ -0,0 +1,191 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "fcl/geometry/octree/octree.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+namespace {
+
+constexpr std::size_t kNumTransforms = 100;
+
+//==============================================================================
+template <typename S>
+const Eigen::aligned_vector<Transform3<S>>& octreeTransforms()
+{
+  static const Eigen::aligned_vector<Transform3<S>> transforms = []()
+  {
+    S extents[] = {-10, -10, 10, 10, 10, 10};
+    Eigen::aligned_vector<Transform3<S>> result;
+    test::generateRandomTransforms(extents, result, kNumTransforms);
+    return result;
+  }();
+  return transforms;
+}
+
+//==============================================================================
+/// @brief Native octree with the occupancy of test::generateOcTree(): a cube
+/// of occupied points with spacing 0.05 whose corner below -0.4 on every axis
+/// is free
+template <typename S>
+std::shared_ptr<OcTree<S>> createOcTree(S resolution)
+{
+  std::vector<Vector3<S>> points;
+  for(int x = -20; x < 20; x++)
+  {
+    for(int y = -20; y < 20; y++)
+    {
+      for(int z = -20; z < 20; z++)
+      {
+        const Vector3<S> p(x * 0.05, y * 0.05, z * 0.05);
+        if((p.array() < -0.4).all()) continue;
+        points.push_back(p);
+      }
+    }
+  }
+
+  return std::make_shared<OcTree<S>>(resolution, points);
+}
+
+//==============================================================================
+/// @brief Octree-mesh collision; state.range(0) is the maximum number of
+/// contacts
+template <typename BV>
+void BM_OcTreeMeshCollide(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> triangles;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", points, triangles);
+
+  BVHModel<BV> mesh;
+  mesh.beginModel();
+  mesh.addSubModel(points, triangles);
+  mesh.endModel();
+
+  auto tree = createOcTree<S>(0.1);
+  const auto& transforms = octreeTransforms<S>();
+
+  CollisionRequest<S> request;
+  request.num_max_contacts = state.range(0);
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    CollisionResult<S> result;
+    collide(&mesh, transforms[i], tree.get(), transforms[i], request, result);
+    benchmark::DoNotOptimize(result);
+    if(++i == kNumTransforms) i = 0;
+  }
+}
+
+//==============================================================================
+/// @brief Octree-mesh distance
+template <typename BV>
+void BM_OcTreeMeshDistance(benchmark::State& state)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> triangles;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", points, triangles);
+
+  BVHModel<BV> mesh;
+  mesh.beginModel();
+  mesh.addSubModel(points, triangles);
+  mesh.endModel();
+
+  auto tree = createOcTree<S>(0.1);
+  const auto& transforms = octreeTransforms<S>();
+
+  DistanceRequest<S> request;
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    DistanceResult<S> result;
+    benchmark::DoNotOptimize(
+          distance(&mesh, transforms[i], tree.get(), transforms[i], request, result));
+    if(++i == kNumTransforms) i = 0;
+  }
+}
+
+//==============================================================================
+/// @brief Octree collision against a broadphase scene of 3 * state.range(0)
+/// objects
+void BM_OcTreeBroadPhaseCollide(benchmark::State& state)
+{
+  using S = double;
+
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, S(200), state.range(0));
+
+  CollisionObject<S> tree_obj(createOcTree<S>(0.1));
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  for(auto _ : state)
+  {
+    test::CollisionData<S> cdata;
+    cdata.request.num_max_contacts = 100000;
+    manager.collide(&tree_obj, &cdata, test::defaultCollisionFunction);
+    benchmark::DoNotOptimize(cdata.result);
+  }
+
+  for(auto obj : env)
+    delete obj;
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_OcTreeMeshCollide, OBBRSSd)
+    ->ArgName("max_contacts")->Arg(1)->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_OcTreeMeshDistance, OBBRSSd)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_OcTreeBroadPhaseCollide)
+    ->ArgName("env_size")->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,262 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/detail/convexity_based_algorithm/minkowski_diff.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+namespace {
+
+constexpr std::size_t kNumTransforms = 1000;
+
+//==============================================================================
+template <typename Shape>
+struct ShapeFactory;
+
+template <typename S>
+struct ShapeFactory<Sphere<S>>
+{
+  static Sphere<S>* create() { return new Sphere<S>(20); }
+};
+
+template <typename S>
+struct ShapeFactory<Box<S>>
+{
+  static Box<S>* create() { return new Box<S>(20, 40, 50); }
+};
+
+template <typename S>
+struct ShapeFactory<Capsule<S>>
+{
+  static Capsule<S>* create() { return new Capsule<S>(10, 40); }
+};
+
+template <typename S>
+struct ShapeFactory<Cylinder<S>>
+{
+  static Cylinder<S>* create() { return new Cylinder<S>(10, 40); }
+};
+
+template <typename S>
+struct ShapeFactory<Cone<S>>
+{
+  static Cone<S>* create() { return new Cone<S>(10, 40); }
+};
+
+template <typename S>
+struct ShapeFactory<Ellipsoid<S>>
+{
+  static Ellipsoid<S>* create() { return new Ellipsoid<S>(10, 20, 30); }
+};
+
+template <typename S>
+struct ShapeFactory<Convex<S>>
+{
+  /// @brief A convex box of 20 x 40 x 50; Convex does not own its arrays
+  static Convex<S>* create()
+  {
+    static Vector3<S> points[8];
+    for(int i = 0; i < 8; ++i)
+      points[i] = Vector3<S>((i & 1) ? 10 : -10, (i & 2) ? 20 : -20, (i & 4) ? 25 : -25);
+    static Vector3<S> normals[6] = {-Vector3<S>::UnitX(), Vector3<S>::UnitX(),
+                                    -Vector3<S>::UnitY(), Vector3<S>::UnitY(),
+                                    -Vector3<S>::UnitZ(), Vector3<S>::UnitZ()};
+    static S dis[6] = {10, 10, 20, 20, 25, 25};
+    static int polygons[30] = {4, 0, 4, 6, 2,  4, 1, 3, 7, 5,  4, 0, 1, 5, 4,
+                               4, 2, 6, 7, 3,  4, 0, 2, 3, 1,  4, 4, 5, 7, 6};
+    return new Convex<S>(normals, dis, 6, points, 8, polygons);
+  }
+};
+
+//==============================================================================
+template <typename S>
+const Eigen::aligned_vector<Transform3<S>>& shapeTransforms()
+{
+  static const Eigen::aligned_vector<Transform3<S>> transforms = []()
+  {
+    S extents[] = {-50, -50, -50, 50, 50, 50};
+    Eigen::aligned_vector<Transform3<S>> result;
+    test::generateRandomTransforms(extents, result, kNumTransforms);
+    return result;
+  }();
+  return transforms;
+}
+
+//==============================================================================
+/// @brief Shape-shape collision; state.range(0) selects the GJKSolverType.
+template <typename Shape1, typename Shape2>
+void BM_ShapeShapeCollide(benchmark::State& state)
+{
+  using S = typename Shape1::S;
+
+  std::unique_ptr<Shape1> s1(ShapeFactory<Shape1>::create());
+  std::unique_ptr<Shape2> s2(ShapeFactory<Shape2>::create());
+  const auto& transforms = shapeTransforms<S>();
+
+  CollisionRequest<S> request;
+  request.gjk_solver_type = static_cast<GJKSolverType>(state.range(0));
+  request.enable_contact = state.range(1) != 0;
+
+  std::size_t i = 0;
+  std::size_t num_collisions = 0;
+  for(auto _ : state)
+  {
+    CollisionResult<S> result;
+    collide(s1.get(), Transform3<S>::Identity(),
+            s2.get(), transforms[i], request, result);
+    num_collisions += result.isCollision();
+    benchmark::DoNotOptimize(result);
+    if(++i == transforms.size()) i = 0;
+  }
+
+  state.SetLabel(request.gjk_solver_type == GST_LIBCCD ? "libccd" : "indep");
+  state.counters["hit_rate"] = benchmark::Counter(
+      static_cast<double>(num_collisions), benchmark::Counter::kAvgIterations);
+}
+
+//==============================================================================
+/// @brief Shape-shape distance; state.range(0) selects the GJKSolverType.
+template <typename Shape1, typename Shape2>
+void BM_ShapeShapeDistance(benchmark::State& state)
+{
+  using S = typename Shape1::S;
+
+  std::unique_ptr<Shape1> s1(ShapeFactory<Shape1>::create());
+  std::unique_ptr<Shape2> s2(ShapeFactory<Shape2>::create());
+  const auto& transforms = shapeTransforms<S>();
+
+  DistanceRequest<S> request;
+  request.gjk_solver_type = static_cast<GJKSolverType>(state.range(0));
+  request.enable_nearest_points = true;
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    DistanceResult<S> result;
+    benchmark::DoNotOptimize(
+          distance(s1.get(), Transform3<S>::Identity(),
+                   s2.get(), transforms[i], request, result));
+    if(++i == transforms.size()) i = 0;
+  }
+
+  state.SetLabel(request.gjk_solver_type == GST_LIBCCD ? "libccd" : "indep");
+}
+
+//==============================================================================
+/// @brief Support point of the Minkowski difference of two shapes, as used in
+/// the GJK and EPA inner loops. state.range(0) selects the support functions
+/// dispatching on the node types (0) or compiled for the shape types (1).
+template <typename Shape1, typename Shape2>
+void BM_MinkowskiDiffSupport(benchmark::State& state)
+{
+  using S = typename Shape1::S;
+
+  std::unique_ptr<Shape1> s1(ShapeFactory<Shape1>::create());
+  std::unique_ptr<Shape2> s2(ShapeFactory<Shape2>::create());
+  const auto& transforms = shapeTransforms<S>();
+  const bool use_typed = state.range(0) != 0;
+
+  detail::MinkowskiDiff<S> md;
+  if(use_typed)
+  {
+    md.set(s1.get(), s2.get());
+  }
+  else
+  {
+    md.shapes[0] = s1.get();
+    md.shapes[1] = s2.get();
+  }
+  md.toshape1 = transforms[0].linear().transpose();
+  md.toshape0 = transforms[0];
+
+  std::vector<Vector3<S>> dirs;
+  dirs.reserve(transforms.size());
+  for(const auto& tf : transforms)
+    dirs.push_back(tf.translation().normalized());
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(md.support(dirs[i]));
+    if(++i == dirs.size()) i = 0;
+  }
+
+  state.SetLabel(use_typed ? "typed" : "node type switch");
+}
+
+} // namespace
+
+#define FCL_SHAPE_COLLIDE_BENCHMARK(Shape1, Shape2)                           \
+  BENCHMARK_TEMPLATE(BM_ShapeShapeCollide, Shape1, Shape2)                    \
+      ->ArgNames({"solver", "contact"})                                       \
+      ->ArgsProduct({{GST_LIBCCD, GST_INDEP}, {0, 1}})
+
+#define FCL_SHAPE_DISTANCE_BENCHMARK(Shape1, Shape2)                          \
+  BENCHMARK_TEMPLATE(BM_ShapeShapeDistance, Shape1, Shape2)                   \
+      ->ArgName("solver")->Arg(GST_LIBCCD)->Arg(GST_INDEP)
+
+#define FCL_MINKOWSKI_SUPPORT_BENCHMARK(Shape1, Shape2)                       \
+  BENCHMARK_TEMPLATE(BM_MinkowskiDiffSupport, Shape1, Shape2)                 \
+      ->ArgName("typed")->Arg(0)->Arg(1)
+
+FCL_SHAPE_COLLIDE_BENCHMARK(Sphered, Sphered);
+FCL_SHAPE_COLLIDE_BENCHMARK(Boxd, Boxd);
+FCL_SHAPE_COLLIDE_BENCHMARK(Boxd, Sphered);
+FCL_SHAPE_COLLIDE_BENCHMARK(Capsuled, Capsuled);
+FCL_SHAPE_COLLIDE_BENCHMARK(Cylinderd, Cylinderd);
+FCL_SHAPE_COLLIDE_BENCHMARK(Coned, Cylinderd);
+FCL_SHAPE_COLLIDE_BENCHMARK(Ellipsoidd, Boxd);
+
+FCL_SHAPE_DISTANCE_BENCHMARK(Sphered, Sphered);
+FCL_SHAPE_DISTANCE_BENCHMARK(Boxd, Boxd);
+FCL_SHAPE_DISTANCE_BENCHMARK(Capsuled, Capsuled);
+FCL_SHAPE_DISTANCE_BENCHMARK(Cylinderd, Cylinderd);
+FCL_SHAPE_DISTANCE_BENCHMARK(Coned, Cylinderd);
+FCL_SHAPE_DISTANCE_BENCHMARK(Ellipsoidd, Boxd);
+
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Sphered, Sphered);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Sphered, Boxd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Boxd, Boxd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Capsuled, Boxd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Capsuled, Capsuled);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Cylinderd, Boxd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Cylinderd, Cylinderd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Coned, Ellipsoidd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Convexd, Boxd);
+FCL_MINKOWSKI_SUPPORT_BENCHMARK(Convexd, Convexd);
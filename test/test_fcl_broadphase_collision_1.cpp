@@ -45,6 +45,8 @@
 #include "fcl/broadphase/broadphase_interval_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_pair_cache.h"
+#include "fcl/broadphase/detail/pair_hash_set.h"
 #include "fcl/broadphase/detail/sparse_hash_table.h"
 #include "fcl/broadphase/detail/spatial_hash.h"
 #include "fcl/geometry/geometric_shape_to_BVH_model.h"
@@ -58,6 +60,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <set>
 
 using namespace fcl;
 
@@ -66,6 +70,39 @@ using namespace fcl;
 template <typename S>
 void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool verbose = false);
 
+/// @brief test that the parallel self collision of the dynamic AABB tree finds
+/// the same pairs and contacts as the serial one, reproducibly
+template <typename S>
+void broad_phase_parallel_self_collision_test(S env_scale, std::size_t env_size, unsigned int num_threads);
+
+/// @brief test that the callable callbacks and the pair collection of the
+/// dynamic AABB tree agree with the function pointer callbacks
+template <typename S>
+void broad_phase_callable_test(S env_scale, std::size_t env_size, std::size_t query_size);
+
+/// @brief test that the pair cache reports the begin, persist and end events
+/// of the overlapping pairs across updates of the manager
+template <typename S>
+void broad_phase_pair_cache_test(S env_scale, std::size_t env_size);
+
+/// @brief test that the enlarged leaves of the dynamic AABB tree skip the
+/// reinsertion of slightly moving objects without changing the collisions
+template <typename S>
+void broad_phase_pair_cache_gjk_guess_test();
+
+template <typename S>
+void broad_phase_fat_aabb_test(S env_scale, std::size_t env_size);
+
+/// @brief test that the parallel linear BVH construction of the dynamic AABB
+/// trees builds valid trees reporting the same pairs as the naive manager
+template <typename S>
+void broad_phase_lbvh_test(S env_scale, std::size_t env_size);
+
+/// @brief test that the spatial hashing manager agrees with the naive manager
+/// after objects are unregistered and moved one by one
+template <typename S>
+void broad_phase_spatial_hash_unregister_test(S env_scale, std::size_t env_size);
+
 /// @brief test for broad phase update
 template <typename S>
 void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts = 1, bool exhaustive = false, bool use_mesh = false);
@@ -95,6 +132,177 @@ GTEST_TEST(FCL_BROADPHASE, test_broad_phase_dont_duplicate_check)
 #endif
 }
 
+/// make sure the parallel self collision of the dynamic AABB tree agrees with
+/// the serial one
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_parallel_self_collision)
+{
+#ifdef NDEBUG
+  broad_phase_parallel_self_collision_test<double>(2000, 1000, 4);
+  broad_phase_parallel_self_collision_test<double>(2000, 1000, 3);
+#else
+  broad_phase_parallel_self_collision_test<double>(2000, 100, 4);
+  broad_phase_parallel_self_collision_test<double>(2000, 100, 3);
+#endif
+  broad_phase_parallel_self_collision_test<double>(2000, 2, 4);
+}
+
+/// make sure the callable callbacks of the dynamic AABB tree see the same pairs
+/// as the function pointer ones
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_callable)
+{
+#ifdef NDEBUG
+  broad_phase_callable_test<double>(2000, 1000, 10);
+#else
+  broad_phase_callable_test<double>(2000, 100, 10);
+#endif
+}
+
+/// make sure the pair cache tracks the overlapping pairs across updates
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_pair_cache)
+{
+#ifdef NDEBUG
+  broad_phase_pair_cache_test<double>(2000, 1000);
+#else
+  broad_phase_pair_cache_test<double>(2000, 100);
+#endif
+}
+
+/// make sure the pair cache warm starts GJK only where the solver uses the guess
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_pair_cache_gjk_guess)
+{
+  broad_phase_pair_cache_gjk_guess_test<double>();
+}
+
+/// A PairHashSet that can jump to the end of its generation counter
+class TestPairHashSet : public detail::PairHashSet<int>
+{
+public:
+  void setGeneration(std::uint32_t generation)
+  {
+    // Refill the live pairs under the new generation, as if the counter had
+    // reached it by clearing; the stamps of the older generations stay
+    std::vector<Slot> live;
+    for(const auto& s : slots_)
+    {
+      if(s.generation == generation_)
+        live.push_back(s);
+    }
+    generation_ = generation;
+    size_ = 0;
+    for(const auto& s : live)
+      insert(s.first, s.second);
+  }
+
+  std::uint32_t generation() const { return generation_; }
+};
+
+/// make sure the pairs are unordered and survive the rehashes of a growing set
+GTEST_TEST(FCL_BROADPHASE, test_pair_hash_set_insert)
+{
+  std::vector<int> objs(1000);
+  detail::PairHashSet<int> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(&objs[0], &objs[1]));
+
+  // (a, b) and (b, a) are the same pair
+  EXPECT_TRUE(set.insert(&objs[0], &objs[1]));
+  EXPECT_FALSE(set.insert(&objs[1], &objs[0]));
+  EXPECT_TRUE(set.contains(&objs[1], &objs[0]));
+  EXPECT_EQ(set.size(), 1u);
+
+  // Enough pairs to rehash several times from the initial 64 slots
+  std::size_t num_pairs = 1;
+  for(std::size_t i = 1; i < objs.size(); ++i)
+  {
+    EXPECT_TRUE(set.insert(&objs[i], &objs[i - 1]) == (i != 1));
+    EXPECT_TRUE(set.insert(&objs[0], &objs[i]) == (i != 1));
+    num_pairs += (i == 1) ? 0 : 2;
+  }
+  EXPECT_EQ(set.size(), num_pairs);
+
+  for(std::size_t i = 1; i < objs.size(); ++i)
+  {
+    EXPECT_TRUE(set.contains(&objs[i - 1], &objs[i]));
+    EXPECT_TRUE(set.contains(&objs[i], &objs[0]));
+  }
+  for(std::size_t i = 3; i < objs.size(); ++i)
+    EXPECT_FALSE(set.contains(&objs[i], &objs[i - 2]));
+}
+
+/// make sure clear() empties the set by starting a new generation, also when
+/// the generation counter wraps around
+GTEST_TEST(FCL_BROADPHASE, test_pair_hash_set_clear)
+{
+  std::vector<int> objs(100);
+  TestPairHashSet set;
+  for(std::size_t i = 1; i < objs.size(); ++i)
+    set.insert(&objs[i - 1], &objs[i]);
+
+  const std::uint32_t generation = set.generation();
+  set.clear();
+  EXPECT_EQ(set.generation(), generation + 1);
+  EXPECT_TRUE(set.empty());
+  for(std::size_t i = 1; i < objs.size(); ++i)
+    EXPECT_FALSE(set.contains(&objs[i - 1], &objs[i]));
+
+  // Refilling reuses the slots of the old generation
+  for(std::size_t i = 2; i < objs.size(); ++i)
+    EXPECT_TRUE(set.insert(&objs[i - 2], &objs[i]));
+  EXPECT_EQ(set.size(), objs.size() - 2);
+
+  // Stamps of the old generations must not survive the wraparound, where
+  // those of generation 1 would be live again
+  set.setGeneration(std::numeric_limits<std::uint32_t>::max());
+  EXPECT_EQ(set.size(), objs.size() - 2);
+  EXPECT_TRUE(set.contains(&objs[0], &objs[2]));
+  set.clear();
+  EXPECT_EQ(set.generation(), 1u);
+  EXPECT_TRUE(set.empty());
+  for(std::size_t i = 2; i < objs.size(); ++i)
+    EXPECT_FALSE(set.contains(&objs[i - 2], &objs[i]));
+
+  for(std::size_t i = 1; i < objs.size(); ++i)
+    EXPECT_TRUE(set.insert(&objs[i - 1], &objs[i]));
+  EXPECT_EQ(set.size(), objs.size() - 1);
+  EXPECT_FALSE(set.contains(&objs[0], &objs[2]));
+}
+
+/// make sure the enlarged leaves of the dynamic AABB tree only reinsert the
+/// objects that moved far
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_fat_aabb)
+{
+#ifdef NDEBUG
+  broad_phase_fat_aabb_test<double>(2000, 1000);
+#else
+  broad_phase_fat_aabb_test<double>(2000, 100);
+#endif
+}
+
+/// make sure the trees built as linear BVHs find the same pairs as the naive
+/// manager
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_lbvh)
+{
+  broad_phase_lbvh_test<double>(2000, 1);
+  broad_phase_lbvh_test<double>(2000, 2);
+  broad_phase_lbvh_test<double>(2000, 3);
+#ifdef NDEBUG
+  broad_phase_lbvh_test<double>(2000, 10000);
+#else
+  broad_phase_lbvh_test<double>(2000, 1000);
+#endif
+}
+
+/// make sure unregistering and updating single objects keeps the spatial hash
+/// consistent
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_spatial_hash_unregister)
+{
+#ifdef NDEBUG
+  broad_phase_spatial_hash_unregister_test<double>(2000, 1000);
+#else
+  broad_phase_spatial_hash_unregister_test<double>(2000, 100);
+#endif
+}
+
 /// check the update, only return collision or not
 GTEST_TEST(FCL_BROADPHASE, test_core_bf_broad_phase_update_collision_binary)
 {
@@ -217,6 +425,7 @@ void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool ve
   SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
   S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / 20, (upper_limit[1] - lower_limit[1]) / 20), (upper_limit[2] - lower_limit[2])/20);
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >(cell_size, lower_limit, upper_limit));
+  managers.push_back(new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
 #if USE_GOOGLEHASH
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleSparseHashTable> >(cell_size, lower_limit, upper_limit));
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleDenseHashTable> >(cell_size, lower_limit, upper_limit));
@@ -345,6 +554,622 @@ void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool ve
   std::cout << std::endl;
 }
 
+//==============================================================================
+template <typename S>
+void broad_phase_parallel_self_collision_test(S env_scale, std::size_t env_size, unsigned int num_threads)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  // Broadphase pairs
+  CollisionDataForUniquenessChecking<S> serial_pairs;
+  manager.collide(&serial_pairs, collisionFunctionForUniquenessChecking<S>);
+
+  std::vector<CollisionDataForUniquenessChecking<S>> parallel_pairs(num_threads);
+  std::vector<void*> parallel_pairs_ptr(num_threads);
+  for(unsigned int i = 0; i < num_threads; ++i)
+    parallel_pairs_ptr[i] = &parallel_pairs[i];
+  manager.collideParallel(parallel_pairs_ptr, collisionFunctionForUniquenessChecking<S>);
+
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> merged_pairs;
+  for(const auto& data : parallel_pairs)
+  {
+    for(const auto& pair : data.checkedPairs)
+    {
+      EXPECT_TRUE(merged_pairs.insert(pair).second);
+    }
+  }
+  EXPECT_TRUE(merged_pairs == serial_pairs.checkedPairs);
+
+  // Narrowphase contacts, twice to check that each thread sees the same pairs
+  test::CollisionData<S> serial_data;
+  serial_data.request.num_max_contacts = 100000;
+  manager.collide(&serial_data, test::defaultCollisionFunction);
+
+  std::vector<std::size_t> first_num_contacts;
+  for(int run = 0; run < 2; ++run)
+  {
+    std::vector<test::CollisionData<S>> parallel_data(num_threads);
+    std::vector<void*> parallel_data_ptr(num_threads);
+    for(unsigned int i = 0; i < num_threads; ++i)
+    {
+      parallel_data[i].request.num_max_contacts = 100000;
+      parallel_data_ptr[i] = &parallel_data[i];
+    }
+    manager.collideParallel(parallel_data_ptr, test::defaultCollisionFunction);
+
+    std::vector<std::size_t> num_contacts(num_threads);
+    std::size_t total_contacts = 0;
+    for(unsigned int i = 0; i < num_threads; ++i)
+    {
+      num_contacts[i] = parallel_data[i].result.numContacts();
+      total_contacts += num_contacts[i];
+    }
+    EXPECT_EQ(total_contacts, serial_data.result.numContacts());
+
+    if(run == 0)
+      first_num_contacts = num_contacts;
+    else
+      EXPECT_TRUE(num_contacts == first_num_contacts);
+  }
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_callable_test(S env_scale, std::size_t env_size, std::size_t query_size)
+{
+  using Pair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  std::vector<CollisionObject<S>*> query;
+  test::generateEnvironments(query, env_scale, query_size);
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  DynamicAABBTreeCollisionManager<S> query_manager;
+  query_manager.registerObjects(query);
+  query_manager.setup();
+
+  // Self collision
+  CollisionDataForUniquenessChecking<S> pointer_pairs;
+  manager.collide(&pointer_pairs, collisionFunctionForUniquenessChecking<S>);
+
+  std::set<Pair> callable_pairs;
+  manager.collide([&](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    EXPECT_TRUE(callable_pairs.emplace(o1, o2).second);
+    return false;
+  });
+  EXPECT_TRUE(callable_pairs == pointer_pairs.checkedPairs);
+
+  typename DynamicAABBTreeCollisionManager<S>::CollisionPairs pairs;
+  manager.collidePairs(pairs);
+  EXPECT_TRUE(std::set<Pair>(pairs.begin(), pairs.end()) == pointer_pairs.checkedPairs);
+  EXPECT_EQ(pairs.size(), pointer_pairs.checkedPairs.size());
+
+  // Stop at the first pair
+  std::size_t num_calls = 0;
+  manager.collide([&](CollisionObject<S>*, CollisionObject<S>*)
+  {
+    ++num_calls;
+    return true;
+  });
+  EXPECT_EQ(num_calls, std::min<std::size_t>(1, pairs.size()));
+
+  // Narrowphase with the default callbacks wrapped in callables
+  test::CollisionData<S> pointer_data;
+  pointer_data.request.num_max_contacts = 100000;
+  manager.collide(&pointer_data, test::defaultCollisionFunction);
+
+  test::CollisionData<S> callable_data;
+  callable_data.request.num_max_contacts = 100000;
+  manager.collide([&](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    return test::defaultCollisionFunction(o1, o2, &callable_data);
+  });
+  EXPECT_EQ(callable_data.result.numContacts(), pointer_data.result.numContacts());
+
+  // Collision and distance against single objects and another manager
+  for(std::size_t i = 0; i < query.size(); ++i)
+  {
+    CollisionDataForUniquenessChecking<S> pointer_query_pairs;
+    manager.collide(query[i], &pointer_query_pairs, collisionFunctionForUniquenessChecking<S>);
+
+    std::set<Pair> callable_query_pairs;
+    manager.collide(query[i], [&](CollisionObject<S>* o1, CollisionObject<S>* o2)
+    {
+      callable_query_pairs.emplace(o1, o2);
+      return false;
+    });
+    EXPECT_TRUE(callable_query_pairs == pointer_query_pairs.checkedPairs);
+
+    test::DistanceData<S> pointer_distance;
+    manager.distance(query[i], &pointer_distance, test::defaultDistanceFunction);
+
+    test::DistanceData<S> callable_distance;
+    manager.distance(query[i], [&](CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist)
+    {
+      return test::defaultDistanceFunction(o1, o2, &callable_distance, dist);
+    });
+    EXPECT_EQ(callable_distance.result.min_distance, pointer_distance.result.min_distance);
+  }
+
+  CollisionDataForUniquenessChecking<S> pointer_manager_pairs;
+  manager.collide(&query_manager, &pointer_manager_pairs, collisionFunctionForUniquenessChecking<S>);
+
+  std::set<Pair> callable_manager_pairs;
+  manager.collide(&query_manager, [&](CollisionObject<S>* o1, CollisionObject<S>* o2)
+  {
+    callable_manager_pairs.emplace(o1, o2);
+    return false;
+  });
+  EXPECT_TRUE(callable_manager_pairs == pointer_manager_pairs.checkedPairs);
+
+  test::DistanceData<S> pointer_distance;
+  manager.distance(&pointer_distance, test::defaultDistanceFunction);
+
+  test::DistanceData<S> callable_distance;
+  manager.distance([&](CollisionObject<S>* o1, CollisionObject<S>* o2, S& dist)
+  {
+    return test::defaultDistanceFunction(o1, o2, &callable_distance, dist);
+  });
+  EXPECT_EQ(callable_distance.result.min_distance, pointer_distance.result.min_distance);
+
+  for(auto obj : env)
+    delete obj;
+  for(auto obj : query)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> orderedPairs(
+    const std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>>& pairs)
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> ordered;
+  for(const auto& pair : pairs)
+  {
+    if(pair.first < pair.second) ordered.emplace(pair.first, pair.second);
+    else ordered.emplace(pair.second, pair.first);
+  }
+  return ordered;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_pair_cache_test(S env_scale, std::size_t env_size)
+{
+  using Pair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  typename DynamicAABBTreeCollisionManager<S>::CollisionPairs pairs;
+  manager.collidePairs(pairs);
+  const std::set<Pair> old_pairs = orderedPairs<S>(pairs);
+
+  // All the pairs begin in the first update
+  BroadPhasePairCache<S> cache;
+  cache.update(&manager);
+  std::set<Pair> begin_pairs;
+  for(auto pair : cache.getBeginPairs())
+  {
+    EXPECT_TRUE(pair->o1 < pair->o2);
+    EXPECT_EQ(pair->num_updates, 1u);
+    begin_pairs.emplace(pair->o1, pair->o2);
+  }
+  EXPECT_TRUE(begin_pairs == old_pairs);
+  EXPECT_TRUE(cache.getPersistPairs().empty());
+  EXPECT_TRUE(cache.getEndPairs().empty());
+  EXPECT_EQ(cache.size(), old_pairs.size());
+
+  // and persist in the second one, keeping their narrow phase state
+  for(auto pair : cache.getBeginPairs())
+  {
+    CollisionRequest<S> request;
+    CollisionResult<S> result;
+    BroadPhasePairCache<S>::collide(*pair, request, result);
+
+    CollisionResult<S> cold_result;
+    collide(pair->o1, pair->o2, request, cold_result);
+    EXPECT_EQ(pair->is_collide, cold_result.isCollision());
+  }
+
+  cache.update(&manager);
+  EXPECT_TRUE(cache.getBeginPairs().empty());
+  EXPECT_TRUE(cache.getEndPairs().empty());
+  EXPECT_EQ(cache.getPersistPairs().size(), old_pairs.size());
+  for(auto pair : cache.getPersistPairs())
+  {
+    EXPECT_EQ(pair->num_updates, 2u);
+
+    CollisionRequest<S> request;
+    CollisionResult<S> cold_result;
+    collide(pair->o1, pair->o2, request, cold_result);
+    EXPECT_EQ(pair->is_collide, cold_result.isCollision());
+  }
+
+  // Moving half of the objects ends some pairs and begins others
+  for(std::size_t i = 0; i < env.size(); i += 2)
+  {
+    Transform3<S> tf = env[i]->getTransform();
+    tf.translation() += Vector3<S>(env_scale / 10, 0, 0);
+    env[i]->setTransform(tf);
+    env[i]->computeAABB();
+  }
+  manager.update();
+
+  pairs.clear();
+  manager.collidePairs(pairs);
+  const std::set<Pair> new_pairs = orderedPairs<S>(pairs);
+
+  cache.update(&manager);
+  std::set<Pair> current_pairs;
+  for(auto pair : cache.getBeginPairs())
+  {
+    EXPECT_TRUE(old_pairs.find(Pair(pair->o1, pair->o2)) == old_pairs.end());
+    current_pairs.emplace(pair->o1, pair->o2);
+  }
+  for(auto pair : cache.getPersistPairs())
+  {
+    EXPECT_TRUE(old_pairs.find(Pair(pair->o1, pair->o2)) != old_pairs.end());
+    current_pairs.emplace(pair->o1, pair->o2);
+  }
+  EXPECT_TRUE(current_pairs == new_pairs);
+
+  for(const auto& pair : cache.getEndPairs())
+  {
+    EXPECT_TRUE(old_pairs.find(Pair(pair.o1, pair.o2)) != old_pairs.end());
+    EXPECT_TRUE(new_pairs.find(Pair(pair.o1, pair.o2)) == new_pairs.end());
+    EXPECT_TRUE(cache.find(pair.o1, pair.o2) == nullptr);
+  }
+  EXPECT_EQ(cache.getBeginPairs().size() + old_pairs.size(),
+            cache.getEndPairs().size() + new_pairs.size());
+
+  // Removing an object drops its pairs
+  for(auto obj : env)
+  {
+    cache.remove(obj);
+    for(auto other : env)
+      EXPECT_TRUE(cache.find(obj, other) == nullptr);
+  }
+  EXPECT_EQ(cache.size(), 0u);
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> collidingPairs(
+    const DynamicAABBTreeCollisionManager<S>& manager)
+{
+  std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  manager.collide([&pairs](CollisionObject<S>* o1, CollisionObject<S>* o2) {
+    CollisionRequest<S> request;
+    CollisionResult<S> result;
+    if(collide(o1, o2, request, result))
+      pairs.emplace_back(o1, o2);
+    return false;
+  });
+  return orderedPairs<S>(pairs);
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_pair_cache_gjk_guess_test()
+{
+  // A pair of shapes that goes through the generic GJK of both solvers
+  auto ellipsoid = std::make_shared<Ellipsoid<S>>(1, 2, 3);
+  auto cylinder = std::make_shared<Cylinder<S>>(1, 4);
+  Transform3<S> tf = Transform3<S>::Identity();
+  tf.translation() = Vector3<S>(1.5, 0.5, 0.2);
+  CollisionObject<S> obj1(ellipsoid);
+  CollisionObject<S> obj2(cylinder, tf);
+
+  CollisionRequest<S> request;
+  request.gjk_solver_type = GST_INDEP;
+
+  // The guess of the first query is kept on the pair
+  BroadPhasePair<S> pair(&obj1, &obj2);
+  CollisionResult<S> result;
+  EXPECT_TRUE(BroadPhasePairCache<S>::collide(pair, request, result));
+  EXPECT_FALSE(pair.cached_gjk_guess.isApprox(Vector3<S>::UnitX()));
+
+  // and warm starts the next one, as an explicit cached guess would
+  CollisionRequest<S> warm_request = request;
+  warm_request.enable_cached_gjk_guess = true;
+  warm_request.cached_gjk_guess = pair.cached_gjk_guess;
+  CollisionResult<S> warm_result;
+  collide(&obj1, &obj2, warm_request, warm_result);
+
+  result.clear();
+  EXPECT_TRUE(BroadPhasePairCache<S>::collide(pair, request, result));
+  EXPECT_TRUE(pair.cached_gjk_guess.isApprox(warm_result.cached_gjk_guess));
+
+  // libccd ignores the guess, so the pair keeps its initial one
+  request.gjk_solver_type = GST_LIBCCD;
+  BroadPhasePair<S> ccd_pair(&obj1, &obj2);
+  CollisionResult<S> ccd_result;
+  EXPECT_TRUE(BroadPhasePairCache<S>::collide(ccd_pair, request, ccd_result));
+  EXPECT_TRUE(ccd_pair.cached_gjk_guess.isApprox(Vector3<S>::UnitX()));
+
+  // as does a result that never ran a narrow phase
+  CollisionResult<S> empty_result;
+  EXPECT_TRUE(empty_result.cached_gjk_guess.isApprox(Vector3<S>::UnitX()));
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_fat_aabb_test(S env_scale, std::size_t env_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  const S margin = env_scale / 1000;
+  const int num_frames = 5;
+
+  DynamicAABBTreeCollisionManager<S> tight_manager;
+  tight_manager.registerObjects(env);
+  tight_manager.setup();
+
+  DynamicAABBTreeCollisionManager<S> fat_manager;
+  fat_manager.fat_aabb_margin = margin;
+  fat_manager.registerObjects(env);
+  fat_manager.setup();
+
+  EXPECT_TRUE(collidingPairs(fat_manager) == collidingPairs(tight_manager));
+
+  // The objects jitter by less than the margin in total, so none of them
+  // leaves its enlarged leaf
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    for(std::size_t i = 0; i < env.size(); ++i)
+    {
+      const S step = margin / (2 * num_frames);
+      const S sign = (frame % 2 == 0) ? 1 : -1;
+      Transform3<S> tf = env[i]->getTransform();
+      tf.translation() += sign * step * Vector3<S>(
+          (S)((int)(i % 3) - 1), (S)((int)(i % 5) - 2) / 2, (S)(i % 2));
+      env[i]->setTransform(tf);
+      env[i]->computeAABB();
+    }
+
+    tight_manager.update();
+    fat_manager.update();
+    EXPECT_TRUE(collidingPairs(fat_manager) == collidingPairs(tight_manager));
+  }
+  EXPECT_EQ(fat_manager.getReinsertionCount(), 0u);
+  EXPECT_EQ(fat_manager.getSkippedUpdateCount(), num_frames * env.size());
+
+  // Moving half of the objects far reinserts exactly these ones
+  fat_manager.resetUpdateCounters();
+  EXPECT_EQ(fat_manager.getReinsertionCount(), 0u);
+  EXPECT_EQ(fat_manager.getSkippedUpdateCount(), 0u);
+
+  std::vector<CollisionObject<S>*> moved_objs;
+  for(std::size_t i = 0; i < env.size(); i += 2)
+  {
+    Transform3<S> tf = env[i]->getTransform();
+    tf.translation() += Vector3<S>(env_scale / 10, 0, 0);
+    env[i]->setTransform(tf);
+    env[i]->computeAABB();
+    moved_objs.push_back(env[i]);
+  }
+
+  tight_manager.update(moved_objs);
+  fat_manager.update();
+  EXPECT_EQ(fat_manager.getReinsertionCount(), moved_objs.size());
+  EXPECT_EQ(fat_manager.getSkippedUpdateCount(), env.size() - moved_objs.size());
+  EXPECT_TRUE(collidingPairs(fat_manager) == collidingPairs(tight_manager));
+
+  // The leaves of the moved objects are extended along their motion, so that
+  // moving them again in the same direction does not reinsert them
+  fat_manager.resetUpdateCounters();
+  for(auto obj : moved_objs)
+  {
+    Transform3<S> tf = obj->getTransform();
+    tf.translation() += Vector3<S>(env_scale / 20, 0, 0);
+    obj->setTransform(tf);
+    obj->computeAABB();
+    fat_manager.update(obj);
+  }
+  tight_manager.update(moved_objs);
+  EXPECT_EQ(fat_manager.getReinsertionCount(), 0u);
+  EXPECT_EQ(fat_manager.getSkippedUpdateCount(), moved_objs.size());
+  EXPECT_TRUE(collidingPairs(fat_manager) == collidingPairs(tight_manager));
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+bool collisionFunctionForPairCollection(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* pairs = static_cast<std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>>*>(cdata_);
+  pairs->emplace_back(o1, o2);
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t checkLBVHNode(const detail::NodeBase<AABB<S>>* node)
+{
+  if(node->isLeaf()) return 1;
+
+  std::size_t num_leaves = 0;
+  for(int i = 0; i < 2; ++i)
+  {
+    const detail::NodeBase<AABB<S>>* child = node->children[i];
+    EXPECT_TRUE(child->parent == node);
+    EXPECT_TRUE(node->bv.contain(child->bv));
+    num_leaves += checkLBVHNode<S>(child);
+  }
+  return num_leaves;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t checkLBVHNode(
+    const detail::implementation_array::NodeBase<AABB<S>>* nodes, std::size_t node)
+{
+  if(nodes[node].isLeaf()) return 1;
+
+  std::size_t num_leaves = 0;
+  for(int i = 0; i < 2; ++i)
+  {
+    const std::size_t child = nodes[node].children[i];
+    EXPECT_EQ(nodes[child].parent, node);
+    EXPECT_TRUE(nodes[node].bv.contain(nodes[child].bv));
+    num_leaves += checkLBVHNode<S>(nodes, child);
+  }
+  return num_leaves;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_lbvh_test(S env_scale, std::size_t env_size)
+{
+  using Pair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+  for(std::size_t i = env_size; i < env.size(); ++i)
+    delete env[i];
+  env.resize(env_size);
+
+  // Boxes at the same place share their morton code
+  for(std::size_t i = 0; i < env_size / 10; ++i)
+  {
+    auto box = std::make_shared<Box<S>>(5, 10, 20);
+    env.push_back(new CollisionObject<S>(box, env[i]->getTransform()));
+  }
+
+  NaiveCollisionManager<S> naive_manager;
+  naive_manager.registerObjects(env);
+  naive_manager.setup();
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.tree_init_level = 4;
+  manager.registerObjects(env);
+  manager.setup();
+
+  DynamicAABBTreeCollisionManager_Array<S> array_manager;
+  array_manager.tree_init_level = 4;
+  array_manager.registerObjects(env);
+  array_manager.setup();
+
+  const auto& tree = manager.getTree();
+  EXPECT_EQ(tree.size(), env.size());
+  EXPECT_TRUE(tree.getRoot()->parent == nullptr);
+  EXPECT_EQ(checkLBVHNode<S>(tree.getRoot()), env.size());
+
+  const auto& array_tree = array_manager.getTree();
+  EXPECT_EQ(array_tree.size(), env.size());
+  EXPECT_EQ(checkLBVHNode<S>(array_tree.getNodes(), array_tree.getRoot()), env.size());
+
+  std::vector<Pair> naive_pairs;
+  naive_manager.collide(&naive_pairs, collisionFunctionForPairCollection<S>);
+
+  std::vector<Pair> pairs;
+  manager.collide(&pairs, collisionFunctionForPairCollection<S>);
+  EXPECT_EQ(pairs.size(), naive_pairs.size());
+  EXPECT_TRUE(orderedPairs<S>(pairs) == orderedPairs<S>(naive_pairs));
+
+  std::vector<Pair> array_pairs;
+  array_manager.collide(&array_pairs, collisionFunctionForPairCollection<S>);
+  EXPECT_EQ(array_pairs.size(), naive_pairs.size());
+  EXPECT_TRUE(orderedPairs<S>(array_pairs) == orderedPairs<S>(naive_pairs));
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_spatial_hash_unregister_test(S env_scale, std::size_t env_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  // Use a scene limit smaller than the environment so that all three object
+  // lists of the manager are exercised
+  Vector3<S> lower_limit, upper_limit;
+  SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
+  lower_limit *= 0.5;
+  upper_limit *= 0.5;
+  S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / 20, (upper_limit[1] - lower_limit[1]) / 20), (upper_limit[2] - lower_limit[2])/20);
+
+  SpatialHashingCollisionManager<S> manager(cell_size, lower_limit, upper_limit);
+  NaiveCollisionManager<S> naive_manager;
+  manager.registerObjects(env);
+  naive_manager.registerObjects(env);
+  manager.setup();
+  naive_manager.setup();
+
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    manager.unregisterObject(env[i]);
+    naive_manager.unregisterObject(env[i]);
+  }
+  EXPECT_EQ(manager.size(), naive_manager.size());
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale, -env_scale, env_scale};
+  test::generateRandomTransforms(extents, transforms, env.size());
+  for(std::size_t i = 1; i < env.size(); i += 3)
+  {
+    env[i]->setTransform(transforms[i]);
+    env[i]->computeAABB();
+    manager.update(env[i]);
+  }
+  naive_manager.update();
+
+  test::CollisionData<S> self_data;
+  self_data.request.num_max_contacts = 100000;
+  manager.collide(&self_data, test::defaultCollisionFunction);
+
+  test::CollisionData<S> naive_self_data;
+  naive_self_data.request.num_max_contacts = 100000;
+  naive_manager.collide(&naive_self_data, test::defaultCollisionFunction);
+
+  EXPECT_EQ(self_data.result.numContacts(), naive_self_data.result.numContacts());
+
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    test::CollisionData<S> query_data;
+    query_data.request.num_max_contacts = 100000;
+    manager.collide(env[i], &query_data, test::defaultCollisionFunction);
+
+    test::CollisionData<S> naive_query_data;
+    naive_query_data.request.num_max_contacts = 100000;
+    naive_manager.collide(env[i], &naive_query_data, test::defaultCollisionFunction);
+
+    EXPECT_EQ(query_data.result.numContacts(), naive_query_data.result.numContacts());
+  }
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
 template <typename S>
 void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts, bool exhaustive, bool use_mesh)
 {
@@ -375,8 +1200,8 @@ void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::s
   Vector3<S> lower_limit, upper_limit;
   SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
   S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / 20, (upper_limit[1] - lower_limit[1]) / 20), (upper_limit[2] - lower_limit[2])/20);
-  // managers.push_back(new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >(cell_size, lower_limit, upper_limit));
+  managers.push_back(new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
 #if USE_GOOGLEHASH
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleSparseHashTable> >(cell_size, lower_limit, upper_limit));
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleDenseHashTable> >(cell_size, lower_limit, upper_limit));
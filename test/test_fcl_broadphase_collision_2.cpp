@@ -45,9 +45,12 @@
 #include "fcl/broadphase/broadphase_interval_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
 #include "fcl/broadphase/detail/sparse_hash_table.h"
 #include "fcl/broadphase/detail/spatial_hash.h"
 #include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/continuous_collision.h"
+#include "fcl/narrowphase/distance.h"
 #include "test_fcl_utility.h"
 
 #if USE_GOOGLEHASH
@@ -58,6 +61,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <set>
 
 using namespace fcl;
 
@@ -65,6 +70,10 @@ using namespace fcl;
 template <typename S>
 void broad_phase_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts = 1, bool exhaustive = false, bool use_mesh = false);
 
+/// @brief test for continuous broad phase collision and distance
+template <typename S>
+void broad_phase_continuous_collision_test(CCDMotionType motion_type, std::size_t env_size);
+
 #if USE_GOOGLEHASH
 template<typename U, typename V>
 struct GoogleSparseHashTable : public google::sparse_hash_map<U, V, std::tr1::hash<size_t>, std::equal_to<size_t> > {};
@@ -181,6 +190,16 @@ GTEST_TEST(FCL_BROADPHASE, test_core_mesh_bf_broad_phase_collision_mesh_exhausti
 #endif
 }
 
+/// check that the continuous dynamic AABB tree reports the same colliding
+/// pairs and the same minimum distance as checking all the pairs
+GTEST_TEST(FCL_BROADPHASE, test_core_continuous_broad_phase_collision)
+{
+  broad_phase_continuous_collision_test<double>(CCDM_TRANS, 40);
+  broad_phase_continuous_collision_test<double>(CCDM_LINEAR, 40);
+  broad_phase_continuous_collision_test<double>(CCDM_SCREW, 40);
+  broad_phase_continuous_collision_test<double>(CCDM_SPLINE, 40);
+}
+
 template <typename S>
 void broad_phase_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts, bool exhaustive, bool use_mesh)
 {
@@ -211,8 +230,8 @@ void broad_phase_collision_test(S env_scale, std::size_t env_size, std::size_t q
   // S ncell_per_axis = std::pow((S)env_size / 10, 1 / 3.0);
   S ncell_per_axis = 20;
   S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / ncell_per_axis, (upper_limit[1] - lower_limit[1]) / ncell_per_axis), (upper_limit[2] - lower_limit[2]) / ncell_per_axis);
-  // managers.push_back(new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>> >(cell_size, lower_limit, upper_limit));
+  managers.push_back(new SpatialHashingCollisionManager<S>(cell_size, lower_limit, upper_limit));
 #if USE_GOOGLEHASH
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleSparseHashTable> >(cell_size, lower_limit, upper_limit));
   managers.push_back(new SpatialHashingCollisionManager<S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*, detail::SpatialHash<S>, GoogleDenseHashTable> >(cell_size, lower_limit, upper_limit));
@@ -377,6 +396,123 @@ void broad_phase_collision_test(S env_scale, std::size_t env_size, std::size_t q
 
 }
 
+//==============================================================================
+template <typename S>
+struct ContinuousCollisionDataForTest
+{
+  ContinuousCollisionRequest<S> request;
+  std::set<std::pair<ContinuousCollisionObject<S>*, ContinuousCollisionObject<S>*>> pairs;
+};
+
+//==============================================================================
+template <typename S>
+bool continuousCollisionFunctionForTest(ContinuousCollisionObject<S>* o1, ContinuousCollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<ContinuousCollisionDataForTest<S>*>(cdata_);
+  ContinuousCollisionResult<S> result;
+  collide(o1, o2, cdata->request, result);
+  if(result.is_collide)
+    cdata->pairs.insert(std::make_pair(std::min(o1, o2), std::max(o1, o2)));
+  return false;
+}
+
+//==============================================================================
+/// @brief distance between the objects at the beginning of their motions
+template <typename S>
+bool continuousDistanceFunctionForTest(ContinuousCollisionObject<S>* o1, ContinuousCollisionObject<S>* o2, void* cdata_, S& dist)
+{
+  auto* min_dist = static_cast<S*>(cdata_);
+  o1->getMotion()->integrate(0);
+  o2->getMotion()->integrate(0);
+  Transform3<S> tf1;
+  Transform3<S> tf2;
+  o1->getMotion()->getCurrentTransform(tf1);
+  o2->getMotion()->getCurrentTransform(tf2);
+
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  distance(o1->collisionGeometry().get(), tf1, o2->collisionGeometry().get(), tf2, request, result);
+  if(result.min_distance < *min_dist)
+    *min_dist = result.min_distance;
+  dist = *min_dist;
+  return dist <= 0;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_continuous_collision_test(CCDMotionType motion_type, std::size_t env_size)
+{
+  const S env_scale = 8;
+  Eigen::aligned_vector<Transform3<S>> tf_begs;
+  Eigen::aligned_vector<Transform3<S>> tf_ends;
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale, -env_scale, env_scale};
+  test::generateRandomTransforms(extents, tf_begs, env_size);
+  tf_ends.resize(env_size);
+  for(std::size_t i = 0; i < env_size; ++i)
+  {
+    // Keep the objects moving locally so that only some of the sweeps overlap
+    Vector3<S> axis = Vector3<S>::Random().normalized();
+    tf_ends[i] = tf_begs[i];
+    tf_ends[i].translation() += Vector3<S>::Random() * 4;
+    tf_ends[i].linear() = tf_begs[i].linear() * AngleAxis<S>(constants<S>::pi() / 3, axis).toRotationMatrix();
+  }
+
+  std::vector<std::shared_ptr<ContinuousCollisionObject<S>>> objs;
+  std::vector<ContinuousCollisionObject<S>*> obj_ptrs;
+  for(std::size_t i = 0; i < env_size; ++i)
+  {
+    std::shared_ptr<CollisionGeometry<S>> box(new Box<S>(3, 2, 1));
+    objs.emplace_back(new ContinuousCollisionObject<S>(box, getMotionBase(tf_begs[i], tf_ends[i], motion_type)));
+    obj_ptrs.push_back(objs.back().get());
+  }
+
+  DynamicAABBTreeContinuousCollisionManager<S> manager;
+  manager.registerObjects(obj_ptrs);
+  manager.setup();
+  EXPECT_EQ(manager.size(), env_size);
+
+  ContinuousCollisionDataForTest<S> cdata;
+  cdata.request.ccd_motion_type = motion_type;
+  manager.collide(&cdata, continuousCollisionFunctionForTest<S>);
+
+  ContinuousCollisionDataForTest<S> cdata_bf;
+  cdata_bf.request.ccd_motion_type = motion_type;
+  S min_dist_bf = std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < env_size; ++i)
+  {
+    for(std::size_t j = i + 1; j < env_size; ++j)
+    {
+      continuousCollisionFunctionForTest<S>(obj_ptrs[i], obj_ptrs[j], &cdata_bf);
+      S dist;
+      continuousDistanceFunctionForTest<S>(obj_ptrs[i], obj_ptrs[j], &min_dist_bf, dist);
+    }
+  }
+
+  EXPECT_TRUE(cdata.pairs == cdata_bf.pairs);
+  EXPECT_TRUE(cdata_bf.pairs.size() > 0);
+
+  S min_dist = std::numeric_limits<S>::max();
+  manager.distance(&min_dist, continuousDistanceFunctionForTest<S>);
+  EXPECT_NEAR(min_dist, min_dist_bf, 1e-6);
+
+  // Querying with one of the managed objects must find its colliding pairs
+  ContinuousCollisionDataForTest<S> cdata_query;
+  cdata_query.request.ccd_motion_type = motion_type;
+  manager.unregisterObject(obj_ptrs[0]);
+  EXPECT_EQ(manager.size(), env_size - 1);
+  manager.collide(obj_ptrs[0], &cdata_query, continuousCollisionFunctionForTest<S>);
+  std::size_t num_pairs_with_first = 0;
+  for(const auto& pair : cdata_bf.pairs)
+  {
+    if(pair.first == obj_ptrs[0] || pair.second == obj_ptrs[0])
+    {
+      ++num_pairs_with_first;
+      EXPECT_TRUE(cdata_query.pairs.count(pair) == 1);
+    }
+  }
+  EXPECT_EQ(cdata_query.pairs.size(), num_pairs_with_first);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -38,8 +38,12 @@
 
 #include "fcl/config.h"
 #include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
 #include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
 #include <iostream>
+#include <sstream>
 
 using namespace fcl;
 
@@ -234,6 +238,339 @@ GTEST_TEST(FCL_BVH_MODELS, building_bvh_models)
   testBVHModel<KDOP<double, 24> >();
 }
 
+/// @brief Check that the BVs of model are stored in the given layout: the
+/// children of the k-th internal node of the layout order sit at 2k + 1 and
+/// 2k + 2
+template<typename BV>
+void checkBVHModelNodeLayout(const BVHModel<BV>& model, BVHNodeLayout layout)
+{
+  // Depth of each internal node, and the internal nodes in depth-first and
+  // breadth-first order
+  std::vector<int> depths(model.getNumBVs(), -1);
+  std::vector<int> depth_first, breadth_first(1, 0);
+  depths[0] = 0;
+  for(std::size_t i = 0; i < breadth_first.size(); ++i)
+  {
+    const BVNode<BV>& node = model.getBV(breadth_first[i]);
+    for(int child : {node.leftChild(), node.rightChild()})
+    {
+      if(model.getBV(child).isLeaf()) continue;
+      depths[child] = depths[breadth_first[i]] + 1;
+      breadth_first.push_back(child);
+    }
+  }
+  std::vector<int> stack(1, 0);
+  while(!stack.empty())
+  {
+    const int id = stack.back();
+    stack.pop_back();
+    depth_first.push_back(id);
+    const BVNode<BV>& node = model.getBV(id);
+    if(!model.getBV(node.rightChild()).isLeaf()) stack.push_back(node.rightChild());
+    if(!model.getBV(node.leftChild()).isLeaf()) stack.push_back(node.leftChild());
+  }
+
+  // Each children pair takes its own slot
+  std::vector<int> slots(breadth_first.size(), 0);
+  for(int id : breadth_first)
+  {
+    const int first_child = model.getBV(id).first_child;
+    EXPECT_EQ(first_child % 2, 1);
+    EXPECT_LT(first_child / 2, static_cast<int>(slots.size()));
+    if(first_child % 2 == 1 && first_child / 2 < static_cast<int>(slots.size()))
+      ++slots[first_child / 2];
+  }
+  for(int count : slots)
+    EXPECT_EQ(count, 1);
+
+  if(layout == BVH_LAYOUT_DEPTH_FIRST || layout == BVH_LAYOUT_BREADTH_FIRST)
+  {
+    const std::vector<int>& order =
+        (layout == BVH_LAYOUT_DEPTH_FIRST) ? depth_first : breadth_first;
+    for(std::size_t k = 0; k < order.size(); ++k)
+      EXPECT_EQ(model.getBV(order[k]).first_child, static_cast<int>(2 * k + 1));
+  }
+  else
+  {
+    // The internal nodes of the top half of the levels come first
+    const int top_levels = (depths[breadth_first.back()] + 1) / 2;
+    int num_top = 0;
+    for(int id : breadth_first)
+      num_top += (depths[id] < top_levels);
+    for(int id : breadth_first)
+    {
+      if(depths[id] < top_levels)
+        EXPECT_LT(model.getBV(id).first_child, 2 * num_top);
+      else
+        EXPECT_GT(model.getBV(id).first_child, 2 * num_top);
+    }
+  }
+}
+
+template<typename BV>
+void testBVHModelNodeLayout(bool test_distance)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> m1, m2;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 200;
+#else
+  std::size_t n = 10;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  CollisionRequest<S> collision_request(100, false);
+  DistanceRequest<S> distance_request;
+
+  std::vector<std::size_t> expected_contacts;
+  std::vector<S> expected_distances;
+
+  for(BVHNodeLayout layout : {BVH_LAYOUT_DEPTH_FIRST, BVH_LAYOUT_BREADTH_FIRST, BVH_LAYOUT_VAN_EMDE_BOAS, BVH_LAYOUT_DEPTH_FIRST})
+  {
+    EXPECT_EQ(m1.setNodeLayout(layout), BVH_OK);
+    EXPECT_EQ(m2.setNodeLayout(layout), BVH_OK);
+    EXPECT_EQ(m1.getBV(0).num_primitives, m1.num_tris);
+    checkBVHModelNodeLayout(m1, layout);
+    checkBVHModelNodeLayout(m2, layout);
+
+    std::vector<std::size_t> contacts;
+    std::vector<S> distances;
+
+    for(const auto& tf : transforms)
+    {
+      CollisionResult<S> result;
+      contacts.push_back(collide(&m1, Transform3<S>::Identity(), &m2, tf, collision_request, result));
+    }
+
+    for(const auto& tf : transforms)
+    {
+      if(!test_distance) break;
+      DistanceResult<S> result;
+      distances.push_back(distance(&m1, Transform3<S>::Identity(), &m2, tf, distance_request, result));
+    }
+
+    if(expected_contacts.empty())
+    {
+      expected_contacts = contacts;
+      expected_distances = distances;
+    }
+    else
+    {
+      EXPECT_TRUE(contacts == expected_contacts);
+      EXPECT_TRUE(distances == expected_distances);
+    }
+  }
+
+  BVHModel<BV> empty;
+  EXPECT_EQ(empty.setNodeLayout(BVH_LAYOUT_VAN_EMDE_BOAS), BVH_ERR_BUILD_OUT_OF_SEQUENCE);
+}
+
+GTEST_TEST(FCL_BVH_MODELS, node_layout)
+{
+  testBVHModelNodeLayout<OBBRSS<double>>(true);
+  testBVHModelNodeLayout<RSS<double>>(true);
+  testBVHModelNodeLayout<AABB<double>>(false);
+}
+
+template<typename BV>
+void testBVHModelParallelBuild(detail::SplitMethodType split_method)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> serial, parallel, rob;
+  serial.bv_splitter.reset(new detail::BVSplitter<BV>(split_method));
+  parallel.bv_splitter.reset(new detail::BVSplitter<BV>(split_method));
+  parallel.num_build_threads = 4;
+
+  serial.beginModel();
+  serial.addSubModel(p1, t1);
+  serial.endModel();
+
+  parallel.beginModel();
+  parallel.addSubModel(p1, t1);
+  parallel.endModel();
+
+  // The same tree is built whatever the number of threads
+  EXPECT_EQ(serial.getNumBVs(), 2 * serial.num_tris - 1);
+  EXPECT_EQ(parallel.getNumBVs(), serial.getNumBVs());
+  for(int i = 0; i < serial.getNumBVs(); ++i)
+  {
+    const BVNode<BV>& a = serial.getBV(i);
+    const BVNode<BV>& b = parallel.getBV(i);
+    EXPECT_EQ(a.first_child, b.first_child);
+    EXPECT_EQ(a.first_primitive, b.first_primitive);
+    EXPECT_EQ(a.num_primitives, b.num_primitives);
+    EXPECT_TRUE(a.getCenter() == b.getCenter());
+    EXPECT_TRUE(a.getOrientation() == b.getOrientation());
+  }
+
+  rob.beginModel();
+  rob.addSubModel(p2, t2);
+  rob.endModel();
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  test::generateRandomTransforms(extents, transforms, 20);
+
+  BVHModel<BV> reference;
+  reference.beginModel();
+  reference.addSubModel(p1, t1);
+  reference.endModel();
+
+  CollisionRequest<S> request(100000, false);
+  for(const auto& tf : transforms)
+  {
+    CollisionResult<S> result1, result2, result3;
+    std::size_t n1 = collide(&serial, Transform3<S>::Identity(), &rob, tf, request, result1);
+    std::size_t n2 = collide(&parallel, Transform3<S>::Identity(), &rob, tf, request, result2);
+    std::size_t n3 = collide(&reference, Transform3<S>::Identity(), &rob, tf, request, result3);
+    EXPECT_EQ(n1, n2);
+    EXPECT_EQ(n1, n3);
+  }
+}
+
+GTEST_TEST(FCL_BVH_MODELS, parallel_build)
+{
+  for(detail::SplitMethodType split_method : {detail::SPLIT_METHOD_MEAN, detail::SPLIT_METHOD_SAH})
+  {
+    testBVHModelParallelBuild<OBBRSS<double>>(split_method);
+    testBVHModelParallelBuild<kIOS<double>>(split_method);
+    testBVHModelParallelBuild<AABB<double>>(split_method);
+  }
+}
+
+template<typename BV>
+void testBVHModelSaveLoad()
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> built, rob;
+  built.beginModel();
+  built.addSubModel(p1, t1);
+  built.endModel();
+  built.setNodeLayout(BVH_LAYOUT_VAN_EMDE_BOAS);
+  built.computeLocalAABB();
+  rob.beginModel();
+  rob.addSubModel(p2, t2);
+  rob.endModel();
+
+  std::stringstream stream;
+  EXPECT_EQ(built.save(stream), BVH_OK);
+
+  BVHModel<BV> loaded;
+  EXPECT_EQ(loaded.load(stream), BVH_OK);
+  EXPECT_EQ(loaded.build_state, BVH_BUILD_STATE_PROCESSED);
+  EXPECT_EQ(loaded.getModelType(), BVH_MODEL_TRIANGLES);
+  EXPECT_EQ(loaded.num_vertices, built.num_vertices);
+  EXPECT_EQ(loaded.num_tris, built.num_tris);
+  EXPECT_EQ(loaded.getNumBVs(), built.getNumBVs());
+  EXPECT_TRUE(loaded.aabb_local.min_ == built.aabb_local.min_);
+  EXPECT_TRUE(loaded.aabb_local.max_ == built.aabb_local.max_);
+
+  for(int i = 0; i < built.num_vertices; ++i)
+    EXPECT_TRUE(loaded.vertices[i] == built.vertices[i]);
+  for(int i = 0; i < built.getNumBVs(); ++i)
+  {
+    EXPECT_EQ(loaded.getBV(i).first_child, built.getBV(i).first_child);
+    EXPECT_TRUE(loaded.getBV(i).getCenter() == built.getBV(i).getCenter());
+  }
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  test::generateRandomTransforms(extents, transforms, 20);
+
+  CollisionRequest<S> request(100000, false);
+  for(const auto& tf : transforms)
+  {
+    CollisionResult<S> result1, result2;
+    EXPECT_EQ(collide(&built, Transform3<S>::Identity(), &rob, tf, request, result1),
+              collide(&loaded, Transform3<S>::Identity(), &rob, tf, request, result2));
+  }
+
+  // A model of another BV type is rejected
+  std::stringstream rob_stream;
+  BVHModel<AABB<S>> aabb_rob;
+  aabb_rob.beginModel();
+  aabb_rob.addSubModel(p2, t2);
+  aabb_rob.endModel();
+  aabb_rob.save(rob_stream);
+  EXPECT_EQ(loaded.load(rob_stream), BVH_ERR_INCORRECT_DATA);
+  EXPECT_EQ(loaded.build_state, BVH_BUILD_STATE_EMPTY);
+
+  // So is a truncated one
+  std::string data = stream.str();
+  std::stringstream truncated(data.substr(0, data.size() / 2));
+  EXPECT_EQ(loaded.load(truncated), BVH_ERR_INCORRECT_DATA);
+  EXPECT_EQ(loaded.getNumBVs(), 0);
+
+  // and one whose indices point out of the model
+  const std::size_t tri_offset = sizeof(detail::BVHModelFileHeader)
+      + sizeof(Vector3<S>) * built.num_vertices;
+  const std::size_t primitive_offset = tri_offset + sizeof(Triangle) * built.num_tris;
+  const std::size_t bv_offset = primitive_offset + sizeof(unsigned int) * built.num_tris;
+  auto loadCorrupted = [&](std::size_t offset, const void* value, std::size_t size)
+  {
+    std::string corrupted = data;
+    corrupted.replace(offset, size, static_cast<const char*>(value), size);
+    std::stringstream corrupted_stream(corrupted);
+    return loaded.load(corrupted_stream);
+  };
+
+  const std::size_t vertex_id = built.num_vertices;
+  EXPECT_EQ(loadCorrupted(tri_offset + sizeof(Triangle) * (built.num_tris - 1),
+                          &vertex_id, sizeof(vertex_id)), BVH_ERR_INCORRECT_DATA);
+  EXPECT_EQ(loaded.getNumBVs(), 0);
+
+  const unsigned int primitive_id = built.num_tris;
+  EXPECT_EQ(loadCorrupted(primitive_offset, &primitive_id, sizeof(primitive_id)),
+            BVH_ERR_INCORRECT_DATA);
+
+  BVNode<BV> root = built.getBV(0);
+  root.first_child = built.getNumBVs() - 1;
+  EXPECT_EQ(loadCorrupted(bv_offset, &root, sizeof(root)), BVH_ERR_INCORRECT_DATA);
+  root.first_child = 0;
+  EXPECT_EQ(loadCorrupted(bv_offset, &root, sizeof(root)), BVH_ERR_INCORRECT_DATA);
+  root = built.getBV(0);
+  root.num_primitives = built.num_tris + 1;
+  EXPECT_EQ(loadCorrupted(bv_offset, &root, sizeof(root)), BVH_ERR_INCORRECT_DATA);
+
+  // The uncorrupted data still loads
+  std::stringstream intact(data);
+  EXPECT_EQ(loaded.load(intact), BVH_OK);
+}
+
+GTEST_TEST(FCL_BVH_MODELS, save_load)
+{
+  testBVHModelSaveLoad<OBBRSS<double>>();
+  testBVHModelSaveLoad<RSS<double>>();
+  testBVHModelSaveLoad<kIOS<double>>();
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
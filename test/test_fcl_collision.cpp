@@ -608,6 +608,102 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test_Oriented<AABB<S>, detail::MeshCollisionTraversalNodeAABB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<AABB<S>, detail::MeshCollisionTraversalNodeAABB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_BV_CENTER, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<AABB<S>, detail::MeshCollisionTraversalNodeAABB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 24>, detail::MeshCollisionTraversalNodeKDOP<S, 24>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 24>, detail::MeshCollisionTraversalNodeKDOP<S, 24>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_BV_CENTER, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 24>, detail::MeshCollisionTraversalNodeKDOP<S, 24>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 18>, detail::MeshCollisionTraversalNodeKDOP<S, 18>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 18>, detail::MeshCollisionTraversalNodeKDOP<S, 18>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_BV_CENTER, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 18>, detail::MeshCollisionTraversalNodeKDOP<S, 18>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 16>, detail::MeshCollisionTraversalNodeKDOP<S, 16>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 16>, detail::MeshCollisionTraversalNodeKDOP<S, 16>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_BV_CENTER, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
+    collide_Test_Oriented<KDOP<S, 16>, detail::MeshCollisionTraversalNodeKDOP<S, 16>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     test_collide_func<RSS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -632,6 +728,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    test_collide_func<KDOP<S, 24>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEDIAN);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
 
     collide_Test<kIOS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
@@ -854,6 +958,223 @@ GTEST_TEST(FCL_COLLISION, mesh_mesh)
   test_mesh_mesh<double>();
 }
 
+template <typename S>
+void test_collide_batch()
+{
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<OBBRSS<S>> m1;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+
+  BVHModel<OBBRSS<S>> m2;
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  Box<S> box(500, 500, 500);
+  Sphere<S> sphere(300);
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 50;
+#else
+  std::size_t n = 5;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  Eigen::aligned_vector<Transform3<S>> identity(1, Transform3<S>::Identity());
+
+  const CollisionGeometry<S>* geometries1[] = {&m1, &box, &sphere};
+  const CollisionGeometry<S>* geometries2[] = {&m2, &sphere, &m2};
+
+  for(GJKSolverType solver_type : {GST_LIBCCD, GST_INDEP})
+  {
+    CollisionRequest<S> request(10, true);
+    request.gjk_solver_type = solver_type;
+
+    for(std::size_t k = 0; k < 3; ++k)
+    {
+      std::vector<CollisionResult<S>> expected(transforms.size());
+      std::size_t expected_collisions = 0;
+      for(std::size_t i = 0; i < transforms.size(); ++i)
+      {
+        if(collide(geometries1[k], Transform3<S>::Identity(), geometries2[k], transforms[i], request, expected[i]) > 0)
+          ++expected_collisions;
+      }
+
+      // The same results vector is passed to both runs so the second one
+      // overwrites the first
+      std::vector<CollisionResult<S>> results;
+      for(unsigned int num_threads : {1u, 3u})
+      {
+        std::size_t num_collisions = collideBatch(geometries1[k], identity, geometries2[k], transforms, request, results, num_threads);
+        EXPECT_EQ(num_collisions, expected_collisions);
+        EXPECT_EQ(results.size(), transforms.size());
+        for(std::size_t i = 0; i < results.size(); ++i)
+          EXPECT_TRUE(test::sameContacts(results[i], expected[i]));
+      }
+    }
+  }
+
+  // Mismatched pose arrays are rejected
+  Eigen::aligned_vector<Transform3<S>> two_poses(2, Transform3<S>::Identity());
+  std::vector<CollisionResult<S>> results;
+  CollisionRequest<S> request;
+  if(transforms.size() != 2)
+  {
+    EXPECT_EQ(collideBatch<S>(&m1, two_poses, &m2, transforms, request, results), 0u);
+    EXPECT_EQ(results.size(), transforms.size());
+  }
+}
+
+GTEST_TEST(FCL_COLLISION, collide_batch)
+{
+  test_collide_batch<double>();
+}
+
+template <typename S>
+void test_triangle_batch()
+{
+  detail::TriangleBatch<S> batch;
+  bool hits[detail::TriangleBatch<S>::kCapacity];
+  std::size_t num_hits = 0;
+
+  for(int k = 0; k < 1000; ++k)
+  {
+    std::vector<Vector3<S>> v(6);
+    for(auto& p : v)
+      p = Vector3<S>(test::rand_interval<S>(-1, 1), test::rand_interval<S>(-1, 1), test::rand_interval<S>(-1, 1));
+
+    batch.push(v[0], v[1], v[2], v[3], v[4], v[5], k, k);
+
+    if(batch.full() || k == 999)
+    {
+      const int size = batch.size();
+      detail::intersectTriangleBatch(batch, hits);
+      for(int i = 0; i < size; ++i)
+      {
+        Vector3<S> t[6];
+        for(int j = 0; j < 3; ++j)
+        {
+          t[j] = Vector3<S>(batch.p[j][0][i], batch.p[j][1][i], batch.p[j][2][i]);
+          t[3 + j] = Vector3<S>(batch.q[j][0][i], batch.q[j][1][i], batch.q[j][2][i]);
+        }
+
+        EXPECT_EQ(hits[i], detail::Intersect<S>::intersect_Triangle(t[0], t[1], t[2], t[3], t[4], t[5]));
+        if(hits[i]) ++num_hits;
+      }
+      batch.clear();
+    }
+  }
+
+  // Random triangles in the same cube should both intersect and miss
+  EXPECT_GT(num_hits, 0u);
+  EXPECT_LT(num_hits, 1000u);
+
+  // Flushing adds the contacts in the order of the pairs, up to the maximum
+  BVHModel<OBBRSS<S>> m1, m2;
+  CollisionRequest<S> request(2, false);
+  CollisionResult<S> result;
+  const Vector3<S> a(0, 0, 0), b(1, 0, 0), c(0, 1, 0);
+  const Vector3<S> d(0.2, 0.2, -1), e(0.2, 0.2, 1), f(2, 2, 0);
+  batch.push(a, b, c, d + Vector3<S>(5, 0, 0), e + Vector3<S>(5, 0, 0), f + Vector3<S>(5, 0, 0), 0, 0);
+  batch.push(a, b, c, d, e, f, 1, 1);
+  batch.push(a, b, c, d, e, f, 2, 2);
+  batch.push(a, b, c, d, e, f, 3, 3);
+  batch.flush(&m1, &m2, request, result);
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(result.numContacts(), 2u);
+  if(result.numContacts() == 2)
+  {
+    EXPECT_EQ(result.getContact(0).b1, 1);
+    EXPECT_EQ(result.getContact(1).b1, 2);
+  }
+}
+
+GTEST_TEST(FCL_COLLISION, triangle_batch)
+{
+  test_triangle_batch<float>();
+  test_triangle_batch<double>();
+}
+
+template <typename NodeType, typename BV>
+void checkCollideNode(const BVHModel<BV>& m1, const BVHModel<BV>& m2,
+                      const Transform3<typename BV::S>& tf,
+                      std::size_t num_max_contacts)
+{
+  using S = typename BV::S;
+
+  // The generic mesh node moves the vertices of the models it is given, the
+  // oriented ones are selected by passing the models as const
+  constexpr bool generic = std::is_same<NodeType, detail::MeshCollisionTraversalNode<BV>>::value;
+  using Model = typename std::conditional<generic, BVHModel<BV>, const BVHModel<BV>>::type;
+  using Pose = typename std::conditional<generic, Transform3<S>, const Transform3<S>>::type;
+
+  BVHModel<BV> m1_virtual_copy(m1), m2_virtual_copy(m2), m1_static_copy(m1), m2_static_copy(m2);
+  Model& m1_virtual = m1_virtual_copy;
+  Model& m2_virtual = m2_virtual_copy;
+  Model& m1_static = m1_static_copy;
+  Model& m2_static = m2_static_copy;
+  Transform3<S> tf1_virtual_copy(tf), tf1_static_copy(tf);
+  Transform3<S> tf2_virtual_copy = Transform3<S>::Identity(), tf2_static_copy = Transform3<S>::Identity();
+  Pose& tf1_virtual = tf1_virtual_copy;
+  Pose& tf2_virtual = tf2_virtual_copy;
+  Pose& tf1_static = tf1_static_copy;
+  Pose& tf2_static = tf2_static_copy;
+  CollisionRequest<S> request(num_max_contacts, false);
+  CollisionResult<S> virtual_result, static_result;
+
+  NodeType virtual_node;
+  detail::initialize(virtual_node, m1_virtual, tf1_virtual, m2_virtual, tf2_virtual, request, virtual_result);
+  virtual_node.enable_statistics = true;
+  detail::collide(&virtual_node);
+
+  NodeType static_node;
+  detail::initialize(static_node, m1_static, tf1_static, m2_static, tf2_static, request, static_result);
+  static_node.enable_statistics = true;
+  detail::collideNode(&static_node);
+
+  // Both traversals must visit the same pairs in the same order
+  EXPECT_EQ(static_node.num_bv_tests, virtual_node.num_bv_tests);
+  EXPECT_EQ(static_node.num_leaf_tests, virtual_node.num_leaf_tests);
+  EXPECT_TRUE(test::sameContacts(static_result, virtual_result));
+}
+
+template <typename NodeType, typename BV>
+void test_collide_node()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> m1;
+  BVHModel<BV> m2;
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateMeshPair(TEST_RESOURCES_DIR"/env.obj", TEST_RESOURCES_DIR"/rob.obj",
+                         m1, m2, transforms);
+
+  for(const auto& tf : transforms)
+  {
+    checkCollideNode<NodeType>(m1, m2, tf, 1);
+    checkCollideNode<NodeType>(m1, m2, tf, 100000);
+  }
+}
+
+GTEST_TEST(FCL_COLLISION, collide_node)
+{
+  test_collide_node<detail::MeshCollisionTraversalNode<AABB<double>>, AABB<double>>();
+  test_collide_node<detail::MeshCollisionTraversalNode<KDOP<double, 16>>, KDOP<double, 16>>();
+  test_collide_node<detail::MeshCollisionTraversalNodeOBB<double>, OBB<double>>();
+  test_collide_node<detail::MeshCollisionTraversalNodeRSS<double>, RSS<double>>();
+  test_collide_node<detail::MeshCollisionTraversalNodekIOS<double>, kIOS<double>>();
+  test_collide_node<detail::MeshCollisionTraversalNodeOBBRSS<double>, OBBRSS<double>>();
+}
+
 template<typename BV>
 bool collide_Test2(const Transform3<typename BV::S>& tf,
                    const std::vector<Vector3<typename BV::S>>& vertices1, const std::vector<Triangle>& triangles1,
@@ -38,6 +38,9 @@
 #include <gtest/gtest.h>
 
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
 #include "test_fcl_utility.h"
 #include "fcl_resources/config.h"
 
@@ -305,6 +308,156 @@ GTEST_TEST(FCL_DISTANCE, mesh_distance)
   test_mesh_distance<double>();
 }
 
+template <typename BV>
+void test_mesh_distance_parallel()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> m1;
+  BVHModel<BV> m2;
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateMeshPair(TEST_RESOURCES_DIR"/env.obj", TEST_RESOURCES_DIR"/rob.obj",
+                         m1, m2, transforms);
+
+  for(const auto& tf : transforms)
+  {
+    DistanceRequest<S> request(true);
+    DistanceResult<S> result;
+    distance(&m1, Transform3<S>::Identity(), &m2, tf, request, result);
+
+    for(unsigned int num_threads : {2u, 4u, 0u})
+    {
+      DistanceRequest<S> parallel_request(true);
+      parallel_request.num_threads = num_threads;
+      DistanceResult<S> parallel_result;
+      distance(&m1, Transform3<S>::Identity(), &m2, tf, parallel_request, parallel_result);
+
+      EXPECT_NEAR(parallel_result.min_distance, result.min_distance, 1e-8);
+      if(result.min_distance > 0)
+      {
+        EXPECT_NEAR((parallel_result.nearest_points[0] - parallel_result.nearest_points[1]).norm(),
+                    result.min_distance, 1e-6);
+      }
+    }
+  }
+}
+
+GTEST_TEST(FCL_DISTANCE, mesh_distance_parallel)
+{
+  test_mesh_distance_parallel<AABB<double>>();
+  test_mesh_distance_parallel<RSS<double>>();
+  test_mesh_distance_parallel<kIOS<double>>();
+  test_mesh_distance_parallel<OBBRSS<double>>();
+}
+
+template <typename NodeType, typename BV>
+void test_distance_node()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> m1;
+  BVHModel<BV> m2;
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateMeshPair(TEST_RESOURCES_DIR"/env.obj", TEST_RESOURCES_DIR"/rob.obj",
+                         m1, m2, transforms);
+
+  for(const auto& tf : transforms)
+  {
+    DistanceRequest<S> request(true);
+    DistanceResult<S> virtual_result, static_result;
+
+    NodeType virtual_node;
+    detail::initialize(virtual_node, m1, Transform3<S>::Identity(), m2, tf, request, virtual_result);
+    virtual_node.enable_statistics = true;
+    detail::distance(&virtual_node);
+
+    NodeType static_node;
+    detail::initialize(static_node, m1, Transform3<S>::Identity(), m2, tf, request, static_result);
+    static_node.enable_statistics = true;
+    detail::distanceNode(&static_node);
+
+    // Both traversals must visit the same pairs in the same order
+    EXPECT_EQ(static_node.num_bv_tests, virtual_node.num_bv_tests);
+    EXPECT_EQ(static_node.num_leaf_tests, virtual_node.num_leaf_tests);
+    EXPECT_EQ(static_result.min_distance, virtual_result.min_distance);
+    EXPECT_EQ(static_result.b1, virtual_result.b1);
+    EXPECT_EQ(static_result.b2, virtual_result.b2);
+  }
+}
+
+GTEST_TEST(FCL_DISTANCE, distance_node)
+{
+  test_distance_node<detail::MeshDistanceTraversalNodeRSS<double>, RSS<double>>();
+  test_distance_node<detail::MeshDistanceTraversalNodekIOS<double>, kIOS<double>>();
+  test_distance_node<detail::MeshDistanceTraversalNodeOBBRSS<double>, OBBRSS<double>>();
+}
+
+template <typename BV>
+void test_mesh_signed_distance()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> m1;
+  BVHModel<BV> m2;
+  generateBVHModel(m1, Sphere<S>(1), Transform3<S>::Identity(), 16, 16);
+  generateBVHModel(m2, Box<S>(1, 1, 1), Transform3<S>::Identity());
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-1.5, -1.5, -1.5, 1.5, 1.5, 1.5};
+#ifdef NDEBUG
+  std::size_t n = 100;
+#else
+  std::size_t n = 10;
+#endif
+
+  test::generateRandomTransforms(extents, transforms, n);
+
+  const Transform3<S> tf1 = Transform3<S>::Identity();
+  for(const auto& tf2 : transforms)
+  {
+    DistanceRequest<S> request;
+    request.enable_signed_distance = true;
+    request.enable_nearest_points = true;
+    DistanceResult<S> result;
+    distance(&m1, tf1, &m2, tf2, request, result);
+
+    // The penetration depth must match the deepest contact of collide()
+    CollisionRequest<S> collision_request(100000, true);
+    CollisionResult<S> collision_result;
+    collide(&m1, tf1, &m2, tf2, collision_request, collision_result);
+
+    if(collision_result.isCollision())
+    {
+      S max_depth = 0;
+      for(std::size_t i = 0; i < collision_result.numContacts(); ++i)
+        max_depth = std::max(max_depth, collision_result.getContact(i).penetration_depth);
+
+      EXPECT_NEAR(result.min_distance, -max_depth, 1e-8);
+      if(max_depth > 0)
+      {
+        EXPECT_TRUE(result.nearest_points[0].isApprox(result.nearest_points[1]));
+      }
+    }
+    else
+    {
+      DistanceRequest<S> unsigned_request;
+      DistanceResult<S> unsigned_result;
+      distance(&m1, tf1, &m2, tf2, unsigned_request, unsigned_result);
+
+      EXPECT_GT(result.min_distance, 0);
+      EXPECT_NEAR(result.min_distance, unsigned_result.min_distance, 1e-8);
+    }
+  }
+}
+
+GTEST_TEST(FCL_DISTANCE, mesh_signed_distance)
+{
+  test_mesh_signed_distance<AABB<double>>();
+  test_mesh_signed_distance<RSS<double>>();
+  test_mesh_signed_distance<kIOS<double>>();
+  test_mesh_signed_distance<OBBRSS<double>>();
+}
+
 template<typename BV, typename TraversalNode>
 void distance_Test_Oriented(const Transform3<typename BV::S>& tf,
                             const std::vector<Vector3<typename BV::S>>& vertices1, const std::vector<Triangle>& triangles1,
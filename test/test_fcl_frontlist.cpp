@@ -38,6 +38,7 @@
 #include <gtest/gtest.h>
 
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
+#include "fcl/narrowphase/detail/gjk_solver_libccd.h"
 #include "test_fcl_utility.h"
 
 #include "fcl_resources/config.h"
@@ -201,6 +202,101 @@ GTEST_TEST(FCL_FRONT_LIST, front_list)
   test_front_list<double>();
 }
 
+template <typename S>
+void test_distance_front_list()
+{
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<OBBRSS<S>> m1;
+  BVHModel<OBBRSS<S>> m2;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  Sphere<S> sphere(200);
+  detail::GJKSolver_libccd<S> solver;
+
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  Eigen::aligned_vector<Transform3<S>> transforms2;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  S delta_trans[] = {10, 10, 10};
+#ifdef NDEBUG
+  std::size_t n = 10;
+#else
+  std::size_t n = 2;
+#endif
+
+  test::generateRandomTransforms<S>(extents, delta_trans, 0.005 * 2 * 3.1415, transforms, transforms2, n);
+
+  const Transform3<S> tf1 = Transform3<S>::Identity();
+  for(std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    // Mesh-mesh distance, with and without the queue
+    for(int qsize : {2, 20})
+    {
+      detail::BVHFrontList front_list;
+      for(const auto& tf2 : {transforms[i], transforms2[i], transforms[i]})
+      {
+        DistanceResult<S> result;
+        detail::MeshDistanceTraversalNodeOBBRSS<S> node;
+        detail::initialize(node, m1, tf1, m2, tf2, DistanceRequest<S>(), result);
+        detail::distance(&node, nullptr, qsize);
+
+        DistanceResult<S> front_result;
+        detail::MeshDistanceTraversalNodeOBBRSS<S> front_node;
+        detail::initialize(front_node, m1, tf1, m2, tf2, DistanceRequest<S>(), front_result);
+        detail::distance(&front_node, &front_list, qsize);
+
+        EXPECT_NEAR(front_result.min_distance, result.min_distance, 1e-8);
+        EXPECT_FALSE(front_list.empty());
+      }
+    }
+
+    // Mesh-shape distance and collision
+    detail::BVHFrontList distance_front_list;
+    detail::BVHFrontList collision_front_list;
+    for(const auto& tf2 : {transforms[i], transforms2[i], transforms[i]})
+    {
+      DistanceResult<S> result;
+      detail::MeshShapeDistanceTraversalNodeOBBRSS<Sphere<S>, detail::GJKSolver_libccd<S>> node;
+      detail::initialize(node, m1, tf1, sphere, tf2, &solver, DistanceRequest<S>(), result);
+      detail::distance(&node);
+
+      DistanceResult<S> front_result;
+      detail::MeshShapeDistanceTraversalNodeOBBRSS<Sphere<S>, detail::GJKSolver_libccd<S>> front_node;
+      detail::initialize(front_node, m1, tf1, sphere, tf2, &solver, DistanceRequest<S>(), front_result);
+      detail::distance(&front_node, &distance_front_list);
+
+      EXPECT_NEAR(front_result.min_distance, result.min_distance, 1e-6);
+
+      CollisionRequest<S> request(std::numeric_limits<int>::max(), false);
+      CollisionResult<S> collision_result;
+      detail::MeshShapeCollisionTraversalNodeOBBRSS<Sphere<S>, detail::GJKSolver_libccd<S>> collision_node;
+      detail::initialize(collision_node, m1, tf1, sphere, tf2, &solver, request, collision_result);
+      detail::collide(&collision_node);
+
+      CollisionResult<S> front_collision_result;
+      detail::MeshShapeCollisionTraversalNodeOBBRSS<Sphere<S>, detail::GJKSolver_libccd<S>> front_collision_node;
+      detail::initialize(front_collision_node, m1, tf1, sphere, tf2, &solver, request, front_collision_result);
+      detail::collide(&front_collision_node, &collision_front_list);
+
+      EXPECT_EQ(front_collision_result.numContacts(), collision_result.numContacts());
+    }
+  }
+}
+
+GTEST_TEST(FCL_FRONT_LIST, distance_front_list)
+{
+  test_distance_front_list<double>();
+}
+
 template<typename BV>
 bool collide_front_list_Test(const Transform3<typename BV::S>& tf1, const Transform3<typename BV::S>& tf2,
                              const std::vector<Vector3<typename BV::S>>& vertices1, const std::vector<Triangle>& triangles1,
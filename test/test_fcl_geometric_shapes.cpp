@@ -54,6 +54,7 @@
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
 #include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/continuous_collision.h"
 
 #include "test_fcl_utility.h"
 
@@ -174,6 +175,226 @@ GTEST_TEST(FCL_GEOMETRIC_SHAPES, gjkcache)
   test_gjkcache<double>();
 }
 
+template <typename S>
+void test_ccd_ray_shooting_pair(
+    const CollisionGeometry<S>* o1, const Transform3<S>& tf1_beg, const Transform3<S>& tf1_end,
+    const CollisionGeometry<S>* o2, const Transform3<S>& tf2_beg, const Transform3<S>& tf2_end)
+{
+  ContinuousCollisionRequest<S> request(1000, 0.001, CCDM_TRANS, GST_INDEP, CCDC_RAY_SHOOTING);
+  ContinuousCollisionResult<S> result;
+  continuousCollide(o1, tf1_beg, tf1_end, o2, tf2_beg, tf2_end, request, result);
+
+  ContinuousCollisionRequest<S> naive_request(1000, 0.001, CCDM_TRANS, GST_INDEP, CCDC_NAIVE);
+  ContinuousCollisionResult<S> naive_result;
+  continuousCollide(o1, tf1_beg, tf1_end, o2, tf2_beg, tf2_end, naive_request, naive_result);
+
+  // The naive solver samples the motion every 1/999 and may miss grazing
+  // contacts, in which case the objects must be touching at the reported time
+  if(naive_result.is_collide)
+  {
+    EXPECT_TRUE(result.is_collide);
+    EXPECT_LE(result.time_of_contact, naive_result.time_of_contact + 1e-6);
+    EXPECT_GE(result.time_of_contact, naive_result.time_of_contact - 1.0 / 999 - 1e-6);
+  }
+
+  // the objects overlap shortly after the reported time of contact
+  if(result.is_collide)
+  {
+    const Vector3<S> dv = (tf2_end.translation() - tf2_beg.translation())
+        - (tf1_end.translation() - tf1_beg.translation());
+    Transform3<S> tf2 = result.contact_tf2;
+    tf2.translation() += dv * 0.002;
+
+    CollisionRequest<S> c_request;
+    c_request.gjk_solver_type = GST_INDEP;
+    CollisionResult<S> c_result;
+    collide(o1, result.contact_tf1, o2, tf2, c_request, c_result);
+    EXPECT_TRUE(c_result.isCollision());
+  }
+}
+
+template <typename S>
+void test_ccd_ray_shooting()
+{
+  // sphere moving towards a static sphere, touching when the centers are 3 apart
+  Sphere<S> s1(1);
+  Sphere<S> s2(2);
+  Transform3<S> tf1_beg = Transform3<S>::Identity();
+  Transform3<S> tf1_end = Transform3<S>::Identity();
+  tf1_beg.translation() = Vector3<S>(-10, 0, 0);
+  tf1_end.translation() = Vector3<S>(10, 0, 0);
+
+  ContinuousCollisionRequest<S> request(10, 0.0001, CCDM_TRANS, GST_INDEP, CCDC_RAY_SHOOTING);
+  ContinuousCollisionResult<S> result;
+  continuousCollide(&s1, tf1_beg, tf1_end, &s2, Transform3<S>::Identity(), Transform3<S>::Identity(), request, result);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_NEAR(result.time_of_contact, 0.35, 1e-6);
+  EXPECT_TRUE(result.contact_normal.isApprox(Vector3<S>(1, 0, 0), 1e-6));
+  EXPECT_NEAR(result.contact_tf1.translation()[0], -3, 1e-5);
+
+  // moving away
+  tf1_beg.translation() = Vector3<S>(5, 0, 0);
+  tf1_end.translation() = Vector3<S>(15, 0, 0);
+  continuousCollide(&s1, tf1_beg, tf1_end, &s2, Transform3<S>::Identity(), Transform3<S>::Identity(), request, result);
+  EXPECT_FALSE(result.is_collide);
+  EXPECT_EQ(result.time_of_contact, 1);
+
+  // sphere falling onto a halfspace, touching at z = 1
+  Halfspace<S> hs(Vector3<S>(0, 0, 1), 0);
+  tf1_beg.translation() = Vector3<S>(0, 0, 5);
+  tf1_end.translation() = Vector3<S>(0, 0, -5);
+  continuousCollide(&hs, Transform3<S>::Identity(), Transform3<S>::Identity(), &s1, tf1_beg, tf1_end, request, result);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_NEAR(result.time_of_contact, 0.4, 1e-6);
+  EXPECT_TRUE(result.contact_normal.isApprox(Vector3<S>(0, 0, 1), 1e-6));
+
+  // random sweeps of all the pairs of convex primitives
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> shapes;
+  shapes.emplace_back(new Box<S>(2, 3, 1));
+  shapes.emplace_back(new Sphere<S>(1.5));
+  shapes.emplace_back(new Ellipsoid<S>(1, 2, 1.5));
+  shapes.emplace_back(new Capsule<S>(1, 2));
+  shapes.emplace_back(new Cone<S>(1, 2));
+  shapes.emplace_back(new Cylinder<S>(1, 2));
+
+  Eigen::aligned_vector<Transform3<S>> tf_begs;
+  Eigen::aligned_vector<Transform3<S>> tf_ends;
+  S extents[] = {-5, -5, -5, 5, 5, 5};
+  test::generateRandomTransforms(extents, tf_begs, 50);
+  test::generateRandomTransforms(extents, tf_ends, 50);
+
+  for(std::size_t i = 0; i < shapes.size(); ++i)
+  {
+    for(std::size_t j = 0; j < shapes.size(); ++j)
+    {
+      for(std::size_t k = 0; k + 1 < tf_begs.size(); k += 2)
+      {
+        // TranslationMotion keeps the rotation of the start transform
+        Transform3<S> tf1_end_k = tf_begs[k];
+        tf1_end_k.translation() = tf_ends[k].translation();
+        Transform3<S> tf2_end_k = tf_begs[k + 1];
+        tf2_end_k.translation() = tf_ends[k + 1].translation();
+        test_ccd_ray_shooting_pair(shapes[i].get(), tf_begs[k], tf1_end_k,
+                                   shapes[j].get(), tf_begs[k + 1], tf2_end_k);
+      }
+    }
+  }
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, ccd_ray_shooting)
+{
+  test_ccd_ray_shooting<double>();
+}
+
+template <typename S>
+void test_ccd_adaptive_naive()
+{
+  // sphere moving towards a static sphere, touching when the centers are 3 apart
+  Sphere<S> s1(1);
+  Sphere<S> s2(2);
+  s1.computeLocalAABB();
+  s2.computeLocalAABB();
+  Transform3<S> tf1_beg = Transform3<S>::Identity();
+  Transform3<S> tf1_end = Transform3<S>::Identity();
+  tf1_beg.translation() = Vector3<S>(-10, 0, 0);
+  tf1_end.translation() = Vector3<S>(10, 0, 0);
+
+  // the contact is refined below the sampling step of 1/9
+  ContinuousCollisionRequest<S> request(10, 0.0001, CCDM_TRANS, GST_INDEP, CCDC_NAIVE, true);
+  ContinuousCollisionResult<S> result;
+  continuousCollide(&s1, tf1_beg, tf1_end, &s2, Transform3<S>::Identity(), Transform3<S>::Identity(), request, result);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_GE(result.time_of_contact, 0.35 - 1e-6);
+  EXPECT_LE(result.time_of_contact, 0.35 + 0.0001);
+
+  // far fewer queries than the uniform sampling at the same resolution
+  ContinuousCollisionRequest<S> fine_naive_request(1000, 0.001, CCDM_TRANS, GST_INDEP, CCDC_NAIVE);
+  ContinuousCollisionRequest<S> fine_adaptive_request(1000, 0.001, CCDM_TRANS, GST_INDEP, CCDC_NAIVE, true);
+  ContinuousCollisionResult<S> fine_naive_result;
+  ContinuousCollisionResult<S> fine_adaptive_result;
+  continuousCollide(&s1, tf1_beg, tf1_end, &s2, Transform3<S>::Identity(), Transform3<S>::Identity(), fine_naive_request, fine_naive_result);
+  continuousCollide(&s1, tf1_beg, tf1_end, &s2, Transform3<S>::Identity(), Transform3<S>::Identity(), fine_adaptive_request, fine_adaptive_result);
+  EXPECT_TRUE(fine_adaptive_result.is_collide);
+  EXPECT_NEAR(fine_adaptive_result.time_of_contact, fine_naive_result.time_of_contact, 2.0 / 999);
+  EXPECT_LT(fine_adaptive_result.num_queries * 10, fine_naive_result.num_queries);
+
+  // the same contacts as the uniform sampling, for all the motion types
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> shapes;
+  shapes.emplace_back(new Box<S>(2, 3, 1));
+  shapes.emplace_back(new Sphere<S>(1.5));
+  shapes.emplace_back(new Ellipsoid<S>(1, 2, 1.5));
+  shapes.emplace_back(new Capsule<S>(1, 2));
+  shapes.emplace_back(new Cone<S>(1, 2));
+  shapes.emplace_back(new Cylinder<S>(1, 2));
+  for(std::size_t i = 0; i < shapes.size(); ++i)
+    shapes[i]->computeLocalAABB();
+
+  Eigen::aligned_vector<Transform3<S>> tf_begs;
+  Eigen::aligned_vector<Transform3<S>> tf_ends;
+  S extents[] = {-5, -5, -5, 5, 5, 5};
+  test::generateRandomTransforms(extents, tf_begs, 20);
+  test::generateRandomTransforms(extents, tf_ends, 20);
+
+  const CCDMotionType motion_types[] = {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW, CCDM_SPLINE};
+  for(CCDMotionType motion_type : motion_types)
+  {
+    ContinuousCollisionRequest<S> adaptive_request(1000, 0.001, motion_type, GST_INDEP, CCDC_NAIVE, true);
+    ContinuousCollisionRequest<S> naive_request(1000, 0.001, motion_type, GST_INDEP, CCDC_NAIVE);
+
+    for(std::size_t i = 0; i < shapes.size(); ++i)
+    {
+      for(std::size_t j = 0; j < shapes.size(); ++j)
+      {
+        for(std::size_t k = 0; k + 1 < tf_begs.size(); k += 2)
+        {
+          ContinuousCollisionResult<S> adaptive_result;
+          continuousCollide(shapes[i].get(), tf_begs[k], tf_ends[k],
+                            shapes[j].get(), tf_begs[k + 1], tf_ends[k + 1],
+                            adaptive_request, adaptive_result);
+
+          ContinuousCollisionResult<S> naive_result;
+          continuousCollide(shapes[i].get(), tf_begs[k], tf_ends[k],
+                            shapes[j].get(), tf_begs[k + 1], tf_ends[k + 1],
+                            naive_request, naive_result);
+
+          EXPECT_EQ(adaptive_result.is_collide, naive_result.is_collide);
+          EXPECT_NEAR(adaptive_result.time_of_contact, naive_result.time_of_contact, 2.0 / 999);
+        }
+      }
+    }
+  }
+
+  // small sphere accelerating along a spline through a thin box; the bound of
+  // a spline motion only holds for the displacement over the remaining time
+  Sphere<S> small_sphere(0.05);
+  Box<S> thin_box(0.1, 10, 10);
+  small_sphere.computeLocalAABB();
+  thin_box.computeLocalAABB();
+  const Vector3<S> zero = Vector3<S>::Zero();
+  SplineMotion<S> spline(Vector3<S>(-10, 0, 0), Vector3<S>(-10, 0, 0),
+                         Vector3<S>(-10, 0, 0), Vector3<S>(30, 0, 0),
+                         zero, zero, zero, zero);
+  // the sphere is at x = -10 + 20 / 3 * t^3, it crosses the box at t ~ 0.77
+  const Vector3<S> box_center(-7, 0, 0);
+  SplineMotion<S> fixed(box_center, box_center, box_center, box_center, zero, zero, zero, zero);
+
+  ContinuousCollisionRequest<S> spline_naive_request(1000, 0.001, CCDM_SPLINE, GST_INDEP, CCDC_NAIVE);
+  ContinuousCollisionResult<S> spline_naive_result;
+  continuousCollide(&small_sphere, &spline, &thin_box, &fixed, spline_naive_request, spline_naive_result);
+  EXPECT_TRUE(spline_naive_result.is_collide);
+
+  ContinuousCollisionRequest<S> spline_adaptive_request(1000, 0.001, CCDM_SPLINE, GST_INDEP, CCDC_NAIVE, true);
+  ContinuousCollisionResult<S> spline_adaptive_result;
+  continuousCollide(&small_sphere, &spline, &thin_box, &fixed, spline_adaptive_request, spline_adaptive_result);
+  EXPECT_TRUE(spline_adaptive_result.is_collide);
+  EXPECT_NEAR(spline_adaptive_result.time_of_contact, spline_naive_result.time_of_contact, 2.0 / 999);
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, ccd_adaptive_naive)
+{
+  test_ccd_adaptive_naive<double>();
+}
+
 template <typename Shape1, typename Shape2>
 void printComparisonError(const std::string& comparison_type,
                           const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
@@ -5274,6 +5495,145 @@ GTEST_TEST(FCL_GEOMETRIC_SHAPES, reversibleShapeDistance_allshapes)
   test_reversibleShapeDistance_allshapes<double>();
 }
 
+template <typename S>
+void test_libccd_pooled_allocation()
+{
+  Cylinder<S> s1(5, 10);
+  Box<S> s2(10, 10, 10);
+
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() = Vector3<S>(3, 1, 0);
+
+  S dist;
+  Vector3<S> p1, p2;
+
+  // The first queries warm up the pools of this thread; signed distance
+  // reports false for penetrating shapes
+  EXPECT_FALSE(solver1<S>().shapeSignedDistance(s1, tf1, s2, tf2, &dist, &p1, &p2));
+  EXPECT_TRUE(dist < 0);
+  EXPECT_TRUE(solver1<S>().shapeIntersect(s1, tf1, s2, tf2, nullptr));
+
+  const auto& cyl_pool = detail::ObjectPool<detail::ccd_cyl_t>::threadLocal();
+  const auto& box_pool = detail::ObjectPool<detail::ccd_box_t>::threadLocal();
+  const auto& vertex_pool = detail::ObjectPool<ccd_pt_vertex_t>::threadLocal();
+  const auto& edge_pool = detail::ObjectPool<ccd_pt_edge_t>::threadLocal();
+  const auto& face_pool = detail::ObjectPool<ccd_pt_face_t>::threadLocal();
+
+  const std::size_t num_cyls = cyl_pool.numAllocated();
+  const std::size_t num_boxes = box_pool.numAllocated();
+  const std::size_t num_vertices = vertex_pool.numAllocated();
+  const std::size_t num_edges = edge_pool.numAllocated();
+  const std::size_t num_faces = face_pool.numAllocated();
+  EXPECT_TRUE(num_vertices > 0);
+
+  for(int i = 0; i < 100; ++i)
+  {
+    S dist_i;
+    EXPECT_FALSE(solver1<S>().shapeSignedDistance(s1, tf1, s2, tf2, &dist_i, &p1, &p2));
+    EXPECT_EQ(dist_i, dist);
+    EXPECT_TRUE(solver1<S>().shapeIntersect(s1, tf1, s2, tf2, nullptr));
+  }
+
+  // Steady-state queries reuse the pooled objects and return all of them
+  EXPECT_EQ(cyl_pool.numAllocated(), num_cyls);
+  EXPECT_EQ(box_pool.numAllocated(), num_boxes);
+  EXPECT_EQ(vertex_pool.numAllocated(), num_vertices);
+  EXPECT_EQ(edge_pool.numAllocated(), num_edges);
+  EXPECT_EQ(face_pool.numAllocated(), num_faces);
+  EXPECT_EQ(cyl_pool.numFree(), num_cyls);
+  EXPECT_EQ(vertex_pool.numFree(), num_vertices);
+  EXPECT_EQ(face_pool.numFree(), num_faces);
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, libccd_pooled_allocation)
+{
+  test_libccd_pooled_allocation<double>();
+}
+
+template <typename S, typename Shape0, typename Shape1>
+void test_minkowskiDiffSupport(const Shape0& s0, const Shape1& s1)
+{
+  Transform3<S> tf0 = Transform3<S>::Identity();
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  test::generateRandomTransform(extents<S>(), tf0);
+  test::generateRandomTransform(extents<S>(), tf1);
+
+  detail::MinkowskiDiff<S> generic;
+  generic.shapes[0] = &s0;
+  generic.shapes[1] = &s1;
+  generic.toshape1.noalias() = tf1.linear().transpose() * tf0.linear();
+  generic.toshape0 = tf0.inverse(Eigen::Isometry) * tf1;
+
+  detail::MinkowskiDiff<S> typed;
+  typed.set(&s0, &s1);
+  typed.toshape1 = generic.toshape1;
+  typed.toshape0 = generic.toshape0;
+
+  const std::size_t num_dirs = 1000;
+  std::vector<Vector3<S>> dirs(num_dirs);
+  for(auto& dir : dirs)
+  {
+    dir = Vector3<S>::Random();
+    if(dir.squaredNorm() == 0) dir = Vector3<S>::UnitX();
+    dir.normalize();
+  }
+
+  for(const auto& dir : dirs)
+  {
+    EXPECT_TRUE(typed.support(dir).isApprox(generic.support(dir)));
+    EXPECT_TRUE(typed.support(dir, 0).isApprox(generic.support(dir, 0)));
+    EXPECT_TRUE(typed.support(dir, 1).isApprox(generic.support(dir, 1)));
+  }
+
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, minkowskiDiffSupport)
+{
+  Sphere<double> sphere(1);
+  Box<double> box(1, 2, 3);
+  Capsule<double> capsule(1, 2);
+  Cylinder<double> cylinder(1, 2);
+  Cone<double> cone(1, 2);
+  Ellipsoid<double> ellipsoid(1, 2, 3);
+
+  // A convex box of 1 x 2 x 3; Convex does not own its arrays
+  Vector3<double> points[8];
+  for(int i = 0; i < 8; ++i)
+    points[i] = Vector3<double>((i & 1) ? 0.5 : -0.5, (i & 2) ? 1 : -1, (i & 4) ? 1.5 : -1.5);
+  Vector3<double> normals[6] = {-Vector3<double>::UnitX(), Vector3<double>::UnitX(),
+                                -Vector3<double>::UnitY(), Vector3<double>::UnitY(),
+                                -Vector3<double>::UnitZ(), Vector3<double>::UnitZ()};
+  double dis[6] = {0.5, 0.5, 1, 1, 1.5, 1.5};
+  int polygons[30] = {4, 0, 4, 6, 2,  4, 1, 3, 7, 5,  4, 0, 1, 5, 4,
+                      4, 2, 6, 7, 3,  4, 0, 2, 3, 1,  4, 4, 5, 7, 6};
+  Convex<double> convex(normals, dis, 6, points, 8, polygons);
+
+  test_minkowskiDiffSupport<double>(sphere, sphere);
+  test_minkowskiDiffSupport<double>(sphere, box);
+  test_minkowskiDiffSupport<double>(box, box);
+  test_minkowskiDiffSupport<double>(capsule, box);
+  test_minkowskiDiffSupport<double>(capsule, capsule);
+  test_minkowskiDiffSupport<double>(cylinder, box);
+  test_minkowskiDiffSupport<double>(cylinder, cylinder);
+  test_minkowskiDiffSupport<double>(cone, ellipsoid);
+  test_minkowskiDiffSupport<double>(convex, box);
+  test_minkowskiDiffSupport<double>(convex, convex);
+
+  // The convex box has the support points of the box
+  Convex<double> convex_copy(convex);
+  for(int i = 0; i < 8; ++i)
+  {
+    const Vector3<double> dir = points[i] + Vector3<double>(0.01, 0.02, 0.03);
+    EXPECT_TRUE(detail::getShapeSupport(&convex, dir).isApprox(
+                  detail::getShapeSupport(&box, dir)));
+    EXPECT_TRUE(detail::getShapeSupport(&convex_copy, dir).isApprox(
+                  detail::getShapeSupport(&box, dir)));
+  }
+  EXPECT_EQ(convex_copy.num_points, 8);
+  EXPECT_TRUE(convex_copy.center.isApprox(Vector3<double>::Zero()));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,436 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/config.h"
+#include "fcl/geometry/octree/octree.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+/// @brief Build an octree from random points and check that its occupied
+/// leaves cover exactly the voxels of the points
+template <typename S>
+void octree_points_test(S resolution, std::size_t num_points);
+
+/// @brief Collision and distance between an octree built from points and
+/// shapes, compared with the boxes of its occupied leaves
+template <typename S>
+void octree_shape_test(S resolution, std::size_t num_points, std::size_t num_queries);
+
+/// @brief Collision between octrees and between an octree and a mesh, compared
+/// with the boxes of the occupied leaves
+template <typename S>
+void octree_octree_mesh_test(S resolution, std::size_t num_points, std::size_t num_queries);
+
+/// @brief Signed distance between an octree and shapes, meshes and octrees,
+/// compared with the deepest contact reported by collide()
+template <typename S>
+void octree_signed_distance_test(S resolution, std::size_t num_points, std::size_t num_queries);
+
+/// @brief Signed distance between an octree and shapes that touch one of its
+/// cells or reach deep into a block of cells
+template <typename S>
+void octree_signed_distance_contact_test(S resolution);
+
+GTEST_TEST(FCL_OCTREE, test_octree_points)
+{
+  octree_points_test<double>(0.1, 1000);
+  octree_points_test<double>(0.05, 10000);
+}
+
+GTEST_TEST(FCL_OCTREE, test_octree_shape)
+{
+#ifdef NDEBUG
+  octree_shape_test<double>(0.1, 1000, 100);
+#else
+  octree_shape_test<double>(0.1, 100, 20);
+#endif
+}
+
+GTEST_TEST(FCL_OCTREE, test_octree_octree_mesh)
+{
+#ifdef NDEBUG
+  octree_octree_mesh_test<double>(0.1, 300, 50);
+#else
+  octree_octree_mesh_test<double>(0.1, 50, 10);
+#endif
+}
+
+GTEST_TEST(FCL_OCTREE, test_octree_signed_distance)
+{
+#ifdef NDEBUG
+  octree_signed_distance_test<double>(0.1, 300, 50);
+#else
+  octree_signed_distance_test<double>(0.1, 50, 10);
+#endif
+  octree_signed_distance_contact_test<double>(0.1);
+}
+
+//==============================================================================
+template <typename S>
+void generateOctreePoints(std::vector<Vector3<S>>& points, S resolution, std::size_t num_points)
+{
+  // Random points, some of them falling in the same voxel
+  S extents[] = {-1, 1, -1, 1, -1, 1};
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, num_points);
+  for(const auto& tf : transforms)
+  {
+    points.push_back(tf.translation());
+    points.push_back(tf.translation() + Vector3<S>::Constant(resolution / 100));
+  }
+
+  // A block of 4 x 4 x 4 voxels aligned with the tree, merged into one leaf
+  for(int x = 0; x < 4; ++x)
+    for(int y = 0; y < 4; ++y)
+      for(int z = 0; z < 4; ++z)
+        points.push_back(Vector3<S>(x + 8.5, y + 8.5, z + 8.5) * resolution);
+}
+
+//==============================================================================
+template <typename S>
+void octree_points_test(S resolution, std::size_t num_points)
+{
+  std::vector<Vector3<S>> points;
+  generateOctreePoints(points, resolution, num_points);
+
+  OcTree<S> empty_tree(resolution);
+  EXPECT_TRUE(empty_tree.getRoot() == nullptr);
+  EXPECT_EQ(empty_tree.size(), 0u);
+  EXPECT_TRUE(empty_tree.toBoxes().empty());
+
+  OcTree<S> tree(resolution, points);
+  EXPECT_EQ(tree.getTreeDepth(), 16u);
+  EXPECT_EQ(tree.getResolution(), resolution);
+  EXPECT_TRUE(tree.getRoot() != nullptr);
+  if(!tree.getRoot()) return;
+  EXPECT_TRUE(tree.isNodeOccupied(tree.getRoot()));
+
+  std::set<std::array<long, 3>> voxels;
+  for(const auto& point : points)
+  {
+    voxels.insert({{(long)std::floor(point[0] / resolution),
+                    (long)std::floor(point[1] / resolution),
+                    (long)std::floor(point[2] / resolution)}});
+  }
+
+  const std::vector<std::array<S, 6>> boxes = tree.toBoxes();
+  EXPECT_LT(boxes.size(), voxels.size());
+
+  S volume = 0;
+  bool has_merged_leaf = false;
+  for(const auto& box : boxes)
+  {
+    volume += box[3] * box[3] * box[3];
+    EXPECT_EQ(box[4], S(1));
+    EXPECT_EQ(box[5], tree.getOccupancyThres());
+    if(box[3] > 1.5 * resolution)
+      has_merged_leaf = true;
+  }
+  EXPECT_NEAR(volume, voxels.size() * resolution * resolution * resolution, 1e-6);
+  EXPECT_TRUE(has_merged_leaf);
+
+  for(const auto& point : points)
+  {
+    bool inside = false;
+    for(const auto& box : boxes)
+    {
+      inside = inside || ((point - Vector3<S>(box[0], box[1], box[2])).cwiseAbs().maxCoeff() <= box[3] / 2);
+    }
+    EXPECT_TRUE(inside);
+  }
+
+  // Every inner node is as occupied as its most occupied child
+  for(std::size_t i = 0; i < tree.size(); ++i)
+  {
+    const typename OcTree<S>::OcTreeNode* node = tree.getRoot() + i;
+    if(!tree.nodeHasChildren(node)) continue;
+
+    S max_occupancy = 0;
+    for(unsigned int j = 0; j < 8; ++j)
+    {
+      if(tree.nodeChildExists(node, j))
+      {
+        const typename OcTree<S>::OcTreeNode* child = tree.getNodeChild(node, j);
+        EXPECT_TRUE(child > node);
+        max_occupancy = std::max(max_occupancy, child->getOccupancy());
+      }
+    }
+    EXPECT_EQ(node->getOccupancy(), max_occupancy);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void octree_shape_test(S resolution, std::size_t num_points, std::size_t num_queries)
+{
+  std::vector<Vector3<S>> points;
+  generateOctreePoints(points, resolution, num_points);
+
+  auto tree = std::make_shared<OcTree<S>>(resolution, points);
+  CollisionObject<S> tree_obj(tree);
+
+  std::vector<CollisionObject<S>*> boxes;
+  test::generateBoxesFromOctomap(boxes, *tree);
+
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> shapes;
+  shapes.push_back(std::make_shared<Sphere<S>>(0.2));
+  shapes.push_back(std::make_shared<Box<S>>(0.3, 0.2, 0.1));
+
+  S extents[] = {-1.5, 1.5, -1.5, 1.5, -1.5, 1.5};
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, num_queries);
+
+  for(const auto& shape : shapes)
+  {
+    for(const auto& tf : transforms)
+    {
+      CollisionObject<S> shape_obj(shape, tf);
+
+      CollisionRequest<S> request;
+      CollisionResult<S> result;
+      collide(&tree_obj, &shape_obj, request, result);
+
+      bool box_collide = false;
+      for(auto box : boxes)
+      {
+        CollisionResult<S> box_result;
+        box_collide = box_collide || (collide(box, &shape_obj, request, box_result) > 0);
+      }
+      EXPECT_EQ(result.isCollision(), box_collide);
+
+      // The contact identifies the colliding leaf by its index in the tree
+      if(result.isCollision())
+      {
+        const int leaf = result.getContact(0).b1;
+        EXPECT_TRUE(leaf >= 0 && (std::size_t)leaf < tree->size());
+        EXPECT_FALSE(tree->nodeHasChildren(tree->getRoot() + leaf));
+        continue;
+      }
+
+      DistanceRequest<S> distance_request;
+      DistanceResult<S> distance_result;
+      distance(&tree_obj, &shape_obj, distance_request, distance_result);
+
+      S min_dist = std::numeric_limits<S>::max();
+      for(auto box : boxes)
+      {
+        DistanceResult<S> box_result;
+        min_dist = std::min(min_dist, distance(box, &shape_obj, distance_request, box_result));
+      }
+      EXPECT_NEAR(distance_result.min_distance, min_dist, 1e-6);
+    }
+  }
+
+  for(auto box : boxes)
+    delete box;
+}
+
+//==============================================================================
+template <typename S>
+void octree_octree_mesh_test(S resolution, std::size_t num_points, std::size_t num_queries)
+{
+  std::vector<Vector3<S>> points1;
+  generateOctreePoints(points1, resolution, num_points);
+  std::vector<Vector3<S>> points2;
+  generateOctreePoints(points2, resolution, num_points);
+
+  auto tree1 = std::make_shared<OcTree<S>>(resolution, points1);
+  auto tree2 = std::make_shared<OcTree<S>>(resolution, points2);
+
+  std::vector<CollisionObject<S>*> boxes1;
+  test::generateBoxesFromOctomap(boxes1, *tree1);
+  std::vector<CollisionObject<S>*> boxes2;
+  test::generateBoxesFromOctomap(boxes2, *tree2);
+
+  auto mesh = std::make_shared<BVHModel<OBBRSS<S>>>();
+  generateBVHModel(*mesh, Box<S>(0.5, 0.3, 0.2), Transform3<S>::Identity());
+
+  S extents[] = {-1.5, 1.5, -1.5, 1.5, -1.5, 1.5};
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, num_queries);
+
+  CollisionRequest<S> request;
+  CollisionObject<S> tree1_obj(tree1);
+  for(const auto& tf : transforms)
+  {
+    // Octree against octree
+    CollisionObject<S> tree2_obj(tree2, tf);
+    CollisionResult<S> result;
+    collide(&tree1_obj, &tree2_obj, request, result);
+
+    bool box_collide = false;
+    for(auto box2 : boxes2)
+    {
+      const Transform3<S> box2_tf = box2->getTransform();
+      box2->setTransform(tf * box2_tf);
+      box2->computeAABB();
+      for(auto box1 : boxes1)
+      {
+        CollisionResult<S> box_result;
+        box_collide = box_collide || (collide(box1, box2, request, box_result) > 0);
+      }
+      box2->setTransform(box2_tf);
+      box2->computeAABB();
+    }
+    EXPECT_EQ(result.isCollision(), box_collide);
+
+    // Octree against mesh
+    CollisionObject<S> mesh_obj(mesh, tf);
+    CollisionResult<S> mesh_result;
+    collide(&tree1_obj, &mesh_obj, request, mesh_result);
+
+    bool mesh_box_collide = false;
+    for(auto box1 : boxes1)
+    {
+      CollisionResult<S> box_result;
+      mesh_box_collide = mesh_box_collide || (collide(box1, &mesh_obj, request, box_result) > 0);
+    }
+    EXPECT_EQ(mesh_result.isCollision(), mesh_box_collide);
+  }
+
+  for(auto box : boxes1)
+    delete box;
+  for(auto box : boxes2)
+    delete box;
+}
+
+//==============================================================================
+template <typename S>
+void checkSignedDistance(const CollisionObject<S>* o1, const CollisionObject<S>* o2)
+{
+  DistanceRequest<S> request;
+  request.enable_signed_distance = true;
+  request.enable_nearest_points = true;
+  DistanceResult<S> result;
+  distance(o1, o2, request, result);
+
+  CollisionRequest<S> collision_request(100000, true);
+  CollisionResult<S> collision_result;
+  collide(o1, o2, collision_request, collision_result);
+
+  if(!collision_result.isCollision())
+  {
+    EXPECT_GE(result.min_distance, 0);
+    return;
+  }
+
+  S max_depth = 0;
+  for(std::size_t i = 0; i < collision_result.numContacts(); ++i)
+    max_depth = std::max(max_depth, collision_result.getContact(i).penetration_depth);
+
+  EXPECT_NEAR(result.min_distance, -max_depth, 1e-6);
+}
+
+//==============================================================================
+template <typename S>
+void octree_signed_distance_test(S resolution, std::size_t num_points, std::size_t num_queries)
+{
+  std::vector<Vector3<S>> points1;
+  generateOctreePoints(points1, resolution, num_points);
+  std::vector<Vector3<S>> points2;
+  generateOctreePoints(points2, resolution, num_points);
+
+  auto tree1 = std::make_shared<OcTree<S>>(resolution, points1);
+  auto tree2 = std::make_shared<OcTree<S>>(resolution, points2);
+
+  auto sphere = std::make_shared<Sphere<S>>(0.3);
+  auto mesh = std::make_shared<BVHModel<OBBRSS<S>>>();
+  generateBVHModel(*mesh, Box<S>(0.5, 0.3, 0.2), Transform3<S>::Identity());
+
+  S extents[] = {-1.5, 1.5, -1.5, 1.5, -1.5, 1.5};
+  Eigen::aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, num_queries);
+
+  CollisionObject<S> tree1_obj(tree1);
+  for(const auto& tf : transforms)
+  {
+    CollisionObject<S> sphere_obj(sphere, tf);
+    checkSignedDistance(&tree1_obj, &sphere_obj);
+
+    CollisionObject<S> mesh_obj(mesh, tf);
+    checkSignedDistance(&tree1_obj, &mesh_obj);
+
+    CollisionObject<S> tree2_obj(tree2, tf);
+    checkSignedDistance(&tree1_obj, &tree2_obj);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void octree_signed_distance_contact_test(S resolution)
+{
+  // One cell spanning [0, resolution] on each axis, touched on its -z face
+  std::vector<Vector3<S>> cell_points(1, Vector3<S>::Constant(resolution / 2));
+  CollisionObject<S> cell_obj(std::make_shared<OcTree<S>>(resolution, cell_points));
+
+  Transform3<S> tf = Transform3<S>::Identity();
+  tf.translation() = Vector3<S>(resolution / 2, resolution / 2, -0.3);
+  CollisionObject<S> touching_sphere_obj(std::make_shared<Sphere<S>>(0.3), tf);
+  checkSignedDistance(&cell_obj, &touching_sphere_obj);
+
+  auto mesh = std::make_shared<BVHModel<OBBRSS<S>>>();
+  generateBVHModel(*mesh, Box<S>(0.5, 0.3, 0.2), Transform3<S>::Identity());
+  tf.translation() = Vector3<S>(resolution / 2, resolution / 2, -0.1);
+  CollisionObject<S> touching_mesh_obj(mesh, tf);
+  checkSignedDistance(&cell_obj, &touching_mesh_obj);
+
+  // A block of 10 x 10 x 10 cells centered at the origin. The deepest cells
+  // penetrate a sphere further than their own diameter.
+  std::vector<Vector3<S>> block_points;
+  for(int x = -5; x < 5; ++x)
+    for(int y = -5; y < 5; ++y)
+      for(int z = -5; z < 5; ++z)
+        block_points.push_back(Vector3<S>(x + 0.5, y + 0.5, z + 0.5) * resolution);
+  CollisionObject<S> block_obj(std::make_shared<OcTree<S>>(resolution, block_points));
+
+  tf.translation() = Vector3<S>(0.45, 0.1, 0);
+  for(S radius : {0.6, 1.0})
+  {
+    CollisionObject<S> deep_sphere_obj(std::make_shared<Sphere<S>>(radius), tf);
+    checkSignedDistance(&block_obj, &deep_sphere_obj);
+  }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -147,6 +147,20 @@ void generateRandomTransforms_ccd(S extents[6], Eigen::aligned_vector<Transform3
                                  const std::vector<Vector3<S>>& vertices1, const std::vector<Triangle>& triangles1,
                                  const std::vector<Vector3<S>>& vertices2, const std::vector<Triangle>& triangles2);
 
+/// @brief Build m1 and m2 from the obj files filename1 and filename2, and
+/// generate random poses for m2 with translations in [-3000, 3000] x
+/// [-3000, 3000] x [0, 3000]: 10 poses, or 2 in debug builds. This is the
+/// setup of the mesh-mesh traversal tests on env.obj and rob.obj.
+template <typename BV>
+void generateMeshPair(const char* filename1, const char* filename2,
+                      BVHModel<BV>& m1, BVHModel<BV>& m2,
+                      Eigen::aligned_vector<Transform3<typename BV::S>>& transforms);
+
+/// @brief Whether two collision results hold contacts between the same
+/// primitives, in the same order
+template <typename S>
+bool sameContacts(const CollisionResult<S>& result1, const CollisionResult<S>& result2);
+
 /// @brief Generate environment with 3 * n objects: n boxes, n spheres and n cylinders.
 template <typename S>
 void generateEnvironments(std::vector<CollisionObject<S>*>& env, S env_scale, std::size_t n);
@@ -241,8 +255,6 @@ std::string getNodeTypeName(NODE_TYPE node_type);
 
 std::string getGJKSolverName(GJKSolverType solver_type);
 
-#if FCL_HAVE_OCTOMAP
-
 /// @brief Generate boxes from the octomap
 template <typename S>
 void generateBoxesFromOctomap(std::vector<CollisionObject<S>*>& env, OcTree<S>& tree);
@@ -251,6 +263,8 @@ void generateBoxesFromOctomap(std::vector<CollisionObject<S>*>& env, OcTree<S>&
 template <typename S>
 void generateBoxesFromOctomapMesh(std::vector<CollisionObject<S>*>& env, OcTree<S>& tree);
 
+#if FCL_HAVE_OCTOMAP
+
 /// @brief Generate an octree
 octomap::OcTree* generateOcTree(double resolution = 0.1);
 
@@ -544,6 +558,53 @@ void generateRandomTransforms_ccd(S extents[6], Eigen::aligned_vector<Transform3
   }
 }
 
+//==============================================================================
+template <typename BV>
+void generateMeshPair(const char* filename1, const char* filename2,
+                      BVHModel<BV>& m1, BVHModel<BV>& m2,
+                      Eigen::aligned_vector<Transform3<typename BV::S>>& transforms)
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+  loadOBJFile(filename1, p1, t1);
+  loadOBJFile(filename2, p2, t2);
+
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 10;
+#else
+  std::size_t n = 2;
+#endif
+  generateRandomTransforms(extents, transforms, n);
+}
+
+//==============================================================================
+template <typename S>
+bool sameContacts(const CollisionResult<S>& result1, const CollisionResult<S>& result2)
+{
+  if(result1.numContacts() != result2.numContacts())
+    return false;
+
+  for(std::size_t i = 0; i < result1.numContacts(); ++i)
+  {
+    const Contact<S>& contact1 = result1.getContact(i);
+    const Contact<S>& contact2 = result2.getContact(i);
+    if(contact1.b1 != contact2.b1 || contact1.b2 != contact2.b2)
+      return false;
+  }
+
+  return true;
+}
+
 //==============================================================================
 template <typename S>
 void generateEnvironments(std::vector<CollisionObject<S>*>& env, S env_scale, std::size_t n)
@@ -672,8 +733,6 @@ bool defaultContinuousDistanceFunction(ContinuousCollisionObject<S>* o1, Continu
   return true;
 }
 
-#if FCL_HAVE_OCTOMAP
-
 //==============================================================================
 template <typename S>
 void generateBoxesFromOctomap(std::vector<CollisionObject<S>*>& boxes, OcTree<S>& tree)
@@ -727,6 +786,8 @@ void generateBoxesFromOctomapMesh(std::vector<CollisionObject<S>*>& boxes, OcTre
   std::cout << "boxes size: " << boxes.size() << std::endl;
 }
 
+#if FCL_HAVE_OCTOMAP
+
 //==============================================================================
 inline octomap::OcTree* generateOcTree(double resolution)
 {